@@ -0,0 +1,57 @@
+#pragma once
+#include "../include/utils/tsc.hpp"
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <numeric>
+#include <algorithm>
+#include <cstdint>
+
+// Benchmark parameters
+constexpr size_t NUM_ITERATIONS = 100000;
+constexpr size_t NUM_WARMUP = 10000;
+
+// Align to cache line to prevent false sharing
+alignas(64) inline uint64_t g_dummy = 0;
+
+// Measure execution time in nanoseconds. TSC reads cost a few ns, far less
+// than a clock call, so short operations are not swamped by the timer.
+template<typename Func>
+uint64_t measure_time_ns(Func&& func) {
+    const trading::TscClock& clock = trading::TscClock::instance(); // calibrates on first use
+    uint64_t start = trading::tsc_now();
+    func();
+    uint64_t end = trading::tsc_now();
+    return clock.to_ns(end - start);
+}
+
+// Print benchmark results
+inline void print_results(const std::string& name, const std::vector<uint64_t>& times,
+                          size_t warmup = NUM_WARMUP) {
+    std::vector<uint64_t> filtered_times(times.begin() + std::min(warmup, times.size()), times.end());
+
+    if (filtered_times.empty()) {
+        std::cout << "No data for " << name << std::endl;
+        return;
+    }
+
+    std::sort(filtered_times.begin(), filtered_times.end());
+
+    double mean = std::accumulate(filtered_times.begin(), filtered_times.end(), 0.0) / filtered_times.size();
+
+    uint64_t p50 = filtered_times[filtered_times.size() * 50 / 100];
+    uint64_t p90 = filtered_times[filtered_times.size() * 90 / 100];
+    uint64_t p99 = filtered_times[filtered_times.size() * 99 / 100];
+    uint64_t p999 = filtered_times[filtered_times.size() * 999 / 1000];
+
+    std::cout << name << std::endl;
+    std::cout << "  Iterations: " << filtered_times.size() << std::endl;
+    std::cout << "  mean:     " << std::setw(10) << std::fixed << std::setprecision(2) << mean << " ns" << std::endl;
+    std::cout << "  p50:     " << std::setw(10) << p50 << " ns" << std::endl;
+    std::cout << "  p90:     " << std::setw(10) << p90 << " ns" << std::endl;
+    std::cout << "  p99:     " << std::setw(10) << p99 << " ns" << std::endl;
+    std::cout << "  p99.9:   " << std::setw(10) << p999 << " ns" << std::endl;
+    std::cout << std::endl;
+}
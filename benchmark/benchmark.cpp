@@ -1,64 +1,24 @@
 #include "../include/utils/config.hpp"
 #include "../include/core/order_book.hpp"
-#include <chrono>
-#include <iostream>
-#include <iomanip>
-#include <vector>
-#include <numeric>
+#include "../include/core/matching_engine.hpp"
+#include "bench_utils.hpp"
 #include <random>
-#include <algorithm>
 
 using namespace trading;
 
-// Benchmark parameters
-constexpr size_t NUM_ITERATIONS = 100000;
-constexpr size_t NUM_WARMUP = 10000;
-
-// Align to cache line to prevent false sharing
-alignas(64) uint64_t g_dummy = 0;
-
-// Measure execution time in nanoseconds
-template<typename Func>
-uint64_t measure_time_ns(Func&& func) {
-    auto start = std::chrono::high_resolution_clock::now();
-    func();
-    auto end = std::chrono::high_resolution_clock::now();
-    return std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
-}
-
-// Print benchmark results
-void print_results(const std::string& name, const std::vector<uint64_t>& times) {
-    std::vector<uint64_t> filtered_times(times.begin() + NUM_WARMUP, times.end());
-
-    if (filtered_times.empty()) {
-        std::cout << "No data for " << name << std::endl;
-        return;
-    }
-
-    std::sort(filtered_times.begin(), filtered_times.end());
-
-    double mean = std::accumulate(filtered_times.begin(), filtered_times.end(), 0.0) / filtered_times.size();
-
-    uint64_t p50 = filtered_times[filtered_times.size() * 50 / 100];
-    uint64_t p90 = filtered_times[filtered_times.size() * 90 / 100];
-    uint64_t p99 = filtered_times[filtered_times.size() * 99 / 100];
-    uint64_t p999 = filtered_times[filtered_times.size() * 999 / 1000];
-
-    std::cout << name << std::endl;
-    std::cout << "  Iterations: " << filtered_times.size() << std::endl;
-    std::cout << "  mean:     " << std::setw(10) << std::fixed << std::setprecision(2) << mean << " ns" << std::endl;
-    std::cout << "  p50:     " << std::setw(10) << p50 << " ns" << std::endl;
-    std::cout << "  p90:     " << std::setw(10) << p90 << " ns" << std::endl;
-    std::cout << "  p99:     " << std::setw(10) << p99 << " ns" << std::endl;
-    std::cout << "  p99.9:   " << std::setw(10) << p999 << " ns" << std::endl;
-    std::cout << std::endl;
-}
+// Book configurations benchmarked side by side: a fixed band covering every
+// price below (60.00 to 100.00, one cent ticks), and the default book with a
+// node-based order map
+using EquityBand = TickTraits<1, 60000, 100000>;
+using FixedBandBook = BasicOrderBook<EquityBand, FixedLadder<EquityBand>>;
+using StdMapBook = BasicOrderBook<RuntimeTicks, PriceLadder, StdOrderIndex>;
 
 // Benchmark OrderBook operations
-void benchmark_order_book() {
-    std::cout << "Benchmarking trading::OrderBook..." << std::endl;
+template <typename Book>
+void benchmark_order_book(const std::string& name) {
+    std::cout << "Benchmarking " << name << "..." << std::endl;
 
-    OrderBook ob;
+    Book ob({DEFAULT_TICK_SIZE, DEFAULT_LADDER_WIDTH, NUM_ITERATIONS});
 
     // Random number generators
     std::random_device rd;
@@ -75,7 +35,7 @@ void benchmark_order_book() {
         orders.emplace_back(Order{
             i + 1,
             side_dist(gen) == 0 ? Side::Bid : Side::Ask,
-            clamp_price(raw_price),
+            raw_price,
             quantity_dist(gen)
         });
     }
@@ -104,6 +64,43 @@ void benchmark_order_book() {
         print_results("get_best_bid/get_best_ask", times);
     }
 
+    // depth queries on a separate uncrossed book: 2000 ticks each side of 80.00
+    {
+        Book depth_book({DEFAULT_TICK_SIZE, DEFAULT_LADDER_WIDTH, NUM_ITERATIONS});
+        std::uniform_int_distribution<int64_t> offset_dist(1, 2000);
+        for (size_t i = 0; i < NUM_ITERATIONS / 2; ++i) {
+            Side side = i % 2 ? Side::Bid : Side::Ask;
+            Price offset = offset_dist(gen);
+            depth_book.add_order({i + 1, side, side == Side::Bid ? 80000 - offset : 80000 + offset,
+                                  quantity_dist(gen)});
+        }
+
+        Price prices[10];
+        Quantity quantities[10];
+        std::vector<uint64_t> times;
+        times.reserve(NUM_ITERATIONS);
+        for (size_t i = 0; i < NUM_ITERATIONS; ++i) {
+            Side side = i % 2 ? Side::Bid : Side::Ask;
+            times.push_back(measure_time_ns([&]() { g_dummy += depth_book.get_depth(side, prices, quantities); }));
+        }
+        print_results("get_depth (top 10)", times);
+
+        times.clear();
+        for (size_t i = 0; i < NUM_ITERATIONS; ++i) {
+            Side side = i % 2 ? Side::Bid : Side::Ask;
+            Price limit = side == Side::Bid ? 79000 : 81000;
+            times.push_back(measure_time_ns([&]() { g_dummy += depth_book.get_cumulative_depth(side, limit); }));
+        }
+        print_results("get_cumulative_depth (1000 ticks)", times);
+
+        times.clear();
+        for (size_t i = 0; i < NUM_ITERATIONS; ++i) {
+            Side side = i % 2 ? Side::Bid : Side::Ask;
+            times.push_back(measure_time_ns([&]() { g_dummy += depth_book.get_vwap(side, 25000).filled; }));
+        }
+        print_results("get_vwap (25000 lots)", times);
+    }
+
     // 3. modify_order (increase quantity)
     {
         std::vector<uint64_t> times;
@@ -127,7 +124,87 @@ void benchmark_order_book() {
     }
 }
 
+// Benchmark MatchingEngine: aggressive orders against resting liquidity
+void benchmark_matching_engine() {
+    std::cout << "Benchmarking trading::MatchingEngine..." << std::endl;
+
+    MatchingEngine engine({DEFAULT_TICK_SIZE, DEFAULT_LADDER_WIDTH, 1 << 16});
+
+    std::mt19937 gen(11);
+    std::uniform_int_distribution<int64_t> quantity_dist(1, 100);
+    std::uniform_int_distribution<int> side_dist(0, 1);
+
+    constexpr Price MID = 80000;
+    constexpr int DEPTH = 10;
+    OrderId next_id = 1;
+
+    // Five orders on each of the ten levels either side of the mid
+    auto replenish = [&](Side side) {
+        for (int level = 1; level <= DEPTH; ++level) {
+            Price price = side == Side::Bid ? MID - level : MID + level;
+            while (engine.book().get_level(side, price) < 250)
+                engine.submit({next_id++, side, price, quantity_dist(gen)});
+        }
+    };
+    replenish(Side::Bid);
+    replenish(Side::Ask);
+
+    MarketMessage event;
+
+    // 1. passive add (rests without matching)
+    {
+        std::vector<uint64_t> times;
+        times.reserve(NUM_ITERATIONS);
+        std::vector<OrderId> added;
+        added.reserve(NUM_ITERATIONS);
+        for (size_t i = 0; i < NUM_ITERATIONS; ++i) {
+            Side side = side_dist(gen) == 0 ? Side::Bid : Side::Ask;
+            Price price = side == Side::Bid ? MID - 1 - Price(i % DEPTH) : MID + 1 + Price(i % DEPTH);
+            Order o{next_id++, side, price, quantity_dist(gen)};
+            times.push_back(measure_time_ns([&]() { engine.submit(o); }));
+            added.push_back(o.id);
+        }
+        print_results("submit (passive)", times);
+        for (OrderId id : added) engine.cancel_order(id);
+    }
+
+    // 2. aggressive order crossing the touch (one or more fills)
+    {
+        std::vector<uint64_t> times;
+        times.reserve(NUM_ITERATIONS);
+        for (size_t i = 0; i < NUM_ITERATIONS; ++i) {
+            Side side = side_dist(gen) == 0 ? Side::Bid : Side::Ask;
+            Price limit = side == Side::Bid ? MID + DEPTH : MID - DEPTH;
+            Order o{next_id++, side, limit, quantity_dist(gen)};
+            times.push_back(measure_time_ns([&]() { engine.submit(o); }));
+
+            // untimed: drain output and restore liquidity
+            while (engine.poll_event(event)) g_dummy += event.trade.qty;
+            engine.cancel_order(o.id);
+            replenish(side == Side::Bid ? Side::Ask : Side::Bid);
+        }
+        print_results("submit (aggressive)", times);
+    }
+
+    // 3. cancel a resting order from its level queue
+    {
+        std::vector<uint64_t> times;
+        times.reserve(NUM_ITERATIONS);
+        for (size_t i = 0; i < NUM_ITERATIONS; ++i) {
+            Side side = i % 2 == 0 ? Side::Bid : Side::Ask;
+            Price price = side == Side::Bid ? MID - 1 - Price(i % DEPTH) : MID + 1 + Price(i % DEPTH);
+            OrderId id = next_id++;
+            engine.submit({id, side, price, quantity_dist(gen)});
+            times.push_back(measure_time_ns([&]() { engine.cancel_order(id); }));
+        }
+        print_results("cancel (matching)", times);
+    }
+}
+
 int main() {
-    benchmark_order_book();
+    benchmark_order_book<OrderBook>("trading::OrderBook");
+    benchmark_order_book<FixedBandBook>("BasicOrderBook<TickTraits<1, 60000, 100000>, FixedLadder>");
+    benchmark_order_book<StdMapBook>("BasicOrderBook<RuntimeTicks, PriceLadder, StdOrderIndex>");
+    benchmark_matching_engine();
     return 0;
 }
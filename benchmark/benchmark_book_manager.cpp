@@ -0,0 +1,102 @@
+#include "../include/core/book_manager.hpp"
+#include "../include/utils/cpu.hpp"
+#include "bench_utils.hpp"
+#include <random>
+#include <cstdlib>
+
+using namespace trading;
+
+constexpr InstrumentId NUM_INSTRUMENTS = 1024;
+constexpr size_t DEFAULT_MESSAGES = 2000000;
+
+struct EncodedFeed {
+    std::vector<uint8_t> bytes;
+    std::vector<uint32_t> offsets; // start of each message, plus end sentinel
+};
+
+// Adds around a per-instrument mid, each later cancelled, spread over all instruments
+EncodedFeed make_feed(size_t num_messages) {
+    EncodedFeed feed;
+    feed.bytes.reserve(num_messages * (MESSAGE_HEADER_SIZE + sizeof(AddOrderMsg)));
+    feed.offsets.reserve(num_messages + 1);
+
+    std::mt19937 gen(3);
+    std::uniform_int_distribution<InstrumentId> instrument_dist(0, NUM_INSTRUMENTS - 1);
+    std::uniform_int_distribution<int64_t> offset_dist(1, 20);
+    std::uniform_int_distribution<int64_t> quantity_dist(1, 100);
+
+    std::vector<std::pair<InstrumentId, OrderId>> live;
+    OrderId next_id = 1;
+    uint8_t buffer[sizeof(MarketMessage) + MESSAGE_HEADER_SIZE];
+
+    for (size_t i = 0; i < num_messages; ++i) {
+        MarketMessage msg{};
+        if (live.empty() || gen() % 2 == 0) {
+            msg.type = MessageType::AddOrder;
+            msg.instrument = instrument_dist(gen);
+            Side side = gen() % 2 == 0 ? Side::Bid : Side::Ask;
+            Price mid = 10000 + Price(msg.instrument) * 10;
+            Price price = side == Side::Bid ? mid - offset_dist(gen) : mid + offset_dist(gen);
+            msg.add = {next_id, side, price, quantity_dist(gen)};
+            live.emplace_back(msg.instrument, next_id++);
+        } else {
+            size_t pick = gen() % live.size();
+            msg.type = MessageType::CancelOrder;
+            msg.instrument = live[pick].first;
+            msg.cancel = {live[pick].second};
+            live[pick] = live.back();
+            live.pop_back();
+        }
+
+        size_t size = encode_message(msg, buffer);
+        feed.offsets.push_back(static_cast<uint32_t>(feed.bytes.size()));
+        feed.bytes.insert(feed.bytes.end(), buffer, buffer + size);
+    }
+    feed.offsets.push_back(static_cast<uint32_t>(feed.bytes.size()));
+    return feed;
+}
+
+double run(const EncodedFeed& feed, size_t shards) {
+    size_t num_messages = feed.offsets.size() - 1;
+
+    // Feed thread keeps core 0; shards take the cores after it
+    BookManager manager(shards, {1, 256, 256}, 1);
+    for (InstrumentId id = 0; id < NUM_INSTRUMENTS; ++id) manager.add_instrument(id);
+    manager.start();
+    pin_current_thread(0);
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < num_messages; ++i) {
+        const uint8_t* msg = feed.bytes.data() + feed.offsets[i];
+        size_t size = feed.offsets[i + 1] - feed.offsets[i];
+        while (!manager.push_raw_message(msg, size)) cpu_relax();
+    }
+    while (manager.processed() < num_messages) cpu_relax();
+    auto end = std::chrono::steady_clock::now();
+
+    manager.stop();
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    return num_messages / seconds;
+}
+
+int main(int argc, char** argv) {
+    size_t num_messages = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : DEFAULT_MESSAGES;
+    size_t max_shards = argc > 2 ? std::strtoull(argv[2], nullptr, 10)
+                                 : std::max<size_t>(1, num_cores() - 1);
+
+    std::cout << "Benchmarking trading::BookManager (" << num_messages << " messages, "
+              << NUM_INSTRUMENTS << " instruments)..." << std::endl;
+
+    EncodedFeed feed = make_feed(num_messages);
+
+    double baseline = 0;
+    for (size_t shards = 1; shards <= max_shards; shards *= 2) {
+        double rate = run(feed, shards);
+        if (shards == 1) baseline = rate;
+        std::cout << "  shards: " << std::setw(3) << shards
+                  << "  msgs/sec: " << std::setw(14) << std::fixed << std::setprecision(0) << rate
+                  << "  scaling: " << std::setprecision(2) << rate / baseline << "x" << std::endl;
+    }
+    return 0;
+}
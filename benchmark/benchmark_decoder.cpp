@@ -0,0 +1,83 @@
+#include "../include/core/sequenced_decoder.hpp"
+#include "bench_utils.hpp"
+#include <random>
+#include <cstdlib>
+
+using namespace trading;
+
+constexpr size_t DEFAULT_MESSAGES = 10000000;
+constexpr size_t NUM_PASSES = 5;
+
+// Mixed add/cancel/modify/execute stream with consecutive sequence numbers
+std::vector<uint8_t> make_stream(size_t num_messages) {
+    std::vector<uint8_t> stream;
+    stream.reserve(num_messages * (SEQUENCED_HEADER_SIZE + sizeof(AddOrderMsg)));
+
+    std::mt19937 gen(11);
+    uint8_t buffer[SEQUENCED_HEADER_SIZE + sizeof(MarketMessage)];
+
+    for (uint64_t i = 0; i < num_messages; ++i) {
+        MarketMessage msg{};
+        msg.instrument = static_cast<InstrumentId>(gen() % 16);
+        switch (gen() % 4) {
+            case 0:
+                msg.type = MessageType::AddOrder;
+                msg.add = {i + 1, Side::Bid, 80000 + Price(gen() % 100), 10};
+                break;
+            case 1:
+                msg.type = MessageType::CancelOrder;
+                msg.cancel = {i};
+                break;
+            case 2:
+                msg.type = MessageType::ModifyOrder;
+                msg.modify = {i, 5};
+                break;
+            default:
+                msg.type = MessageType::Execute;
+                msg.execute = {i, 1, 80000};
+                break;
+        }
+        size_t size = encode_sequenced(msg, i + 1, buffer);
+        stream.insert(stream.end(), buffer, buffer + size);
+    }
+    return stream;
+}
+
+int main(int argc, char** argv) {
+    size_t num_messages = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : DEFAULT_MESSAGES;
+    std::vector<uint8_t> stream = make_stream(num_messages);
+
+    std::cout << "Benchmarking SequencedDecoder (" << num_messages << " messages, "
+              << stream.size() / (1 << 20) << " MiB)..." << std::endl;
+
+    // Decode the whole buffer; the sink touches every message so nothing is elided
+    std::vector<uint64_t> times;
+    for (size_t pass = 0; pass < NUM_PASSES + 1; ++pass) {
+        SequencedDecoder decoder;
+        uint64_t sum = 0;
+        times.push_back(measure_time_ns([&]() {
+            decoder.decode(stream.data(), stream.size(), [&](const MarketMessage& msg) {
+                sum += msg.instrument + static_cast<uint64_t>(msg.type) + msg.cancel.orderId;
+                return true;
+            });
+        }));
+        g_dummy += sum;
+        if (decoder.messages() != num_messages || decoder.gaps() != 0) {
+            std::cerr << "decode mismatch" << std::endl;
+            return 1;
+        }
+    }
+
+    // first pass warms caches and the page tables
+    std::sort(times.begin() + 1, times.end());
+    uint64_t best = times[1];
+    uint64_t median = times[1 + NUM_PASSES / 2];
+
+    std::cout << "  best:    " << std::setw(14) << std::fixed << std::setprecision(0)
+              << num_messages * 1e9 / best << " msgs/sec  ("
+              << std::setprecision(2) << double(best) / num_messages << " ns/msg)" << std::endl;
+    std::cout << "  median:  " << std::setw(14) << std::setprecision(0)
+              << num_messages * 1e9 / median << " msgs/sec  ("
+              << std::setprecision(2) << double(median) / num_messages << " ns/msg)" << std::endl;
+    return 0;
+}
@@ -0,0 +1,80 @@
+#include "../include/utils/event_loop.hpp"
+#include "../include/utils/slot_queue.hpp"
+#include "../include/utils/histogram.hpp"
+#include "../include/utils/cpu.hpp"
+#include "../include/utils/tsc.hpp"
+#include "bench_utils.hpp"
+#include <ctime>
+#include <memory>
+#include <sstream>
+#include <thread>
+#include <cstdlib>
+
+using namespace trading;
+
+// Wake-up latency vs CPU cost of each EventLoop wait strategy: a producer
+// publishes TSC stamps at a fixed interval, the loop records publish-to-handle
+// latency, and the loop thread's CPU time shows what idling costs.
+
+constexpr size_t DEFAULT_MESSAGES = 20000;
+constexpr double DEFAULT_INTERVAL_US = 20;
+
+using StampQueue = SlotQueue<uint64_t, 1024>;
+
+static double thread_cpu_ns() {
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+template <typename Wait>
+void run(const std::string& name, Wait wait, Wakeup* wakeup, size_t messages, double interval_us) {
+    const TscClock& clock = TscClock::instance();
+    auto queue = std::make_unique<StampQueue>();
+    EventLoop<StampQueue, Wait> loop(*queue, std::move(wait));
+
+    LatencyHistogram latency;
+    double cpu_ns = 0;
+    std::thread consumer([&]() {
+        pin_current_thread(1);
+        double cpu_start = thread_cpu_ns();
+        loop.run([&](uint64_t& sent) { latency.record(clock.to_ns(tsc_now() - sent)); });
+        cpu_ns = thread_cpu_ns() - cpu_start;
+    });
+
+    pin_current_thread(0);
+    uint64_t interval = static_cast<uint64_t>(interval_us * 1000 * clock.ticks_per_ns());
+    uint64_t start = tsc_now();
+    for (size_t i = 0; i < messages; ++i) {
+        uint64_t due = start + i * interval;
+        while (tsc_now() < due) cpu_relax();
+        while (!queue->push(tsc_now())) cpu_relax();
+        if (wakeup) wakeup->notify();
+    }
+    while (queue->size_approx() > 0) cpu_relax();
+    uint64_t wall_ns = clock.to_ns(tsc_now() - start);
+
+    loop.stop();
+    consumer.join();
+
+    auto stats = loop.stats();
+    std::ostringstream title;
+    title << name << ": publish-to-handle latency (consumer CPU " << std::fixed << std::setprecision(1)
+          << 100.0 * cpu_ns / wall_ns << "%, loop busy " << 100.0 * stats.utilisation() << "%)";
+    latency.print(std::cout, title.str());
+}
+
+int main(int argc, char** argv) {
+    size_t messages = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : DEFAULT_MESSAGES;
+    double interval_us = argc > 2 ? std::strtod(argv[2], nullptr) : DEFAULT_INTERVAL_US;
+
+    std::cout << "Benchmarking EventLoop wait strategies (" << messages << " messages, one every "
+              << interval_us << " us)..." << std::endl;
+    TscClock::instance();
+
+    run("Busy spin", BusySpinWait{}, nullptr, messages, interval_us);
+    run("Spin then yield", SpinYieldWait{}, nullptr, messages, interval_us);
+    Wakeup wakeup;
+    run("Spin then block (futex)", BlockingWait(wakeup), &wakeup, messages, interval_us);
+    return 0;
+}
@@ -0,0 +1,63 @@
+#include "../include/utils/generator.hpp"
+#include "../include/utils/event_loop.hpp"
+#include "bench_utils.hpp"
+#include <memory>
+#include <cstdlib>
+
+using namespace trading;
+
+// Open-loop load through push_raw_message into a book thread: the achieved
+// rate against the target, how often the generator fell behind schedule
+// and how often the queue was full. Rate 0 finds the maximum the pipeline
+// absorbs.
+
+void run(const std::string& name, FeedProfile profile, double seconds) {
+    auto queue = std::make_unique<MarketDataHandler::Queue>();
+    MarketDataHandler handler(*queue);
+    OrderBook book;
+    EventLoop<MarketDataHandler::Queue> loop(*queue);
+    loop.start([&](MarketMessage& msg) { apply_message(book, msg); }, 1);
+
+    FeedGenerator generator(handler, profile);
+    pin_current_thread(0);
+    uint64_t messages = profile.rate > 0 ? static_cast<uint64_t>(profile.rate * seconds)
+                                         : static_cast<uint64_t>(5e6 * seconds);
+    auto start = std::chrono::steady_clock::now();
+    generator.run(messages);
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    loop.stop();
+
+    auto stats = loop.stats();
+    std::cout << name << std::endl;
+    std::cout << "  target:    " << std::setw(12) << std::fixed << std::setprecision(0)
+              << (profile.rate > 0 ? profile.rate : 0.0) << " msgs/sec" << (profile.rate > 0 ? "" : " (max)") << std::endl;
+    std::cout << "  achieved:  " << std::setw(12) << generator.sent() / elapsed << " msgs/sec" << std::endl;
+    std::cout << "  late:      " << std::setw(12) << std::setprecision(2)
+              << 100.0 * generator.late() / std::max<uint64_t>(1, generator.sent()) << " % (>1us behind schedule)"
+              << std::endl;
+    std::cout << "  retries:   " << std::setw(12) << generator.retries() << " (queue full)" << std::endl;
+    std::cout << "  book busy: " << std::setw(12) << std::setprecision(1) << stats.utilisation() * 100 << " %"
+              << std::endl;
+    std::cout << std::endl;
+}
+
+int main(int argc, char** argv) {
+    double rate = argc > 1 ? std::strtod(argv[1], nullptr) : 1000000;
+    double seconds = argc > 2 ? std::strtod(argv[2], nullptr) : 1.0;
+
+    std::cout << "Benchmarking open-loop feed generator (" << seconds << " s per run)..." << std::endl;
+    TscClock::instance();
+
+    FeedProfile profile;
+    profile.cycle = 1 << 20;
+    profile.rate = rate;
+    profile.arrival = Arrival::Constant;
+    run("Constant", profile, seconds);
+    profile.arrival = Arrival::Poisson;
+    run("Poisson", profile, seconds);
+    profile.arrival = Arrival::Bursty;
+    run("Bursty (64 per burst)", profile, seconds);
+    profile.rate = 0;
+    run("Unpaced", profile, seconds);
+    return 0;
+}
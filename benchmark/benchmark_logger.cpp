@@ -0,0 +1,48 @@
+#include "../include/utils/async_logger.hpp"
+#include "../include/utils/logger.hpp"
+#include "bench_utils.hpp"
+
+using namespace trading;
+
+constexpr size_t PER_CALL = 64;
+
+void print_per_call(const std::string& name, std::vector<uint64_t>& times) {
+    for (auto& t : times) t /= PER_CALL;
+    print_results(name, times, times.size() / 10);
+}
+
+int main() {
+    std::cout << "Benchmarking loggers (amortised ns per log call, output to /dev/null)..." << std::endl;
+
+    // Previous logger: format on the caller, mutex, bounded vector
+    {
+        Logger logger(5000);
+        std::vector<uint64_t> times;
+        times.reserve(NUM_ITERATIONS / PER_CALL);
+        for (size_t i = 0; i < NUM_ITERATIONS; i += PER_CALL) {
+            times.push_back(measure_time_ns([&]() {
+                for (size_t j = i; j < i + PER_CALL; ++j)
+                    logger.log("AddOrder: id=" + std::to_string(j) + ", side=Bid, price=" +
+                               std::to_string(1000 + j % 50) + ", qty=" + std::to_string(10));
+            }));
+        }
+        print_per_call("Logger::log (formatted on caller)", times);
+    }
+
+    // Async logger: the caller only stores the arguments
+    for (OverflowPolicy policy : {OverflowPolicy::Drop, OverflowPolicy::Block}) {
+        AsyncLogger logger("/dev/null", policy);
+        std::vector<uint64_t> times;
+        times.reserve(NUM_ITERATIONS / PER_CALL);
+        for (size_t i = 0; i < NUM_ITERATIONS; i += PER_CALL) {
+            times.push_back(measure_time_ns([&]() {
+                for (size_t j = i; j < i + PER_CALL; ++j)
+                    logger.log("AddOrder: id={}, side={}, price={}, qty={}", j, "Bid", 1000 + j % 50, 10);
+            }));
+        }
+        bool drop = policy == OverflowPolicy::Drop;
+        print_per_call(std::string("AsyncLogger::log (") + (drop ? "drop" : "block") + " policy)", times);
+        if (drop) std::cout << "  dropped: " << logger.dropped() << std::endl << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,122 @@
+#include "../include/core/mbp_publisher.hpp"
+#include "../include/utils/cpu.hpp"
+#include "../include/utils/tsc.hpp"
+#include "bench_utils.hpp"
+#include <atomic>
+#include <memory>
+#include <random>
+#include <thread>
+#include <cstdlib>
+
+using namespace trading;
+
+// Output of the market-by-price publisher: the unconflated baseline publishes
+// after every input message, the conflated runs once per batch. A slow
+// subscriber shows the book thread keeping its pace while the stream thins.
+
+constexpr size_t DEFAULT_MESSAGES = 2000000;
+constexpr size_t DEFAULT_BATCH = 64;
+
+// Orders around a fixed mid, half adds and the rest on live orders
+std::vector<MarketMessage> make_feed(size_t n) {
+    std::vector<MarketMessage> feed;
+    feed.reserve(n);
+    std::mt19937 gen(11);
+    std::uniform_int_distribution<int64_t> offset_dist(1, 20);
+    std::uniform_int_distribution<int64_t> quantity_dist(1, 100);
+
+    std::vector<OrderId> live;
+    OrderId next_id = 1;
+    for (size_t i = 0; i < n; ++i) {
+        MarketMessage msg{};
+        int kind = live.empty() ? 0 : static_cast<int>(gen() % 4);
+        size_t pick = live.empty() ? 0 : gen() % live.size();
+        if (kind == 0 || kind == 3) {
+            Side side = gen() % 2 == 0 ? Side::Bid : Side::Ask;
+            msg.type = MessageType::AddOrder;
+            msg.add = {next_id, side, side == Side::Bid ? 10000 - offset_dist(gen) : 10000 + offset_dist(gen),
+                       quantity_dist(gen)};
+            live.push_back(next_id++);
+        } else if (kind == 1) {
+            msg.type = MessageType::CancelOrder;
+            msg.cancel = {live[pick]};
+            live[pick] = live.back();
+            live.pop_back();
+        } else {
+            msg.type = MessageType::ModifyOrder;
+            msg.modify = {live[pick], quantity_dist(gen)};
+        }
+        feed.push_back(msg);
+    }
+    return feed;
+}
+
+// work_ns: subscriber time per message, 0 for a fast one
+void run(const std::string& name, const std::vector<MarketMessage>& feed, size_t batch, uint64_t work_ns) {
+    const TscClock& clock = TscClock::instance();
+    OrderBook book;
+    auto queue = std::make_unique<MbpPublisher::Queue>();
+    MbpPublisher publisher(book, *queue);
+
+    std::atomic<bool> done{false};
+    uint64_t received = 0;
+    std::thread subscriber([&]() {
+        pin_current_thread(1);
+        uint64_t work_ticks = static_cast<uint64_t>(work_ns * clock.ticks_per_ns());
+        while (true) {
+            bool finished = done.load(std::memory_order_acquire);
+            MarketMessage* msg = queue->consume();
+            if (!msg) {
+                if (finished) break;
+                cpu_relax();
+                continue;
+            }
+            g_dummy += msg->level.qty;
+            queue->release(msg);
+            ++received;
+            if (work_ticks) {
+                uint64_t until = tsc_now() + work_ticks;
+                while (tsc_now() < until) cpu_relax();
+            }
+        }
+    });
+
+    pin_current_thread(0);
+    uint64_t start = tsc_now();
+    for (size_t i = 0; i < feed.size(); ++i) {
+        apply_message(book, feed[i]);
+        if ((i + 1) % batch == 0) publisher.publish();
+    }
+    publisher.publish();
+    double seconds = clock.to_ns(tsc_now() - start) * 1e-9;
+
+    done.store(true, std::memory_order_release);
+    subscriber.join();
+
+    std::cout << name << std::endl;
+    std::cout << "  book thread:   " << std::setw(12) << std::fixed << std::setprecision(0)
+              << feed.size() / seconds << " msgs/sec in" << std::endl;
+    std::cout << "  published:     " << std::setw(12) << publisher.messages() / seconds << " msgs/sec, "
+              << std::setprecision(1) << publisher.bytes() / seconds / 1e6 << " MB/sec ("
+              << std::setprecision(3) << double(publisher.messages()) / feed.size() << " per input msg)"
+              << std::endl;
+    std::cout << "  level changes: " << std::setw(12) << publisher.level_changes() << ", received "
+              << received << ", still pending " << publisher.pending() << std::endl;
+    std::cout << std::endl;
+}
+
+int main(int argc, char** argv) {
+    size_t messages = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : DEFAULT_MESSAGES;
+    size_t batch = argc > 2 ? std::max<size_t>(1, std::strtoull(argv[2], nullptr, 10)) : DEFAULT_BATCH;
+
+    std::cout << "Benchmarking conflated market-by-price publisher (" << messages << " messages, batch "
+              << batch << ")..." << std::endl;
+    auto feed = make_feed(messages);
+    TscClock::instance();
+
+    run("Unconflated (publish per message)", feed, 1, 0);
+    run("Conflated (publish per batch)", feed, batch, 0);
+    run("Unconflated, slow subscriber (200 ns/msg)", feed, 1, 200);
+    run("Conflated, slow subscriber (200 ns/msg)", feed, batch, 200);
+    return 0;
+}
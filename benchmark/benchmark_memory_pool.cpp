@@ -0,0 +1,117 @@
+#include "../include/utils/memory_pool.hpp"
+#include "../include/utils/lock_free_queue.hpp"
+#include "../include/utils/cpu.hpp"
+#include "bench_utils.hpp"
+#include <array>
+#include <memory>
+#include <thread>
+#include <cstdlib>
+
+using namespace trading;
+
+constexpr size_t POOL_SIZE = 4096;
+constexpr size_t DEFAULT_OPS = 10000000;
+constexpr size_t IN_FLIGHT = 64;
+
+struct Item {
+    uint64_t payload[6];
+};
+
+// Baseline: the previous single-threaded array stack. Kept here only for comparison.
+template <typename T, size_t N>
+class ArrayPool {
+public:
+    ArrayPool() : freeCount(N) {
+        for (size_t i = 0; i < N; ++i) freeSlots_[i] = &storage[i];
+    }
+
+    T* allocate() {
+        if (freeCount == 0) return nullptr;
+        return freeSlots_[--freeCount];
+    }
+
+    void release(T* ptr) { freeSlots_[freeCount++] = ptr; }
+
+private:
+    std::array<T, N> storage;
+    std::array<T*, N> freeSlots_;
+    size_t freeCount;
+};
+
+void report(const std::string& name, size_t ops, double seconds) {
+    std::cout << name << std::endl;
+    std::cout << "  ns/op:     " << std::setw(14) << std::fixed << std::setprecision(2)
+              << seconds * 1e9 / ops << std::endl;
+    std::cout << std::endl;
+}
+
+// Allocate/release on one thread, IN_FLIGHT objects outstanding at a time
+template <typename Pool>
+void single_thread(const std::string& name, size_t ops) {
+    auto pool = std::make_unique<Pool>();
+    Item* live[IN_FLIGHT];
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < ops; i += IN_FLIGHT) {
+        for (size_t j = 0; j < IN_FLIGHT; ++j) {
+            live[j] = pool->allocate();
+            live[j]->payload[0] = i + j;
+        }
+        for (size_t j = 0; j < IN_FLIGHT; ++j) {
+            g_dummy += live[j]->payload[0];
+            pool->release(live[j]);
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    report(name, ops, std::chrono::duration<double>(end - start).count());
+}
+
+// Owner allocates and sends over a queue; the consumer frees through a Cache
+void cross_thread(size_t ops) {
+    MemoryPool<Item, POOL_SIZE> pool;
+    auto queue = std::make_unique<LockFreeQueue<Item, 1024>>();
+
+    std::thread consumer([&]() {
+        pin_current_thread(1);
+        MemoryPool<Item, POOL_SIZE>::Cache cache(pool);
+        uint64_t sum = 0;
+        for (size_t received = 0; received < ops;) {
+            Item* item = queue->pop();
+            if (!item) {
+                cpu_relax();
+                continue;
+            }
+            sum += item->payload[0];
+            cache.release(item);
+            received++;
+        }
+        g_dummy += sum;
+    });
+
+    pin_current_thread(0);
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < ops; ++i) {
+        Item* item;
+        while (!(item = pool.allocate())) cpu_relax();
+        item->payload[0] = i;
+        while (!queue->push(item)) cpu_relax();
+    }
+    consumer.join();
+    auto end = std::chrono::steady_clock::now();
+
+    report("MemoryPool cross-thread (allocate -> queue -> Cache release)", ops,
+           std::chrono::duration<double>(end - start).count());
+    std::cout << "  exhaustions: " << pool.exhaustions() << std::endl << std::endl;
+}
+
+int main(int argc, char** argv) {
+    size_t ops = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : DEFAULT_OPS;
+
+    std::cout << "Benchmarking MemoryPool (" << POOL_SIZE << " objects, " << ops << " ops)..."
+              << std::endl;
+
+    single_thread<ArrayPool<Item, POOL_SIZE>>("Array stack baseline, single thread", ops);
+    single_thread<MemoryPool<Item, POOL_SIZE>>("MemoryPool, single thread", ops);
+    cross_thread(ops);
+    return 0;
+}
@@ -0,0 +1,86 @@
+#include "../include/core/order_book.hpp"
+#include "bench_utils.hpp"
+#include <random>
+
+using namespace trading;
+
+// Resting orders in the book while the timed operations run
+constexpr size_t NUM_RESTING = 1000000;
+
+// Orders in a Slab, found by id through a FlatHashMap of slab handles
+using SlabHashOrderIndex = SlabOrderIndex<MapOrderIds<FlatHashMap<OrderId, SlabHandle>>>;
+
+using SlabHashBook = BasicOrderBook<RuntimeTicks, PriceLadder, SlabHashOrderIndex>;
+using StdMapBook = BasicOrderBook<RuntimeTicks, PriceLadder, StdOrderIndex>;
+using DirectBook = BasicOrderBook<RuntimeTicks, PriceLadder, DirectOrderIndex>;
+
+// Modify, execute and cancel on random resting orders, addressed by
+// exchange id (through the book's index) or by the handle add_order returned
+template <typename Book, bool ByHandle>
+void benchmark_book(const std::string& name) {
+    std::cout << "Benchmarking " << name << " with " << NUM_RESTING << " resting orders (amortised ns per operation)..."
+              << std::endl;
+
+    Book book({DEFAULT_TICK_SIZE, DEFAULT_LADDER_WIDTH, NUM_RESTING});
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<int64_t> price_dist(79000, 81000);
+    std::uniform_int_distribution<int64_t> quantity_dist(1, 100);
+
+    // Exchange ids are sequential
+    std::vector<OrderHandle> handles(NUM_RESTING + 1);
+    for (OrderId id = 1; id <= NUM_RESTING; ++id)
+        handles[id] = book.add_order({id, id % 2 == 0 ? Side::Bid : Side::Ask, price_dist(gen), quantity_dist(gen)});
+
+    std::vector<OrderId> ids(NUM_RESTING);
+    std::iota(ids.begin(), ids.end(), 1);
+    std::shuffle(ids.begin(), ids.end(), gen);
+
+    // The caller keeps its handles next to whatever it would otherwise key
+    // by id, so both paths read their key from a sequential array
+    std::vector<OrderHandle> shuffled(NUM_RESTING);
+    for (size_t i = 0; i < NUM_RESTING; ++i) shuffled[i] = handles[ids[i]];
+
+    // Timed in batches: a lone rdtsc pair does not wait for an outstanding
+    // cache miss, so single-operation times would flatter whichever path
+    // leaves its miss to retire after the second read
+    constexpr size_t PER_CALL = 64;
+    auto run = [&](const std::string& op, size_t first, auto&& by_id, auto&& by_handle) {
+        std::vector<uint64_t> times;
+        times.reserve(NUM_ITERATIONS / PER_CALL);
+        for (size_t i = first; i + PER_CALL <= first + NUM_ITERATIONS; i += PER_CALL) {
+            times.push_back(measure_time_ns([&]() {
+                for (size_t j = i; j < i + PER_CALL; ++j) {
+                    if constexpr (ByHandle) g_dummy += by_handle(shuffled[j], j);
+                    else g_dummy += by_id(ids[j], j);
+                }
+            }));
+        }
+        for (auto& t : times) t /= PER_CALL;
+        print_results(name + " " + op, times, times.size() / 10);
+    };
+
+    // 1. modify (quantity change in place)
+    run("modify", 0,
+        [&](OrderId id, size_t i) { return book.modify_order(id, 101 + i % 50); },
+        [&](OrderHandle h, size_t i) { return book.modify_order(h, 101 + i % 50); });
+
+    // 2. execute (partial fill, or full fill removing the order)
+    run("execute", NUM_ITERATIONS,
+        [&](OrderId id, size_t i) { return book.execute_order(id, i % 2 == 0 ? 1 : 1000); },
+        [&](OrderHandle h, size_t i) { return book.execute_order(h, i % 2 == 0 ? 1 : 1000); });
+
+    // 3. cancel
+    run("cancel", 2 * NUM_ITERATIONS,
+        [&](OrderId id, size_t) { return book.cancel_order(id); },
+        [&](OrderHandle h, size_t) { return book.cancel_order(h); });
+}
+
+int main() {
+    benchmark_book<OrderBook, false>("OrderBook by id (HashOrderIndex, orders inline)");
+    benchmark_book<SlabHashBook, false>("OrderBook by id (Slab + FlatHashMap)");
+    benchmark_book<StdMapBook, false>("OrderBook by id (StdOrderIndex)");
+    benchmark_book<DirectBook, false>("OrderBook by id (DirectOrderIndex)");
+    benchmark_book<OrderBook, true>("OrderBook by handle (HashOrderIndex, orders inline)");
+    benchmark_book<DirectBook, true>("OrderBook by handle (DirectOrderIndex)");
+    return 0;
+}
@@ -0,0 +1,103 @@
+#include "../include/core/order_book.hpp"
+#include "../include/utils/flat_hash_map.hpp"
+#include "bench_utils.hpp"
+#include <unordered_map>
+#include <random>
+
+using namespace trading;
+
+// Resting orders kept in the map while the timed operations run
+constexpr size_t NUM_RESTING = 1000000;
+
+// Runs the order book's map access patterns against one map type
+template <typename Map>
+void benchmark_map(const std::string& name, Map map) {
+    std::cout << "Benchmarking " << name << " with " << NUM_RESTING << " resting orders..." << std::endl;
+
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<int64_t> price_dist(70000, 90000);
+    std::uniform_int_distribution<int64_t> quantity_dist(1, 100);
+
+    auto make_order = [&](OrderId id) {
+        return Order{id, id % 2 == 0 ? Side::Bid : Side::Ask, price_dist(gen), quantity_dist(gen)};
+    };
+
+    // Exchange ids are mostly sequential
+    for (OrderId id = 1; id <= NUM_RESTING; ++id) map.emplace(id, make_order(id));
+
+    // Access resting orders in random order
+    std::vector<OrderId> ids(NUM_RESTING);
+    std::iota(ids.begin(), ids.end(), 1);
+    std::shuffle(ids.begin(), ids.end(), gen);
+
+    OrderId next_id = NUM_RESTING + 1;
+
+    // 1. add (emplace a new order)
+    {
+        std::vector<uint64_t> times;
+        times.reserve(NUM_ITERATIONS);
+        for (size_t i = 0; i < NUM_ITERATIONS; ++i) {
+            Order o = make_order(next_id++);
+            times.push_back(measure_time_ns([&]() { map.emplace(o.id, o); }));
+        }
+        print_results(name + " add", times);
+    }
+
+    // 2. modify (find + update quantity)
+    {
+        std::vector<uint64_t> times;
+        times.reserve(NUM_ITERATIONS);
+        for (size_t i = 0; i < NUM_ITERATIONS; ++i) {
+            OrderId id = ids[i];
+            times.push_back(measure_time_ns([&]() {
+                auto it = map.find(id);
+                if (it != map.end()) it->second.quantity += 10;
+            }));
+        }
+        print_results(name + " modify", times);
+    }
+
+    // 3. execute (find + partial fill, erase when filled)
+    {
+        std::vector<uint64_t> times;
+        times.reserve(NUM_ITERATIONS);
+        for (size_t i = 0; i < NUM_ITERATIONS; ++i) {
+            OrderId id = ids[NUM_ITERATIONS + i];
+            Quantity qty = i % 2 == 0 ? 1 : 1000;
+            times.push_back(measure_time_ns([&]() {
+                auto it = map.find(id);
+                if (it == map.end()) return;
+                it->second.quantity -= std::min(qty, it->second.quantity);
+                if (it->second.quantity == 0) map.erase(it);
+            }));
+        }
+        print_results(name + " execute", times);
+    }
+
+    // 4. cancel (find + erase)
+    {
+        std::vector<uint64_t> times;
+        times.reserve(NUM_ITERATIONS);
+        for (size_t i = 0; i < NUM_ITERATIONS; ++i) {
+            OrderId id = ids[2 * NUM_ITERATIONS + i];
+            times.push_back(measure_time_ns([&]() {
+                auto it = map.find(id);
+                if (it != map.end()) map.erase(it);
+            }));
+        }
+        print_results(name + " cancel", times);
+    }
+
+    g_dummy += map.size();
+}
+
+int main() {
+    size_t capacity = NUM_RESTING + NUM_ITERATIONS;
+
+    std::unordered_map<OrderId, Order> node_map;
+    node_map.reserve(capacity);
+    benchmark_map("std::unordered_map", std::move(node_map));
+
+    benchmark_map("FlatHashMap", FlatHashMap<OrderId, Order>(capacity));
+    return 0;
+}
@@ -0,0 +1,99 @@
+#include "../include/core/market_data_handler.hpp"
+#include "bench_utils.hpp"
+#include <random>
+
+using namespace trading;
+
+constexpr size_t NUM_MESSAGES = 1000000;
+
+// Mixed add/cancel/modify/execute frames encoded back to back
+std::vector<uint8_t> make_frames(std::vector<uint32_t>& offsets) {
+    std::vector<uint8_t> bytes;
+    bytes.reserve(NUM_MESSAGES * (MESSAGE_HEADER_SIZE + sizeof(AddOrderMsg)));
+    offsets.reserve(NUM_MESSAGES + 1);
+
+    std::mt19937 gen(5);
+    uint8_t buffer[sizeof(MarketMessage) + MESSAGE_HEADER_SIZE];
+
+    for (size_t i = 0; i < NUM_MESSAGES; ++i) {
+        MarketMessage msg{};
+        msg.instrument = static_cast<InstrumentId>(gen() % 16);
+        switch (gen() % 4) {
+            case 0:
+                msg.type = MessageType::AddOrder;
+                msg.add = {i + 1, Side::Bid, 80000 + Price(gen() % 100), 10};
+                break;
+            case 1:
+                msg.type = MessageType::CancelOrder;
+                msg.cancel = {i};
+                break;
+            case 2:
+                msg.type = MessageType::ModifyOrder;
+                msg.modify = {i, 5};
+                break;
+            default:
+                msg.type = MessageType::Execute;
+                msg.execute = {i, 1, 80000};
+                break;
+        }
+        offsets.push_back(static_cast<uint32_t>(bytes.size()));
+        size_t size = encode_message(msg, buffer);
+        bytes.insert(bytes.end(), buffer, buffer + size);
+    }
+    offsets.push_back(static_cast<uint32_t>(bytes.size()));
+    return bytes;
+}
+
+// Untimed: empty the queue so the next packet always fits
+void drain(MarketDataHandler::Queue& queue) {
+    while (MarketMessage* msg = queue.consume()) {
+        g_dummy += msg->instrument;
+        queue.release(msg);
+    }
+}
+
+void print_per_message(const std::string& name, std::vector<uint64_t>& times, size_t per_call) {
+    for (auto& t : times) t /= per_call;
+    print_results(name, times, times.size() / 10);
+}
+
+int main() {
+    std::vector<uint32_t> offsets;
+    std::vector<uint8_t> bytes = make_frames(offsets);
+
+    MarketDataHandler::Queue queue;
+    MarketDataHandler handler(queue);
+
+    std::cout << "Benchmarking MarketDataHandler ingest (amortised ns per message)..." << std::endl;
+
+    // push_raw_message: one queue commit per message
+    {
+        constexpr size_t PER_CALL = 64;
+        std::vector<uint64_t> times;
+        times.reserve(NUM_MESSAGES / PER_CALL);
+        for (size_t i = 0; i + PER_CALL <= NUM_MESSAGES; i += PER_CALL) {
+            times.push_back(measure_time_ns([&]() {
+                for (size_t j = i; j < i + PER_CALL; ++j)
+                    handler.push_raw_message(bytes.data() + offsets[j], offsets[j + 1] - offsets[j]);
+            }));
+            drain(queue);
+        }
+        print_per_message("push_raw_message x64", times, PER_CALL);
+    }
+
+    // push_raw_packet: frames walked in one loop, one queue commit per packet
+    for (size_t per_packet : {1, 8, 32, 64}) {
+        std::vector<uint64_t> times;
+        times.reserve(NUM_MESSAGES / per_packet);
+        for (size_t i = 0; i + per_packet <= NUM_MESSAGES; i += per_packet) {
+            const uint8_t* packet = bytes.data() + offsets[i];
+            size_t size = offsets[i + per_packet] - offsets[i];
+            times.push_back(measure_time_ns([&]() { handler.push_raw_packet(packet, size); }));
+            drain(queue);
+        }
+        print_per_message("push_raw_packet (" + std::to_string(per_packet) + " msgs/packet)",
+                          times, per_packet);
+    }
+
+    return 0;
+}
@@ -0,0 +1,232 @@
+#include "../include/core/market_data_handler.hpp"
+#include "../include/utils/cpu.hpp"
+#include "../include/utils/histogram.hpp"
+#include "../include/utils/tsc.hpp"
+#include "bench_utils.hpp"
+#include <array>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <cstdlib>
+#include <cstring>
+
+using namespace trading;
+
+// Wire-to-book latency: from the raw buffer reaching push_raw_message on the
+// feed thread to the book update returning on the consumer thread, stamped
+// with the TSC on both sides.
+
+struct Config {
+    size_t messages = 1000000;
+    std::array<unsigned, 4> mix{50, 30, 10, 10}; // add, cancel, modify, execute (%)
+    double rate = 500000;                        // paced run, msgs/sec
+    std::string json;                            // output path, "-" for stdout
+};
+
+struct EncodedFeed {
+    std::vector<uint8_t> bytes;
+    std::vector<uint32_t> offsets; // start of each message, plus end sentinel
+};
+
+struct RunResult {
+    std::string name;
+    double rate;
+    double throughput;
+    LatencyHistogram latency;
+};
+
+// Orders around a fixed mid; cancels/modifies/executes pick a live order
+EncodedFeed make_feed(const Config& config) {
+    EncodedFeed feed;
+    feed.bytes.reserve(config.messages * (MESSAGE_HEADER_SIZE + sizeof(AddOrderMsg)));
+    feed.offsets.reserve(config.messages + 1);
+
+    std::mt19937 gen(7);
+    std::discrete_distribution<int> action(config.mix.begin(), config.mix.end());
+    std::uniform_int_distribution<int64_t> offset_dist(1, 50);
+    std::uniform_int_distribution<int64_t> quantity_dist(1, 100);
+
+    std::vector<OrderId> live;
+    OrderId next_id = 1;
+    uint8_t buffer[sizeof(MarketMessage) + MESSAGE_HEADER_SIZE];
+
+    for (size_t i = 0; i < config.messages; ++i) {
+        MarketMessage msg{};
+        int kind = live.empty() ? 0 : action(gen);
+        size_t pick = live.empty() ? 0 : gen() % live.size();
+
+        switch (kind) {
+            case 0: {
+                Side side = gen() % 2 == 0 ? Side::Bid : Side::Ask;
+                Price price = side == Side::Bid ? 10000 - offset_dist(gen) : 10000 + offset_dist(gen);
+                msg.type = MessageType::AddOrder;
+                msg.add = {next_id, side, price, quantity_dist(gen)};
+                live.push_back(next_id++);
+                break;
+            }
+            case 1:
+                msg.type = MessageType::CancelOrder;
+                msg.cancel = {live[pick]};
+                live[pick] = live.back();
+                live.pop_back();
+                break;
+            case 2:
+                msg.type = MessageType::ModifyOrder;
+                msg.modify = {live[pick], quantity_dist(gen)};
+                break;
+            default:
+                msg.type = MessageType::Execute;
+                msg.execute = {live[pick], 1, 10000};
+                break;
+        }
+
+        feed.offsets.push_back(static_cast<uint32_t>(feed.bytes.size()));
+        size_t size = encode_message(msg, buffer);
+        feed.bytes.insert(feed.bytes.end(), buffer, buffer + size);
+    }
+    feed.offsets.push_back(static_cast<uint32_t>(feed.bytes.size()));
+    return feed;
+}
+
+// rate 0 pushes as fast as the queue accepts
+RunResult run(const EncodedFeed& feed, const std::string& name, double rate) {
+    size_t n = feed.offsets.size() - 1;
+    const TscClock& clock = TscClock::instance();
+
+    auto queue = std::make_unique<MarketDataHandler::Queue>();
+    MarketDataHandler handler(*queue);
+    OrderBook book;
+
+    std::vector<uint64_t> sent(n);
+    RunResult result{name, rate, 0, {}};
+    uint64_t last_applied = 0;
+
+    // messages come out in order, so the i-th consumed is the i-th sent
+    std::thread consumer([&]() {
+        pin_current_thread(1);
+        for (size_t i = 0; i < n;) {
+            MarketMessage* msg = queue->consume();
+            if (!msg) {
+                cpu_relax();
+                continue;
+            }
+            telemetry::on_dequeue(*msg, *queue);
+            apply_message(book, *msg);
+            telemetry::on_applied(*msg);
+            queue->release(msg);
+            last_applied = tsc_now();
+            result.latency.record(clock.to_ns(last_applied - sent[i]));
+            ++i;
+        }
+    });
+
+    pin_current_thread(0);
+    double ticks_per_msg = rate > 0 ? clock.ticks_per_ns() * 1e9 / rate : 0;
+    uint64_t start = tsc_now();
+
+    for (size_t i = 0; i < n; ++i) {
+        if (rate > 0) {
+            uint64_t due = start + static_cast<uint64_t>(i * ticks_per_msg);
+            while (tsc_now() < due) cpu_relax();
+        }
+        const uint8_t* msg = feed.bytes.data() + feed.offsets[i];
+        size_t size = feed.offsets[i + 1] - feed.offsets[i];
+
+        // stamped on arrival: time waiting for queue space counts
+        sent[i] = tsc_now();
+        while (!handler.push_raw_message(msg, size)) cpu_relax();
+    }
+    consumer.join();
+
+    result.throughput = n / (clock.to_ns(last_applied - start) * 1e-9);
+    return result;
+}
+
+std::string to_json(const Config& config, const std::vector<RunResult>& results) {
+    std::ostringstream out;
+    out << "{\"benchmark\":\"pipeline\",\"messages\":" << config.messages << ",\"mix\":{\"add\":"
+        << config.mix[0] << ",\"cancel\":" << config.mix[1] << ",\"modify\":" << config.mix[2]
+        << ",\"execute\":" << config.mix[3] << "},\"runs\":[";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const RunResult& r = results[i];
+        out << (i ? "," : "") << "{\"name\":\"" << r.name << "\",\"target_rate\":" << std::fixed
+            << std::setprecision(0) << r.rate << ",\"throughput_msgs_per_sec\":" << r.throughput
+            << ",\"latency_ns\":" << r.latency.to_json() << "}";
+    }
+    out << "]}";
+    return out.str();
+}
+
+bool parse(int argc, char** argv, Config& config) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (!value) return false;
+
+        if (arg == "--messages") {
+            config.messages = std::strtoull(value, nullptr, 10);
+        } else if (arg == "--rate") {
+            config.rate = std::strtod(value, nullptr);
+        } else if (arg == "--json") {
+            config.json = value;
+        } else if (arg == "--mix") {
+            // add,cancel,modify,execute percentages
+            std::istringstream in(value);
+            char comma;
+            if (!(in >> config.mix[0] >> comma >> config.mix[1] >> comma >> config.mix[2] >> comma >>
+                  config.mix[3]) || config.mix[0] == 0)
+                return false;
+        } else {
+            return false;
+        }
+        ++i;
+    }
+    return config.messages > 0;
+}
+
+int main(int argc, char** argv) {
+    Config config;
+    if (!parse(argc, argv, config)) {
+        std::cerr << "Usage: " << argv[0]
+                  << " [--messages N] [--mix add,cancel,modify,execute] [--rate msgs/sec] [--json path|-]\n";
+        return 1;
+    }
+
+    // calibrate before anything is timed
+    const TscClock& clock = TscClock::instance();
+
+    std::cout << "Benchmarking wire-to-book pipeline (" << config.messages << " messages, mix "
+              << config.mix[0] << "/" << config.mix[1] << "/" << config.mix[2] << "/" << config.mix[3]
+              << " add/cancel/modify/execute, TSC " << std::fixed << std::setprecision(3)
+              << clock.ticks_per_ns() << " ticks/ns)..." << std::endl;
+
+    EncodedFeed feed = make_feed(config);
+
+    std::vector<RunResult> results;
+    results.push_back(run(feed, "saturated", 0));
+    if (config.rate > 0) results.push_back(run(feed, "paced", config.rate));
+
+    for (const RunResult& r : results) {
+        std::ostringstream title;
+        title << "Wire-to-book latency, " << r.name;
+        if (r.rate > 0) title << " at " << std::fixed << std::setprecision(0) << r.rate << " msgs/sec";
+        title << " (sustained " << std::fixed << std::setprecision(0) << r.throughput << " msgs/sec)";
+        r.latency.print(std::cout, title.str());
+    }
+
+    // per-stage breakdown, both runs together
+    if constexpr (telemetry::ENABLED) telemetry::snapshot().print(std::cout);
+
+    if (!config.json.empty()) {
+        std::string json = to_json(config, results);
+        if (config.json == "-") {
+            std::cout << json << std::endl;
+        } else {
+            std::ofstream(config.json) << json << std::endl;
+            std::cout << "JSON written to " << config.json << std::endl;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,170 @@
+#include "../include/utils/lock_free_queue.hpp"
+#include "../include/utils/slot_queue.hpp"
+#include "../include/utils/cpu.hpp"
+#include "bench_utils.hpp"
+#include <atomic>
+#include <thread>
+#include <memory>
+#include <cstdlib>
+
+using namespace trading;
+
+constexpr size_t QUEUE_SIZE = 1024;
+constexpr size_t DEFAULT_ROUND_TRIPS = 100000;
+constexpr size_t DEFAULT_ITEMS = 10000000;
+constexpr size_t BATCH = 32;
+
+// Baseline: the previous design, re-reading the remote index on every call and
+// wrapping with % N. Kept here only for comparison.
+template <typename T, size_t N>
+class UncachedQueue {
+public:
+    bool push(T* item) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        size_t next = (head + 1) % N;
+        if (next == tail_.load(std::memory_order_acquire)) return false;
+        buffer_[head] = item;
+        head_.store(next, std::memory_order_release);
+        return true;
+    }
+
+    T* pop() {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail == head_.load(std::memory_order_acquire)) return nullptr;
+        T* item = buffer_[tail];
+        tail_.store((tail + 1) % N, std::memory_order_release);
+        return item;
+    }
+
+private:
+    std::atomic<size_t> head_{0};
+    std::atomic<size_t> tail_{0};
+    T* buffer_[N];
+};
+
+// Common push/pop over the pointer queues and the by-value SlotQueue
+template <typename Q>
+bool push_one(Q& q, uint64_t* item) { return q.push(item); }
+template <typename Q>
+bool pop_one(Q& q, uint64_t*& out) { return (out = q.pop()) != nullptr; }
+
+bool push_one(SlotQueue<uint64_t*, QUEUE_SIZE>& q, uint64_t* item) { return q.push(item); }
+bool pop_one(SlotQueue<uint64_t*, QUEUE_SIZE>& q, uint64_t*& out) { return q.pop(out); }
+
+// Round trip latency: a token goes out on one queue and is echoed back on another
+template <typename Q>
+void ping_pong(const std::string& name, size_t round_trips) {
+    auto to = std::make_unique<Q>();
+    auto from = std::make_unique<Q>();
+    uint64_t token = 0;
+    std::atomic<bool> done{false};
+
+    std::thread echo([&]() {
+        pin_current_thread(1);
+        uint64_t* item;
+        while (!done.load(std::memory_order_relaxed)) {
+            if (!pop_one(*to, item)) {
+                cpu_relax();
+                continue;
+            }
+            while (!push_one(*from, item)) cpu_relax();
+        }
+    });
+    pin_current_thread(0);
+
+    std::vector<uint64_t> times;
+    times.reserve(round_trips);
+    size_t warmup = round_trips / 10;
+
+    for (size_t i = 0; i < round_trips; ++i) {
+        times.push_back(measure_time_ns([&]() {
+            uint64_t* item;
+            while (!push_one(*to, &token)) cpu_relax();
+            while (!pop_one(*from, item)) cpu_relax();
+            g_dummy += *item;
+        }));
+    }
+
+    done.store(true, std::memory_order_relaxed);
+    echo.join();
+    print_results(name + " ping-pong (round trip)", times, warmup);
+}
+
+// Producer streams items to a consumer; single-item or batched operations
+template <typename Q, typename Push, typename Pop>
+void throughput(const std::string& name, size_t items, Push push, Pop pop) {
+    auto q = std::make_unique<Q>();
+    std::vector<uint64_t> values(items);
+    for (size_t i = 0; i < items; ++i) values[i] = i;
+
+    auto start = std::chrono::steady_clock::now();
+    std::thread producer([&]() {
+        pin_current_thread(0);
+        size_t next = 0;
+        while (next < items) {
+            size_t n = push(*q, values.data() + next, items - next);
+            if (n == 0) cpu_relax();
+            next += n;
+        }
+    });
+
+    pin_current_thread(1);
+    uint64_t sum = 0;
+    size_t received = 0;
+    uint64_t* out[BATCH];
+    while (received < items) {
+        size_t n = pop(*q, out);
+        if (n == 0) cpu_relax();
+        for (size_t i = 0; i < n; ++i) sum += *out[i];
+        received += n;
+    }
+    producer.join();
+    auto end = std::chrono::steady_clock::now();
+    g_dummy += sum;
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    std::cout << name << std::endl;
+    std::cout << "  items/sec: " << std::setw(14) << std::fixed << std::setprecision(0)
+              << items / seconds << std::endl;
+    std::cout << "  ns/item:   " << std::setw(14) << std::setprecision(2)
+              << seconds * 1e9 / items << std::endl;
+    std::cout << std::endl;
+}
+
+template <typename Q>
+size_t push_single(Q& q, uint64_t* items, size_t) { return push_one(q, items) ? 1 : 0; }
+
+template <typename Q>
+size_t pop_single(Q& q, uint64_t** out) { return pop_one(q, out[0]) ? 1 : 0; }
+
+size_t push_batch(LockFreeQueue<uint64_t, QUEUE_SIZE>& q, uint64_t* items, size_t remaining) {
+    uint64_t* batch[BATCH];
+    size_t n = std::min(BATCH, remaining);
+    for (size_t i = 0; i < n; ++i) batch[i] = items + i;
+    return q.push_n(batch, n);
+}
+
+size_t pop_batch(LockFreeQueue<uint64_t, QUEUE_SIZE>& q, uint64_t** out) { return q.pop_n(out, BATCH); }
+
+int main(int argc, char** argv) {
+    size_t round_trips = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : DEFAULT_ROUND_TRIPS;
+    size_t items = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : DEFAULT_ITEMS;
+
+    using Uncached = UncachedQueue<uint64_t, QUEUE_SIZE>;
+    using Pointer = LockFreeQueue<uint64_t, QUEUE_SIZE>;
+    using Slot = SlotQueue<uint64_t*, QUEUE_SIZE>;
+
+    std::cout << "Benchmarking SPSC queues (" << QUEUE_SIZE << " slots, " << round_trips
+              << " round trips, " << items << " items)..." << std::endl;
+
+    ping_pong<Uncached>("Uncached baseline", round_trips);
+    ping_pong<Pointer>("LockFreeQueue", round_trips);
+    ping_pong<Slot>("SlotQueue", round_trips);
+
+    throughput<Uncached>("Uncached baseline throughput", items, push_single<Uncached>, pop_single<Uncached>);
+    throughput<Pointer>("LockFreeQueue throughput", items, push_single<Pointer>, pop_single<Pointer>);
+    throughput<Pointer>("LockFreeQueue push_n/pop_n throughput (batch " + std::to_string(BATCH) + ")",
+                        items, push_batch, pop_batch);
+    throughput<Slot>("SlotQueue throughput", items, push_single<Slot>, pop_single<Slot>);
+    return 0;
+}
@@ -0,0 +1,101 @@
+#include "../include/utils/sequenced_queue.hpp"
+#include "../include/utils/cpu.hpp"
+#include "bench_utils.hpp"
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <cstdlib>
+
+using namespace trading;
+
+constexpr size_t QUEUE_SIZE = 4096;
+constexpr size_t DEFAULT_ITEMS = 4000000;
+
+struct Item {
+    uint64_t producer;
+    uint64_t seq;
+};
+
+// Total items/sec with `producers` threads sharing one queue into `consumers` threads
+template <typename Q>
+double run(size_t items, size_t producers, size_t consumers) {
+    auto queue = std::make_unique<Q>();
+    size_t per_producer = items / producers;
+    size_t total = per_producer * producers;
+
+    std::atomic<bool> go{false};
+    std::atomic<size_t> received{0};
+    std::vector<std::thread> threads;
+
+    for (size_t p = 0; p < producers; ++p) {
+        threads.emplace_back([&, p]() {
+            pin_current_thread(static_cast<int>((consumers + p) % num_cores()));
+            while (!go.load(std::memory_order_acquire)) cpu_relax();
+            for (size_t i = 0; i < per_producer; ++i)
+                while (!queue->push({p, i})) cpu_relax();
+        });
+    }
+    for (size_t c = 1; c < consumers; ++c) {
+        threads.emplace_back([&, c]() {
+            pin_current_thread(static_cast<int>(c % num_cores()));
+            uint64_t sum = 0;
+            Item out;
+            while (received.load(std::memory_order_relaxed) < total) {
+                if (!queue->pop(out)) {
+                    cpu_relax();
+                    continue;
+                }
+                sum += out.seq;
+                received.fetch_add(1, std::memory_order_relaxed);
+            }
+            g_dummy += sum;
+        });
+    }
+
+    // this thread is the first consumer
+    pin_current_thread(0);
+    auto start = std::chrono::steady_clock::now();
+    go.store(true, std::memory_order_release);
+
+    uint64_t sum = 0;
+    Item out;
+    while (received.load(std::memory_order_relaxed) < total) {
+        if (!queue->pop(out)) {
+            cpu_relax();
+            continue;
+        }
+        sum += out.seq;
+        received.fetch_add(1, std::memory_order_relaxed);
+    }
+    auto end = std::chrono::steady_clock::now();
+    for (auto& t : threads) t.join();
+    g_dummy += sum;
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    return total / seconds;
+}
+
+template <typename Q>
+void sweep(const std::string& name, size_t items, size_t consumers) {
+    std::cout << name << " (" << consumers << " consumer" << (consumers > 1 ? "s" : "") << ")"
+              << std::endl;
+    for (size_t producers : {1, 2, 4, 8}) {
+        double rate = run<Q>(items, producers, consumers);
+        std::cout << "  producers: " << std::setw(2) << producers
+                  << "  items/sec: " << std::setw(14) << std::fixed << std::setprecision(0) << rate
+                  << std::endl;
+    }
+    std::cout << std::endl;
+}
+
+int main(int argc, char** argv) {
+    size_t items = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : DEFAULT_ITEMS;
+
+    std::cout << "Benchmarking multi-producer queues (" << QUEUE_SIZE << " slots, " << items
+              << " items, " << num_cores() << " cores)..." << std::endl;
+
+    sweep<MpscQueue<Item, QUEUE_SIZE>>("MpscQueue", items, 1);
+    sweep<MpmcQueue<Item, QUEUE_SIZE>>("MpmcQueue", items, 1);
+    sweep<MpmcQueue<Item, QUEUE_SIZE>>("MpmcQueue", items, 2);
+    return 0;
+}
@@ -0,0 +1,129 @@
+#include "../include/core/risk_gate.hpp"
+#include "bench_utils.hpp"
+#include <random>
+
+using namespace trading;
+
+constexpr size_t NUM_CHECKS = 1000000;
+constexpr Price MID = 80000;
+
+// Orders around the mid; reject_pct of them break one random limit
+std::vector<Order> make_orders(unsigned reject_pct) {
+    std::mt19937 gen(13);
+    std::uniform_int_distribution<Price> offset(-200, 200);
+    std::uniform_int_distribution<Quantity> quantity(1, 100);
+    std::vector<Order> orders;
+    orders.reserve(NUM_CHECKS);
+    for (size_t i = 0; i < NUM_CHECKS; ++i) {
+        Order o{i + 1, gen() % 2 ? Side::Ask : Side::Bid, MID + offset(gen), quantity(gen)};
+        if (gen() % 100 < reject_pct) {
+            switch (gen() % 3) {
+                case 0: o.quantity = 5000; break;         // order size
+                case 1: o.price = MID + 2000; break;      // price band
+                default: o.quantity = -o.quantity; break; // order size (non-positive)
+            }
+        }
+        orders.push_back(o);
+    }
+    return orders;
+}
+
+void run(const std::string& name, unsigned reject_pct) {
+    std::vector<Order> orders = make_orders(reject_pct);
+
+    OrderBook book;
+    for (int level = 1; level <= 10; ++level) {
+        book.add_order({OrderId(level), Side::Bid, MID - level, 100});
+        book.add_order({OrderId(100 + level), Side::Ask, MID + level, 100});
+    }
+
+    // exposure limits far enough out that only the injected orders fail
+    RiskLimits limits;
+    limits.max_open_notional = {INT64_MAX / 2, INT64_MAX / 2};
+    limits.max_position = {INT64_MAX / 2, INT64_MAX / 2};
+    limits.max_messages = 0; // rate limits tested separately below
+    RiskGate gate(limits);
+
+    // Accepted orders are cancelled again (untimed) so exposure stays flat
+    auto release = [&](const Order& o, RiskReject r) {
+        if (r == RiskReject::None) gate.on_cancel(o.side, o.price, o.quantity);
+    };
+
+    // per check, timer floor included
+    {
+        std::vector<uint64_t> times;
+        times.reserve(NUM_CHECKS);
+        for (const Order& o : orders) {
+            RiskReject r;
+            times.push_back(measure_time_ns([&]() { r = gate.check(o, book, 0); }));
+            release(o, r);
+        }
+        print_results(name + " check", times);
+    }
+
+    // amortised over batches of 64
+    {
+        constexpr size_t PER_CALL = 64;
+        std::array<RiskReject, PER_CALL> results;
+        std::vector<uint64_t> times;
+        times.reserve(NUM_CHECKS / PER_CALL);
+        for (size_t i = 0; i + PER_CALL <= NUM_CHECKS; i += PER_CALL) {
+            times.push_back(measure_time_ns([&]() {
+                for (size_t j = 0; j < PER_CALL; ++j) results[j] = gate.check(orders[i + j], book, 0);
+            }));
+            for (size_t j = 0; j < PER_CALL; ++j) release(orders[i + j], results[j]);
+        }
+        for (auto& t : times) t /= PER_CALL;
+        print_results(name + " check (amortised)", times, times.size() / 10);
+    }
+
+    std::cout << "  accepted " << gate.count(RiskReject::None) << ", rejected";
+    for (size_t r = 1; r < RISK_REJECT_COUNT; ++r)
+        std::cout << " " << reject_name(static_cast<RiskReject>(r)) << "=" << gate.count(static_cast<RiskReject>(r));
+    std::cout << std::endl << std::endl;
+}
+
+// Throttled: TSC read per check, and a rate the stream runs into
+void run_throttled() {
+    OrderBook book;
+    book.add_order({1, Side::Bid, MID - 1, 100});
+    book.add_order({2, Side::Ask, MID + 1, 100});
+
+    RiskLimits limits;
+    limits.max_messages = 1000;
+    limits.throttle_window_ns = 1000000; // 1 per microsecond, bursts of 1000
+    RiskGate gate(limits);
+
+    std::vector<uint64_t> times;
+    times.reserve(NUM_CHECKS);
+    Order o{1, Side::Bid, MID, 1};
+    for (size_t i = 0; i < NUM_CHECKS; ++i) {
+        o.side = i % 2 ? Side::Ask : Side::Bid;
+        RiskReject r;
+        times.push_back(measure_time_ns([&]() { r = gate.check(o, book); }));
+        if (r == RiskReject::None) gate.on_cancel(o.side, o.price, o.quantity);
+    }
+    print_results("throttled check (reads TSC)", times);
+    std::cout << "  accepted " << gate.count(RiskReject::None) << ", throttled " << gate.count(RiskReject::Throttle)
+              << std::endl << std::endl;
+}
+
+// What measure_time_ns reports for no work at all
+void run_timer_floor() {
+    std::vector<uint64_t> times;
+    times.reserve(NUM_CHECKS);
+    for (size_t i = 0; i < NUM_CHECKS; ++i) times.push_back(measure_time_ns([&]() { g_dummy += i; }));
+    print_results("timer floor (empty measurement)", times);
+    std::cout << std::endl;
+}
+
+int main() {
+    TscClock::instance();
+    std::cout << "Benchmarking RiskGate (" << NUM_CHECKS << " checks per run)..." << std::endl;
+    run_timer_floor();
+    run("all pass", 0);
+    run("5% rejects", 5);
+    run("50% rejects", 50);
+    run_throttled();
+    return 0;
+}
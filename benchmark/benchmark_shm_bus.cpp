@@ -0,0 +1,147 @@
+#include "../include/core/shm_bus.hpp"
+#include "../include/utils/event_loop.hpp"
+#include "../include/utils/histogram.hpp"
+#include "bench_utils.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <string>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace trading;
+
+// Fan-out over the shared-memory bus: one writer (this process) publishes to
+// N forked reader processes. Each message carries the writer's TSC at
+// publish; readers record publish -> read latency and report back through an
+// anonymous shared mapping. A slow reader stalls 5 ms every 1024 messages to
+// show overrun detection without the writer or the other readers noticing.
+
+constexpr size_t BUS_CAPACITY = 1 << 16;
+constexpr size_t DEFAULT_MESSAGES = 2000000;
+constexpr size_t MAX_READERS = 8;
+
+struct alignas(64) ReaderResult {
+    uint64_t received;
+    uint64_t overruns;
+    uint64_t lost;
+    uint64_t p50, p99, p999, max;
+};
+
+struct Shared {
+    std::atomic<uint32_t> ready;
+    ReaderResult readers[MAX_READERS];
+};
+
+static void reader_process(const std::string& name, Shared& shared, size_t index, bool slow, int core) {
+    if (core >= 0) pin_current_thread(core);
+    ShmBusReader reader(name);
+    if (!reader.is_open()) ::_exit(1);
+    const TscClock& clock = TscClock::instance();
+    LatencyHistogram latency;
+    SpinYieldWait wait; // with fewer cores than processes, spinning would starve the writer
+    shared.ready.fetch_add(1, std::memory_order_release);
+
+    uint64_t received = 0;
+    MarketMessage msg;
+    while (true) {
+        BusRead result = reader.poll(msg);
+        if (result == BusRead::Message) {
+            uint64_t now = tsc_now();
+            latency.record(clock.to_ns(now > msg.trade.buyOrderId ? now - msg.trade.buyOrderId : 0));
+            wait.reset();
+            if (slow && ++received % 1024 == 0) ::usleep(5000);
+        } else if (result == BusRead::Empty) {
+            if (reader.writer_closed() && reader.poll(msg) == BusRead::Empty) break;
+            wait.idle([] { return false; });
+        }
+    }
+
+    ReaderResult& out = shared.readers[index];
+    out.received = latency.count();
+    out.overruns = reader.overruns();
+    out.lost = reader.lost();
+    out.p50 = latency.percentile(50);
+    out.p99 = latency.percentile(99);
+    out.p999 = latency.percentile(99.9);
+    out.max = latency.max();
+    ::_exit(0);
+}
+
+// interval_ns 0: publish flat out
+static void run(const std::string& label, size_t messages, size_t readers, size_t slow, uint64_t interval_ns) {
+    std::string name = "/trading_bench_bus_" + std::to_string(::getpid());
+    auto* shared = static_cast<Shared*>(
+        ::mmap(nullptr, sizeof(Shared), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0));
+    if (shared == MAP_FAILED) return;
+    new (shared) Shared{};
+
+    // pin only if every process can have its own core
+    bool pin = num_cores() > readers;
+    auto writer = std::make_unique<ShmBusWriter>(name, BUS_CAPACITY);
+    if (!writer->is_open()) {
+        std::cout << label << ": could not create " << name << std::endl;
+        ::munmap(shared, sizeof(Shared));
+        return;
+    }
+
+    std::vector<pid_t> children;
+    for (size_t r = 0; r < readers; ++r) {
+        pid_t pid = ::fork();
+        if (pid == 0) reader_process(name, *shared, r, r >= readers - slow, pin ? int(r + 1) : -1);
+        children.push_back(pid);
+    }
+    while (shared->ready.load(std::memory_order_acquire) < readers) ::usleep(100);
+    if (pin) pin_current_thread(0);
+
+    const TscClock& clock = TscClock::instance();
+    uint64_t interval = static_cast<uint64_t>(interval_ns * clock.ticks_per_ns());
+    uint64_t start = tsc_now();
+    uint64_t next = start;
+    for (size_t i = 0; i < messages; ++i) {
+        if (interval) {
+            while (tsc_now() < next) cpu_relax();
+            next += interval;
+        }
+        MarketMessage* msg = writer->claim();
+        msg->type = MessageType::Trade;
+        msg->instrument = 1;
+        msg->trade = {tsc_now(), i, 1, 100};
+        writer->commit();
+    }
+    double publish_ns = double(clock.to_ns(tsc_now() - start)) / messages;
+    writer.reset(); // marks the bus closed: readers drain and exit
+
+    for (pid_t pid : children) ::waitpid(pid, nullptr, 0);
+
+    std::cout << label << " (" << readers << " reader" << (readers > 1 ? "s" : "") << ", "
+              << (interval_ns ? std::to_string(1000000000 / interval_ns) + " msg/s" : std::string("flat out"))
+              << ")" << std::endl;
+    std::cout << "  writer: " << std::fixed << std::setprecision(1) << publish_ns << " ns/message" << std::endl;
+    for (size_t r = 0; r < readers; ++r) {
+        const ReaderResult& res = shared->readers[r];
+        std::cout << "  reader " << r << (r >= readers - slow ? " (slow)" : "       ")
+                  << "  received: " << std::setw(8) << res.received << "  lost: " << std::setw(8) << res.lost
+                  << "  overruns: " << std::setw(4) << res.overruns << "  latency p50/p99/p99.9/max: " << res.p50
+                  << " / " << res.p99 << " / " << res.p999 << " / " << res.max << " ns" << std::endl;
+    }
+    std::cout << std::endl;
+    ::munmap(shared, sizeof(Shared));
+}
+
+int main(int argc, char** argv) {
+    size_t messages = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : DEFAULT_MESSAGES;
+    TscClock::instance(); // calibrate once; readers inherit it
+
+    std::cout << "Benchmarking shared-memory bus fan-out (" << BUS_CAPACITY << " slots, "
+              << sizeof(ShmBusSlot) << " B/slot, " << messages << " messages, " << num_cores() << " cores)..."
+              << std::endl;
+    if (num_cores() < 2)
+        std::cout << "  note: readers share a core with the writer, latency includes scheduling" << std::endl;
+    std::cout << std::endl;
+
+    for (size_t readers : {1, 2, 4}) run("Paced", messages / 4, readers, 0, 1000);
+    for (size_t readers : {1, 2, 4}) run("Flat out", messages, readers, 0, 0);
+    run("Slow reader", messages / 4, 3, 1, 1000);
+    return 0;
+}
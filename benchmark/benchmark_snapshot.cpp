@@ -0,0 +1,97 @@
+#include "../include/core/book_snapshot.hpp"
+#include "bench_utils.hpp"
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <thread>
+#include <cstdlib>
+#include <unistd.h>
+
+using namespace trading;
+
+// Snapshot save and load times for a large book, and what checkpointing
+// costs the book thread: forward() per message and checkpoint() per snapshot,
+// timed while the background thread applies and writes.
+
+constexpr size_t DEFAULT_ORDERS = 1000000;
+
+// Resting orders spread over a few thousand levels each side of a mid
+std::vector<Order> make_orders(size_t n) {
+    std::vector<Order> orders;
+    orders.reserve(n);
+    std::mt19937 gen(5);
+    std::uniform_int_distribution<int64_t> offset_dist(1, 3000);
+    std::uniform_int_distribution<int64_t> quantity_dist(1, 100);
+    for (size_t i = 0; i < n; ++i) {
+        Side side = i % 2 == 0 ? Side::Bid : Side::Ask;
+        Price price = side == Side::Bid ? 100000 - offset_dist(gen) : 100000 + offset_dist(gen);
+        orders.push_back({i + 1, side, price, quantity_dist(gen)});
+    }
+    return orders;
+}
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : DEFAULT_ORDERS;
+    std::string path = "/tmp/benchmark_snapshot_" + std::to_string(::getpid()) + ".snap";
+
+    std::cout << "Benchmarking book snapshots (" << n << " resting orders)..." << std::endl;
+    auto orders = make_orders(n);
+    BookConfig config{DEFAULT_TICK_SIZE, DEFAULT_LADDER_WIDTH, n};
+
+    OrderBook book(config);
+    for (const auto& order : orders) book.add_order(order);
+
+    auto ms = [](auto since) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - since).count();
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    book.save_snapshot(path, n);
+    std::cout << "  save:  " << std::fixed << std::setprecision(2) << ms(start) << " ms" << std::endl;
+
+    OrderBook restored(config);
+    start = std::chrono::steady_clock::now();
+    auto sequence = restored.load_snapshot(path);
+    std::cout << "  load:  " << ms(start) << " ms (sequence " << sequence.value_or(0) << ")" << std::endl;
+
+    start = std::chrono::steady_clock::now();
+    OrderBook rebuilt(config);
+    for (const auto& order : orders) rebuilt.add_order(order);
+    std::cout << "  replaying the adds instead: " << ms(start) << " ms" << std::endl << std::endl;
+
+    // book thread cost while the replica follows and checkpoints are written
+    {
+        BookCheckpointer checkpointer(path, config);
+        std::vector<MarketMessage> feed(NUM_ITERATIONS + NUM_WARMUP);
+        for (size_t i = 0; i < feed.size(); ++i) {
+            feed[i].type = MessageType::ModifyOrder;
+            feed[i].modify = {orders[i % n].id, static_cast<Quantity>(1 + i % 100)};
+        }
+
+        std::vector<uint64_t> forward_times, checkpoint_times;
+        uint64_t requested = 0;
+        forward_times.reserve(feed.size());
+        uint64_t next_sequence = *sequence + 1;
+        for (size_t i = 0; i < feed.size(); ++i) {
+            apply_message(book, feed[i]);
+            forward_times.push_back(measure_time_ns([&]() { checkpointer.forward(feed[i], next_sequence++); }));
+            if ((i + 1) % 10000 == 0)
+                checkpoint_times.push_back(measure_time_ns([&]() { requested += checkpointer.checkpoint(); }));
+
+            // the ring absorbs bursts; give a single core's worth of
+            // background thread a chance to keep up
+            if ((i + 1) % 4096 == 0) std::this_thread::yield();
+        }
+        print_results("BookCheckpointer::forward", forward_times);
+        print_results("BookCheckpointer::checkpoint", checkpoint_times, 0);
+
+        while (checkpointer.checkpoints() + checkpointer.failures() < requested)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        std::cout << "Checkpoints written: " << checkpointer.checkpoints() << ", last at sequence "
+                  << checkpointer.checkpoint_sequence() << (checkpointer.diverged() ? " (replica diverged)" : "")
+                  << std::endl;
+    }
+
+    std::remove(path.c_str());
+    return 0;
+}
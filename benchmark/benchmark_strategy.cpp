@@ -0,0 +1,175 @@
+#include "../include/core/strategy.hpp"
+#include "../include/utils/generator.hpp"
+#include "../examples/market_maker.hpp"
+#include "bench_utils.hpp"
+#include <memory>
+
+using namespace trading;
+
+// Callback cost per book event: the generator's order flow applied through
+// BookEvents with strategies subscribed to different events, against plain
+// apply_message. Per-event overhead is the extra time per message divided by
+// the events delivered per message.
+
+struct Ignores : Strategy<Ignores> {};
+
+struct CountTop : Strategy<CountTop> {
+    uint64_t events = 0;
+    void on_bbo(const BBOUpdateMsg& bbo) { events += bbo.bidSize > 0; }
+};
+
+struct CountAll : Strategy<CountAll> {
+    uint64_t events = 0;
+    void on_bbo(const BBOUpdateMsg& bbo) { events += bbo.bidSize > 0; }
+    void on_level(const LevelUpdateMsg& level) { events += level.qty > 0; }
+    void on_trade(const TradeMsg&) { ++events; }
+    void on_execute(const ExecuteMsg& execute) { events += execute.qty > 0; }
+};
+
+// The same handlers behind a virtual interface, for comparison
+struct Listener {
+    virtual ~Listener() = default;
+    virtual void bbo(const BBOUpdateMsg&) = 0;
+    virtual void level(const LevelUpdateMsg&) = 0;
+    virtual void execute(const ExecuteMsg&) = 0;
+};
+
+struct CountingListener : Listener {
+    uint64_t events = 0;
+    void bbo(const BBOUpdateMsg& bbo) override { events += bbo.bidSize > 0; }
+    void level(const LevelUpdateMsg& level) override { events += level.qty > 0; }
+    void execute(const ExecuteMsg& execute) override { events += execute.qty > 0; }
+};
+
+struct VirtualForward : Strategy<VirtualForward> {
+    Listener* listener;
+    explicit VirtualForward(Listener* l) : listener(l) {}
+    void on_bbo(const BBOUpdateMsg& bbo) { listener->bbo(bbo); }
+    void on_level(const LevelUpdateMsg& level) { listener->level(level); }
+    void on_execute(const ExecuteMsg& execute) { listener->execute(execute); }
+};
+
+// Counts calls per event type without changing what is detected
+struct EventTally : Strategy<EventTally> {
+    uint64_t bbo = 0, level = 0, execute = 0;
+    void on_bbo(const BBOUpdateMsg&) { ++bbo; }
+    void on_level(const LevelUpdateMsg&) { ++level; }
+    void on_execute(const ExecuteMsg&) { ++execute; }
+};
+
+static std::vector<MarketMessage> decode_cycle(const FeedGenerator& generator) {
+    auto bytes = generator.bytes();
+    auto offsets = generator.offsets();
+    std::vector<MarketMessage> msgs(offsets.size());
+    for (size_t i = 0; i < offsets.size(); ++i) {
+        msgs[i] = {};
+        msgs[i].type = static_cast<MessageType>(bytes[offsets[i]]);
+        std::memcpy(&msgs[i].add, bytes.data() + offsets[i] + MESSAGE_HEADER_SIZE, payload_size(msgs[i].type));
+    }
+    return msgs;
+}
+
+// Amortised ns per message over batches of 64; returns the mean. The cycle
+// leaves the book empty, so an untimed first lap warms everything up.
+template <typename Apply>
+double run(const std::string& name, const std::vector<MarketMessage>& msgs, Apply&& apply) {
+    for (const auto& msg : msgs) apply(msg);
+
+    constexpr size_t PER_CALL = 64;
+    std::vector<uint64_t> times;
+    times.reserve(msgs.size() / PER_CALL);
+    for (size_t i = 0; i + PER_CALL <= msgs.size(); i += PER_CALL) {
+        times.push_back(measure_time_ns([&]() {
+            for (size_t j = i; j < i + PER_CALL; ++j) apply(msgs[j]);
+        }));
+    }
+    for (auto& t : times) t /= PER_CALL;
+    print_results(name, times, times.size() / 10);
+    double mean = 0;
+    for (uint64_t t : times) mean += t;
+    return mean / times.size();
+}
+
+int main() {
+    auto queue = std::make_unique<MarketDataHandler::Queue>();
+    MarketDataHandler handler(*queue);
+    FeedProfile profile;
+    profile.cycle = 1 << 20;
+    FeedGenerator generator(handler, profile);
+    std::vector<MarketMessage> msgs = decode_cycle(generator);
+
+    // events a fully subscribed strategy sees over the cycle
+    EventTally tally;
+    {
+        OrderBook book;
+        BookEvents events(book, tally);
+        for (const auto& msg : msgs) events.apply(msg);
+    }
+    double per_msg_all = double(tally.bbo + tally.level + tally.execute) / msgs.size();
+    double per_msg_bbo = double(tally.bbo) / msgs.size();
+
+    std::cout << "Benchmarking BookEvents dispatch over " << msgs.size() << " generator messages "
+              << "(amortised ns per message)..." << std::endl;
+    std::cout << "  per message: " << std::setprecision(3) << per_msg_bbo << " BBO events, "
+              << double(tally.level) / msgs.size() << " level events, " << double(tally.execute) / msgs.size()
+              << " execute events" << std::endl << std::endl;
+
+    double baseline;
+    {
+        OrderBook book;
+        baseline = run("apply_message (no events)", msgs, [&](const MarketMessage& m) { apply_message(book, m); });
+    }
+    {
+        OrderBook book;
+        Ignores s;
+        BookEvents events(book, s);
+        run("BookEvents, no subscriptions", msgs, [&](const MarketMessage& m) { events.apply(m); });
+    }
+    auto report = [&](double mean, double per_msg) {
+        std::cout << "  overhead: " << std::fixed << std::setprecision(1) << mean - baseline << " ns/message, "
+                  << (mean - baseline) / per_msg << " ns/event" << std::endl << std::endl;
+        std::cout.unsetf(std::ios::fixed);
+    };
+    {
+        OrderBook book;
+        CountTop s;
+        BookEvents events(book, s);
+        report(run("BookEvents, BBO only", msgs, [&](const MarketMessage& m) { events.apply(m); }), per_msg_bbo);
+        g_dummy += s.events;
+    }
+    {
+        OrderBook book;
+        CountAll s;
+        BookEvents events(book, s);
+        report(run("BookEvents, all events", msgs, [&](const MarketMessage& m) { events.apply(m); }), per_msg_all);
+        g_dummy += s.events;
+    }
+    {
+        OrderBook book;
+        CountAll a, b, c, d;
+        BookEvents events(book, a, b, c, d);
+        report(run("BookEvents, all events x4 strategies", msgs, [&](const MarketMessage& m) { events.apply(m); }),
+               4 * per_msg_all);
+        g_dummy += a.events + b.events + c.events + d.events;
+    }
+    {
+        OrderBook book;
+        CountingListener listener;
+        Listener* opaque = &listener;
+        asm volatile("" : "+r"(opaque)); // keep the compiler from devirtualising
+        VirtualForward s(opaque);
+        BookEvents events(book, s);
+        report(run("BookEvents, all events via virtual calls", msgs, [&](const MarketMessage& m) { events.apply(m); }),
+               per_msg_all);
+        g_dummy += listener.events;
+    }
+    {
+        OrderBook book;
+        MarketMaker maker(book);
+        BookEvents events(book, maker);
+        report(run("BookEvents, sample MarketMaker", msgs, [&](const MarketMessage& m) { events.apply(m); }),
+               per_msg_bbo + double(tally.execute) / msgs.size());
+        g_dummy += maker.quotes();
+    }
+    return 0;
+}
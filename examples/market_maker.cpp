@@ -0,0 +1,51 @@
+#include "market_maker.hpp"
+#include "../include/utils/generator.hpp"
+#include "../include/utils/event_loop.hpp"
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <cstdlib>
+
+using namespace trading;
+
+// Runs the sample market maker against the generator feed: the book thread
+// applies each message through BookEvents, which calls the strategy on BBO
+// changes and executes.
+int main(int argc, char** argv) {
+    uint64_t messages = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 5000000;
+
+    auto queue = std::make_unique<MarketDataHandler::Queue>();
+    MarketDataHandler handler(*queue);
+    OrderBook book;
+
+    RiskLimits limits;
+    limits.max_price_deviation = 20;
+    limits.max_position = {200, 200};
+    limits.max_messages = 0;
+    MarketMaker maker(book, {}, limits);
+    BookEvents events(book, maker);
+
+    EventLoop<MarketDataHandler::Queue> loop(*queue);
+    loop.start([&](MarketMessage& msg) { events.apply(msg); }, 1);
+
+    FeedProfile profile;
+    profile.cycle = 1 << 20;
+    profile.rate = 0; // as fast as the book thread keeps up
+    FeedGenerator generator(handler, profile);
+    generator.run(messages);
+    loop.stop();
+
+    auto stats = loop.stats();
+    const RiskGate& gate = maker.gate();
+    std::cout << "Messages:  " << stats.messages << "\n";
+    std::cout << "Quotes:    " << maker.quotes() << " sent, ";
+    for (size_t r = 1; r < RISK_REJECT_COUNT; ++r) {
+        auto reason = static_cast<RiskReject>(r);
+        if (gate.count(reason) > 0) std::cout << gate.count(reason) << " " << reject_name(reason) << " ";
+    }
+    std::cout << "rejected\n";
+    std::cout << "Fills:     " << maker.fills() << "\n";
+    std::cout << "Inventory: " << maker.inventory() << "\n";
+    std::cout << "PnL:       " << std::fixed << std::setprecision(0) << maker.pnl() << " (price units)\n";
+    return 0;
+}
@@ -0,0 +1,99 @@
+#pragma once
+#include "../include/core/strategy.hpp"
+#include "../include/core/risk_gate.hpp"
+#include <array>
+#include <cmath>
+
+namespace trading {
+
+struct MarketMakerConfig {
+    Price half_spread = 2;         // ticks either side of fair value
+    Quantity quote_size = 10;
+    double skew_per_lot = 0.05;    // ticks the quotes lean against each lot of inventory
+    Price tick_size = DEFAULT_TICK_SIZE;
+};
+
+// Sample strategy: quotes one bid and one ask around the size-weighted mid
+// (microprice), leaning the quotes against inventory.
+//
+// It listens to BBO changes only to requote, and to executes to simulate its
+// own fills: an execute at or through a quote is taken to have traded
+// against it first. Quotes are not sent anywhere; every new quote goes
+// through a RiskGate as it would on the way to the exchange, and replaced or
+// filled quotes release their exposure.
+class MarketMaker : public Strategy<MarketMaker> {
+public:
+    MarketMaker(const OrderBook& book, const MarketMakerConfig& config = {}, const RiskLimits& limits = {})
+        : book_(book), config_(config), gate_(limits) {}
+
+    void on_bbo(const BBOUpdateMsg& bbo) {
+        if (bbo.bidSize == 0 || bbo.askSize == 0) return; // no two-sided market to price from
+
+        double fair = (double(bbo.bestBid) * bbo.askSize + double(bbo.bestAsk) * bbo.bidSize) /
+                      double(bbo.bidSize + bbo.askSize);
+        double skewed = fair - config_.skew_per_lot * config_.tick_size * inventory_;
+        double half = double(config_.half_spread * config_.tick_size);
+        Price tick = config_.tick_size;
+        requote(Side::Bid, static_cast<Price>(std::floor((skewed - half) / tick)) * tick);
+        requote(Side::Ask, static_cast<Price>(std::ceil((skewed + half) / tick)) * tick);
+        mid_ = (bbo.bestBid + bbo.bestAsk) / 2;
+    }
+
+    void on_execute(const ExecuteMsg& execute) {
+        Quote& bid = quote(Side::Bid);
+        Quote& ask = quote(Side::Ask);
+        if (bid.quantity > 0 && execute.price <= bid.price) fill(Side::Bid, execute.qty);
+        else if (ask.quantity > 0 && execute.price >= ask.price) fill(Side::Ask, execute.qty);
+    }
+
+    Quantity inventory() const { return inventory_; }
+    // cash plus inventory marked at the last mid
+    double pnl() const { return cash_ + double(inventory_) * double(mid_); }
+    uint64_t quotes() const { return quotes_; }
+    uint64_t fills() const { return fills_; }
+    const RiskGate& gate() const { return gate_; }
+
+private:
+    struct Quote {
+        Price price = 0;
+        Quantity quantity = 0; // 0: no live quote
+    };
+
+    const OrderBook& book_;
+    MarketMakerConfig config_;
+    RiskGate gate_;
+    std::array<Quote, 2> quotes_by_side_{};
+    OrderId next_id_ = 1;
+
+    Quantity inventory_ = 0;
+    double cash_ = 0.0;
+    Price mid_ = 0;
+    uint64_t quotes_ = 0;
+    uint64_t fills_ = 0;
+
+    Quote& quote(Side side) { return quotes_by_side_[static_cast<int>(side)]; }
+
+    void requote(Side side, Price price) {
+        Quote& q = quote(side);
+        if (q.quantity > 0 && q.price == price) return;
+
+        if (q.quantity > 0) gate_.on_cancel(side, q.price, q.quantity);
+        q.quantity = 0;
+        if (gate_.check({next_id_++, side, price, config_.quote_size}, book_) == RiskReject::None) {
+            q = {price, config_.quote_size};
+            ++quotes_;
+        }
+    }
+
+    void fill(Side side, Quantity quantity) {
+        Quote& q = quote(side);
+        Quantity filled = std::min(quantity, q.quantity);
+        gate_.on_fill(side, q.price, filled);
+        q.quantity -= filled;
+        inventory_ += side == Side::Bid ? filled : -filled;
+        cash_ += double(side == Side::Bid ? -filled : filled) * double(q.price);
+        ++fills_;
+    }
+};
+
+} // namespace trading
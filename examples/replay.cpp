@@ -0,0 +1,189 @@
+#include "../include/core/order_book.hpp"
+#include "../include/core/market_data_handler.hpp"
+#include "../include/core/feed_capture.hpp"
+#include "../include/core/sequenced_decoder.hpp"
+#include "../include/utils/generator.hpp"
+#include "../include/utils/cpu.hpp"
+#include <iostream>
+#include <iomanip>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <string>
+
+using namespace trading;
+
+// Book thread: applies every queued message until told to stop, then drains
+static void consume(MarketDataHandler::Queue& queue, OrderBook& book,
+                    std::atomic<bool>& stop, std::atomic<uint64_t>& processed) {
+    pin_current_thread(1);
+    telemetry::set_thread_name("book");
+    uint64_t count = 0;
+    while (!stop.load(std::memory_order_relaxed)) {
+        MarketMessage* msg = queue.consume();
+        if (!msg) {
+            cpu_relax();
+            continue;
+        }
+        telemetry::on_dequeue(*msg, queue);
+        apply_message(book, *msg);
+        telemetry::on_applied(*msg);
+        queue.release(msg);
+        processed.store(++count, std::memory_order_relaxed);
+    }
+    while (MarketMessage* msg = queue.consume()) {
+        telemetry::on_dequeue(*msg, queue);
+        apply_message(book, *msg);
+        telemetry::on_applied(*msg);
+        queue.release(msg);
+        processed.store(++count, std::memory_order_relaxed);
+    }
+}
+
+// Records the live generator feed for a number of seconds
+static int record(const std::string& path, int seconds) {
+    CaptureWriter writer(path);
+    if (!writer.is_open()) {
+        std::cerr << "Cannot open " << path << " for writing\n";
+        return 1;
+    }
+
+    MarketDataHandler::Queue queue;
+    MarketDataHandler handler(queue);
+    handler.set_recorder(&writer);
+    OrderBook book;
+
+    std::atomic<bool> stop{false};
+    std::atomic<uint64_t> processed{0};
+    std::thread consumer(consume, std::ref(queue), std::ref(book), std::ref(stop), std::ref(processed));
+
+    FeedGenerator generator(handler);
+    generator.start();
+    std::this_thread::sleep_for(std::chrono::seconds(seconds));
+    generator.stop();
+
+    stop.store(true);
+    consumer.join();
+    writer.flush();
+
+    std::cout << "Recorded " << writer.frames() << " frames to " << path << "\n";
+    return 0;
+}
+
+// Drives push_raw_message/push_raw_packet from a mapped capture, either as fast
+// as the queue accepts or at the recorded pacing scaled by speed
+static int play(const std::string& path, bool paced, double speed) {
+    CaptureReader reader(path);
+    if (!reader.is_open()) {
+        std::cerr << "Cannot map capture " << path << "\n";
+        return 1;
+    }
+
+    MarketDataHandler::Queue queue;
+    MarketDataHandler handler(queue);
+    SequencedDecoder decoder;
+    OrderBook book;
+
+    std::atomic<bool> stop{false};
+    std::atomic<uint64_t> processed{0};
+    std::thread consumer(consume, std::ref(queue), std::ref(book), std::ref(stop), std::ref(processed));
+    pin_current_thread(0);
+
+    uint64_t frames = 0;
+    uint64_t messages = 0;
+    uint64_t rejected = 0;
+    uint64_t last_ts = 0;
+    uint64_t recorded_ns = 0;
+
+    CaptureFrame frame;
+    auto start = std::chrono::steady_clock::now();
+    while (reader.next(frame)) {
+        // recorded time is summed frame to frame: captures are stamped from
+        // the wall clock, and a step backwards counts as no time rather than
+        // underflowing into a wait of centuries
+        if (frames++ > 0 && frame.timestamp_ns > last_ts) recorded_ns += frame.timestamp_ns - last_ts;
+        last_ts = frame.timestamp_ns;
+
+        if (paced) {
+            auto due = start + std::chrono::nanoseconds(static_cast<int64_t>(recorded_ns / speed));
+            while (std::chrono::steady_clock::now() < due) cpu_relax();
+        }
+
+        if (frame.kind == CaptureKind::Packet) {
+            size_t offset = 0;
+            while (offset < frame.size) {
+                // resume after whatever did not fit
+                size_t accepted = handler.push_raw_packet(frame.data + offset, frame.size - offset);
+                if (accepted == 0 && !handler.queue_full()) break; // malformed tail
+                for (size_t i = 0; i < accepted; ++i) {
+                    auto type = static_cast<MessageType>(frame.data[offset]);
+                    offset += MESSAGE_HEADER_SIZE + payload_size(type);
+                }
+                messages += accepted;
+                if (accepted == 0) cpu_relax();
+            }
+            continue;
+        }
+
+        if (frame.kind == CaptureKind::Sequenced) {
+            size_t offset = 0;
+            while (offset < frame.size) {
+                uint64_t before = decoder.messages();
+                size_t consumed = handler.push_sequenced(decoder, frame.data + offset, frame.size - offset);
+                messages += decoder.messages() - before;
+                offset += consumed;
+                if (consumed == 0 && !handler.queue_full()) break; // malformed tail
+                if (consumed == 0) cpu_relax();
+            }
+            continue;
+        }
+
+        // retry while the queue is full; any other failure means the
+        // recorded message was malformed
+        bool accepted;
+        while (!(accepted = handler.push_raw_message(frame.data, frame.size)) && handler.queue_full())
+            cpu_relax();
+        if (accepted) ++messages;
+        else ++rejected;
+    }
+
+    while (processed.load(std::memory_order_relaxed) < messages) cpu_relax();
+    auto end = std::chrono::steady_clock::now();
+    stop.store(true);
+    consumer.join();
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    std::cout << "Replayed " << frames << " frames (" << messages << " messages, " << rejected
+              << " rejected) in " << std::fixed << std::setprecision(3) << seconds << " s";
+    if (!paced) std::cout << ", " << std::setprecision(0) << messages / seconds << " msgs/sec";
+    std::cout << "\n";
+    if (decoder.messages() > 0)
+        std::cout << "Sequenced: " << decoder.gaps() << " gaps, " << decoder.duplicates()
+                  << " duplicates\n";
+
+    auto bid = book.get_best_bid();
+    auto ask = book.get_best_ask();
+    std::cout << "Final book: bid " << (bid ? std::to_string(*bid) : "-")
+              << " / ask " << (ask ? std::to_string(*ask) : "-") << "\n";
+    if constexpr (telemetry::ENABLED) telemetry::snapshot().print(std::cout);
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    std::string mode = argc > 1 ? argv[1] : "";
+
+    if (mode == "record" && argc > 2)
+        return record(argv[2], argc > 3 ? std::atoi(argv[3]) : 10);
+
+    if (mode == "play" && argc > 2) {
+        bool paced = argc > 3 && std::string(argv[3]) == "paced";
+        double speed = argc > 4 ? std::atof(argv[4]) : 1.0;
+        return play(argv[2], paced, speed > 0 ? speed : 1.0);
+    }
+
+    std::cerr << "Usage:\n"
+              << "  " << argv[0] << " record <capture> [seconds]\n"
+              << "  " << argv[0] << " play <capture> [paced [speed]]\n";
+    return 1;
+}
@@ -1,86 +1,63 @@
 #include "../include/core/order_book.hpp"
 #include "../include/utils/generator.hpp"
 #include "../include/core/market_data_handler.hpp"
-#include "../include/utils/lock_free_queue.hpp"
-#include "../include/utils/logger.hpp"
+#include "../include/utils/async_logger.hpp"
+#include "../include/utils/event_loop.hpp"
 #include <iostream>
 #include <thread>
 #include <atomic>
 #include <chrono>
+#include <string>
 
 using namespace trading;
 
-int main() {
-    Logger logger(5000);
+template <typename Wait>
+int simulate(Wait wait, Wakeup* wakeup) {
+    // formatting and output happen on the logger's own thread
+    AsyncLogger logger(stdout);
 
     MarketDataHandler::Queue queue;
     MarketDataHandler handler(queue);
+    handler.set_wakeup(wakeup);
 
     OrderBook book;
 
-    std::atomic<bool> stop{false};
-    std::atomic<uint64_t> ordersProcessed{0};
     std::atomic<uint64_t> ordersExecuted{0};
     std::atomic<uint64_t> ordersCancelled{0};
 
-    // Consumer thread: pop messages and apply to order book
-    std::thread consumer([&]() {
-        while (!stop.load()) {
-            MarketMessage* msg = queue.pop();
-            if (!msg) {
-                std::this_thread::sleep_for(std::chrono::microseconds(50));
-                continue;
-            }
-
-            ++ordersProcessed;
-
-            switch (msg->type) {
-                case MessageType::AddOrder: {
-                    Order o;
-                    o.id = msg->add.orderId;
-                    o.side = msg->add.side;
-                    o.price = msg->add.price;
-                    o.quantity = msg->add.qty;
-                    book.add_order(o);
-                    logger.log("AddOrder: id=" + std::to_string(o.id) +
-                            ", side=" + (o.side == Side::Bid ? "Bid" : "Ask") +
-                            ", price=" + std::to_string(o.price) +
-                            ", qty=" + std::to_string(o.quantity));
-                    break;
-                }
-                case MessageType::CancelOrder:
-                    book.cancel_order(msg->cancel.orderId);
-                    logger.log("CancelOrder: id=" + std::to_string(msg->cancel.orderId));
-                    ordersCancelled++;
-                    break;
-                case MessageType::ModifyOrder:
-                    book.modify_order(msg->modify.orderId, msg->modify.newQty);
-                    logger.log("ModifyOrder: id=" + std::to_string(msg->modify.orderId) +
-                            ", newQty=" + std::to_string(msg->modify.newQty));
-                    break;
-                case MessageType::Execute:
-                    book.execute_order(msg->execute.orderId, msg->execute.qty);
-                    ordersExecuted++;
-                    logger.log("ExecuteOrder: id=" + std::to_string(msg->execute.orderId) +
-                            ", qty=" + std::to_string(msg->execute.qty));
-                    break;
-                case MessageType::Trade:
-                case MessageType::BBOUpdate:
-                    break;
-            }
-
-            if (ordersProcessed % 50 == 0) {
-                logger.print();
-            }
-
-            handler.release_message(msg);
+    // Book thread: applies messages in place as soon as they are published
+    EventLoop<MarketDataHandler::Queue, Wait> loop(queue, std::move(wait));
+    loop.start([&](MarketMessage& msg) {
+        telemetry::on_dequeue(msg, queue);
+
+        switch (msg.type) {
+            case MessageType::AddOrder:
+                book.add_order({msg.add.orderId, msg.add.side, msg.add.price, msg.add.qty});
+                logger.log("AddOrder: id={}, side={}, price={}, qty={}", msg.add.orderId,
+                           msg.add.side == Side::Bid ? "Bid" : "Ask", msg.add.price, msg.add.qty);
+                break;
+            case MessageType::CancelOrder:
+                book.cancel_order(msg.cancel.orderId);
+                logger.log("CancelOrder: id={}", msg.cancel.orderId);
+                ordersCancelled++;
+                break;
+            case MessageType::ModifyOrder:
+                book.modify_order(msg.modify.orderId, msg.modify.newQty);
+                logger.log("ModifyOrder: id={}, newQty={}", msg.modify.orderId, msg.modify.newQty);
+                break;
+            case MessageType::Execute:
+                book.execute_order(msg.execute.orderId, msg.execute.qty);
+                ordersExecuted++;
+                logger.log("ExecuteOrder: id={}, qty={}", msg.execute.orderId, msg.execute.qty);
+                break;
+            case MessageType::Trade:
+            case MessageType::BBOUpdate:
+            case MessageType::LevelUpdate:
+                break;
         }
 
-        // Drain remaining messages
-        while (MarketMessage* msg = queue.pop()) {
-            handler.release_message(msg);
-        }
-    });
+        telemetry::on_applied(msg);
+    }, 1);
 
     // Start feed generator
     FeedGenerator generator(handler);
@@ -91,12 +68,31 @@ int main() {
     // Keep main thread alive until user interrupts
     while (true) {
         std::this_thread::sleep_for(std::chrono::seconds(1));
+        auto stats = loop.stats();
+        std::cout << "Book thread: " << stats.messages << " msgs, "
+                  << static_cast<int>(stats.utilisation() * 100) << "% busy\n";
+        if constexpr (telemetry::ENABLED) telemetry::snapshot().print(std::cout);
     }
 
     // Cleanup (will not reach unless you implement a signal handler)
-    stop.store(true);
     generator.stop();
-    consumer.join();
+    loop.stop();
 
     return 0;
 }
+
+int main(int argc, char** argv) {
+    // spin: lowest latency, burns the book core; yield: spin, then yield
+    // between polls; block: spin, then sleep until the feed publishes
+    std::string wait = argc > 1 ? argv[1] : "spin";
+
+    if (wait == "spin") return simulate(BusySpinWait{}, nullptr);
+    if (wait == "yield") return simulate(SpinYieldWait{}, nullptr);
+    if (wait == "block") {
+        Wakeup wakeup;
+        return simulate(BlockingWait(wakeup), &wakeup);
+    }
+
+    std::cerr << "Usage: " << argv[0] << " [spin|yield|block]\n";
+    return 1;
+}
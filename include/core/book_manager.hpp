@@ -0,0 +1,73 @@
+#pragma once
+#include "../core/order_book.hpp"
+#include "../core/market_data_handler.hpp"
+#include "../utils/flat_hash_map.hpp"
+#include <vector>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <cstdint>
+
+namespace trading {
+
+// Routes messages by instrument to shards, each with its own queue and one
+// consumer thread pinned to a core. A shard owns the books of its
+// instruments outright: nothing on the hot path is shared between cores.
+class BookManager {
+public:
+    explicit BookManager(size_t num_shards, const BookConfig& book_config = {},
+                         int first_core = 0);
+    ~BookManager();
+
+    BookManager(const BookManager&) = delete;
+    BookManager& operator=(const BookManager&) = delete;
+
+    // Registers an instrument; must be called before start()
+    void add_instrument(InstrumentId id);
+
+    void start();
+    void stop(); // drains queued messages before returning
+
+    // Feed thread: routes one wire message to its shard.
+    // Returns false if malformed or the shard queue is full.
+    bool push_raw_message(const uint8_t* buffer, size_t size);
+
+    size_t num_shards() const { return shards_.size(); }
+    size_t shard_of(InstrumentId id) const { return id % shards_.size(); }
+
+    // Messages applied so far, summed across shards
+    uint64_t processed() const;
+
+    // Messages for instruments that were never registered
+    uint64_t unknown() const;
+
+    // Only safe to call while stopped
+    const OrderBook* book(InstrumentId id) const;
+
+private:
+    struct alignas(64) Shard {
+        Shard() : handler(queue) {}
+
+        MarketDataHandler::Queue queue;
+        MarketDataHandler handler;
+
+        // owned by the shard thread once running
+        std::vector<InstrumentId> instruments;
+        FlatHashMap<InstrumentId, uint32_t> index;
+        std::vector<std::unique_ptr<OrderBook>> books;
+        std::thread thread;
+
+        // written by the shard thread only
+        alignas(64) std::atomic<uint64_t> processed{0};
+        std::atomic<uint64_t> unknown{0};
+    };
+
+    BookConfig book_config_;
+    int first_core_;
+    std::vector<std::unique_ptr<Shard>> shards_;
+    std::atomic<bool> running_{false};
+
+    void run(Shard& shard, int core);
+};
+
+} // namespace trading
@@ -0,0 +1,135 @@
+#pragma once
+#include "../utils/config.hpp"
+#include "../utils/bitmap.hpp"
+#include "../utils/level_kernels.hpp"
+#include "../core/price_ladder.hpp"
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <vector>
+
+namespace trading {
+
+// Price traits: the tick grid and price band of an instrument class.
+//
+// RuntimeTicks takes the tick size from BookConfig and accepts any price.
+// TickTraits fixes both at compile time, so tick arithmetic folds into
+// shifts and multiplies and prices outside the band are dropped on entry.
+struct RuntimeTicks {
+    static constexpr Price TICK_SIZE = 0; // from BookConfig
+    static constexpr bool BOUNDED = false;
+    static constexpr bool contains(Price) { return true; }
+};
+
+template <Price Tick, Price Min, Price Max>
+struct TickTraits {
+    static_assert(Tick > 0, "tick size must be positive");
+    static_assert(Min > 0 && Min <= Max, "bad price band");
+    static_assert(Min % Tick == 0 && Max % Tick == 0, "band must lie on the tick grid");
+
+    static constexpr Price TICK_SIZE = Tick;
+    static constexpr Price MIN_PRICE = Min;
+    static constexpr Price MAX_PRICE = Max;
+    static constexpr size_t LEVELS = static_cast<size_t>((Max - Min) / Tick) + 1;
+    static constexpr bool BOUNDED = true;
+
+    static constexpr bool contains(Price price) { return price >= Min && price <= Max && price % Tick == 0; }
+};
+
+// Ladder policy for a TickTraits band: one slot per tick of the whole band,
+// so there is no window to slide and no overflow store, and every index is
+// a constexpr-tick division. Same interface as PriceLadder (normalized
+// prices, best = lowest); a bid ladder covers -MAX..-MIN.
+template <typename Traits>
+class FixedLadder {
+public:
+    static constexpr bool SLIDING = false;
+    static constexpr Price TICK = Traits::TICK_SIZE;
+    static constexpr size_t LEVELS = Traits::LEVELS;
+    static_assert(LEVELS <= HierarchicalBitmap::MAX_BITS, "band too wide for the occupancy bitmap");
+
+    using Sweep = PriceLadder::Sweep;
+
+    explicit FixedLadder(bool negated = false)
+        : low_(negated ? -Traits::MAX_PRICE : Traits::MIN_PRICE), levels_(LEVELS, 0), occupied_(LEVELS) {}
+
+    Quantity add(Price norm_price, Quantity delta) {
+        size_t i = index(norm_price);
+        assert(i < LEVELS && norm_price % TICK == 0);
+        Quantity& level = levels_[i];
+        bool was_empty = level == 0;
+        level += delta;
+        if (level == 0) occupied_.clear(i);
+        else if (was_empty) occupied_.set(i);
+        return level;
+    }
+
+    Quantity quantity(Price norm_price) const {
+        size_t i = index(norm_price);
+        return i < LEVELS ? levels_[i] : 0;
+    }
+
+    std::optional<Price> best() const {
+        size_t i = occupied_.find_next(0);
+        if (i == HierarchicalBitmap::npos) return std::nullopt;
+        return price_at(i);
+    }
+
+    size_t depth(size_t n, Price* norm_prices, Quantity* quantities) const {
+        size_t count = 0;
+        for (size_t i = occupied_.find_next(0); i != HierarchicalBitmap::npos && count < n;
+             i = occupied_.find_next(i + 1), ++count) {
+            norm_prices[count] = price_at(i);
+            quantities[count] = levels_[i];
+        }
+        return count;
+    }
+
+    Quantity depth_to(Price norm_limit) const {
+        size_t first = occupied_.find_next(0);
+        if (first == HierarchicalBitmap::npos || norm_limit < low_) return 0;
+        size_t last = std::min(static_cast<size_t>((norm_limit - low_) / TICK), LEVELS - 1);
+        return last < first ? 0 : kernels::sum(levels_.data() + first, last - first + 1);
+    }
+
+    Sweep sweep(Quantity quantity) const {
+        Sweep out;
+        size_t first = occupied_.find_next(0);
+        if (quantity <= 0 || first == HierarchicalBitmap::npos) return out;
+
+        // the band is one flat array: whole levels in bulk from the best
+        size_t n = LEVELS - first;
+        int64_t first_tick = low_ / TICK + static_cast<int64_t>(first);
+        int64_t weighted = 0;
+        size_t whole = kernels::take_below(levels_.data() + first, n, quantity, out.filled, weighted);
+        out.notional_ticks = first_tick * out.filled + weighted;
+
+        if (whole < n) {
+            Quantity taken = std::min(levels_[first + whole], quantity - out.filled);
+            out.filled += taken;
+            out.notional_ticks += taken * (first_tick + static_cast<int64_t>(whole));
+            out.last = price_at(first + whole);
+        } else {
+            // the side ran out: the last level is the worst occupied one
+            for (size_t i = first; i != HierarchicalBitmap::npos; i = occupied_.find_next(i + 1))
+                out.last = price_at(i);
+        }
+        return out;
+    }
+
+    Price tick_size() const { return TICK; }
+    size_t width() const { return LEVELS; }
+    size_t overflow_levels() const { return 0; }
+
+private:
+    Price low_; // normalized price of slot 0
+    std::vector<Quantity> levels_;
+    HierarchicalBitmap occupied_;
+
+    // Out of band (either side) maps past the end
+    size_t index(Price norm_price) const { return static_cast<uint64_t>(norm_price - low_) / TICK; }
+    Price price_at(size_t i) const { return low_ + static_cast<Price>(i) * TICK; }
+};
+
+} // namespace trading
@@ -0,0 +1,288 @@
+#pragma once
+#include "../core/order_book.hpp"
+#include "../core/market_data_handler.hpp"
+#include "../utils/event_loop.hpp"
+#include "../utils/slot_queue.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace trading {
+
+/*/
+Snapshot file layout (little-endian, every record 8-byte aligned so the
+arrays can be read in place from a mapping):
+
++--------------------+------------------+------------------+------------------+
+| SnapshotFileHeader | SnapshotLevel x  | SnapshotLevel x  | SnapshotOrder x  |
+|                    | bid levels       | ask levels       | orders           |
++--------------------+------------------+------------------+------------------+
+
+Levels are best first. The file is written under a temporary name and
+renamed into place, so a reader only ever sees a complete snapshot.
+/*/
+struct SnapshotFileHeader {
+    uint64_t magic;
+    uint32_t version;
+    uint32_t reserved;
+    uint64_t sequence;        // last message applied to the book
+    int64_t tick_size;
+    uint64_t level_counts[2]; // by Side
+    uint64_t order_count;
+    int64_t centers[2];       // ladder window centres (normalized), by Side
+    int64_t best[2];          // best prices, by Side; valid if the side has levels
+};
+
+struct SnapshotLevel {
+    int64_t price;
+    int64_t quantity;
+};
+
+struct SnapshotOrder {
+    uint64_t id;
+    int64_t price;
+    int64_t quantity;
+    uint32_t side;
+    uint32_t reserved;
+};
+
+constexpr uint64_t SNAPSHOT_MAGIC = 0x3130504e53445254ULL; // "TRDSNP01"
+constexpr uint32_t SNAPSHOT_VERSION = 1;
+
+// Writes a snapshot under a temporary name; commit() syncs it and renames
+// it into place, and an uncommitted file is removed on destruction.
+class SnapshotWriter {
+public:
+    explicit SnapshotWriter(const std::string& path);
+    ~SnapshotWriter();
+
+    SnapshotWriter(const SnapshotWriter&) = delete;
+    SnapshotWriter& operator=(const SnapshotWriter&) = delete;
+
+    // False once any write has failed
+    bool write(const void* data, size_t size);
+    bool commit();
+
+private:
+    std::string path_;
+    std::string tmp_path_;
+    std::FILE* file_ = nullptr;
+    bool ok_ = false;
+};
+
+// Read-only mapping of a whole snapshot file
+class SnapshotMapping {
+public:
+    explicit SnapshotMapping(const std::string& path);
+    ~SnapshotMapping();
+
+    SnapshotMapping(const SnapshotMapping&) = delete;
+    SnapshotMapping& operator=(const SnapshotMapping&) = delete;
+
+    const uint8_t* data() const { return data_; }
+    size_t size() const { return size_; }
+
+private:
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+template <typename Traits, typename Ladder, typename Index>
+bool BasicOrderBook<Traits, Ladder, Index>::save_snapshot(const std::string& path, uint64_t sequence) const {
+    SnapshotFileHeader header{};
+    header.magic = SNAPSHOT_MAGIC;
+    header.version = SNAPSHOT_VERSION;
+    header.sequence = sequence;
+    header.tick_size = tick_size();
+    header.order_count = orders_.size();
+
+    std::vector<SnapshotLevel> levels[2];
+    for (Side side : {Side::Bid, Side::Ask}) {
+        int s = static_cast<int>(side);
+        const Ladder& l = ladder(side);
+        std::vector<Price> prices(l.width() + l.overflow_levels());
+        std::vector<Quantity> quantities(prices.size());
+        size_t n = get_depth(side, prices, quantities);
+
+        levels[s].resize(n);
+        for (size_t i = 0; i < n; ++i) levels[s][i] = {prices[i], quantities[i]};
+        header.level_counts[s] = n;
+        if constexpr (Ladder::SLIDING) header.centers[s] = l.center();
+        header.best[s] = n > 0 ? prices[0] : 0;
+    }
+
+    SnapshotWriter out(path);
+    out.write(&header, sizeof(header));
+    for (const auto& side : levels) out.write(side.data(), side.size() * sizeof(SnapshotLevel));
+
+    std::vector<SnapshotOrder> chunk;
+    chunk.reserve(4096);
+    orders_.for_each([&](OrderHandle, const Order& order) {
+        chunk.push_back({order.id, order.price, order.quantity, static_cast<uint32_t>(order.side), 0});
+        if (chunk.size() == chunk.capacity()) {
+            out.write(chunk.data(), chunk.size() * sizeof(SnapshotOrder));
+            chunk.clear();
+        }
+    });
+    out.write(chunk.data(), chunk.size() * sizeof(SnapshotOrder));
+    return out.commit();
+}
+
+template <typename Traits, typename Ladder, typename Index>
+std::optional<uint64_t> BasicOrderBook<Traits, Ladder, Index>::load_snapshot(const std::string& path) {
+    SnapshotMapping file(path);
+    if (!file.data() || file.size() < sizeof(SnapshotFileHeader)) return std::nullopt;
+
+    SnapshotFileHeader header;
+    std::memcpy(&header, file.data(), sizeof(header));
+    Price tick = tick_size();
+    if (header.magic != SNAPSHOT_MAGIC || header.version != SNAPSHOT_VERSION || header.tick_size != tick)
+        return std::nullopt;
+
+    // counts bounded by the file size first, so the sum cannot overflow
+    size_t body = file.size() - sizeof(header);
+    uint64_t levels = header.level_counts[0] + header.level_counts[1];
+    if (header.level_counts[0] > body / sizeof(SnapshotLevel) || header.level_counts[1] > body / sizeof(SnapshotLevel) ||
+        header.order_count > body / sizeof(SnapshotOrder) ||
+        levels * sizeof(SnapshotLevel) + header.order_count * sizeof(SnapshotOrder) != body)
+        return std::nullopt;
+
+    const uint8_t* cursor = file.data() + sizeof(header);
+
+    // levels into fresh ladders laid out as the saved ones were
+    std::array<Ladder, 2> ladders{make_ladder(Side::Bid, tick, ladder(Side::Bid).width()),
+                                  make_ladder(Side::Ask, tick, ladder(Side::Ask).width())};
+    for (Side side : {Side::Bid, Side::Ask}) {
+        int s = static_cast<int>(side);
+        if constexpr (Ladder::SLIDING)
+            if (header.level_counts[s] > 0) ladders[s].recenter(header.centers[s]);
+
+        Price previous = 0;
+        for (uint64_t i = 0; i < header.level_counts[s]; ++i, cursor += sizeof(SnapshotLevel)) {
+            SnapshotLevel level;
+            std::memcpy(&level, cursor, sizeof(level));
+            Price norm_price = normalize(side, level.price);
+            if (level.price % tick != 0 || level.quantity <= 0 || !Traits::contains(level.price) ||
+                (i > 0 && norm_price <= previous))
+                return std::nullopt;
+            if (i == 0 && level.price != header.best[s]) return std::nullopt;
+
+            ladders[s].add(norm_price, level.quantity);
+            previous = norm_price;
+        }
+    }
+
+    // orders into a fresh store, each taken off what is left of its level:
+    // every level must be used up exactly before anything is replaced
+    std::array<Ladder, 2> unfilled = ladders;
+    Index store(std::max<size_t>(header.order_count, configured_capacity_)); // keep the pre-sizing
+    for (uint64_t i = 0; i < header.order_count; ++i, cursor += sizeof(SnapshotOrder)) {
+        SnapshotOrder order;
+        std::memcpy(&order, cursor, sizeof(order));
+        if (order.side > 1 || order.quantity <= 0 || order.price % tick != 0 || !Traits::contains(order.price))
+            return std::nullopt;
+        Side side = static_cast<Side>(order.side);
+        Price norm_price = normalize(side, order.price);
+        if (unfilled[order.side].quantity(norm_price) < order.quantity) return std::nullopt;
+        if (!store.insert({order.id, side, order.price, order.quantity}).valid()) return std::nullopt; // duplicate id
+        unfilled[order.side].add(norm_price, -order.quantity);
+    }
+    if (unfilled[0].best() || unfilled[1].best()) return std::nullopt;
+
+    std::swap(ladders_, ladders);
+    std::swap(orders_, store);
+    best_bid_ = ladder(Side::Bid).best();
+    best_ask_ = ladder(Side::Ask).best();
+    changed_.clear();
+    return header.sequence;
+}
+
+// Keeps snapshots of a book current without stopping the book thread.
+//
+// The book thread forwards each message it applies into a ring; a background
+// thread applies them to a replica of the book and writes the replica out
+// when it reaches a checkpoint marker. The book thread pays one ring slot per
+// message and never waits: if the ring is full the replica can no longer
+// follow, so it stops checkpointing (diverged()) and the last snapshot stays
+// valid.
+class BookCheckpointer {
+public:
+    static constexpr size_t QUEUE_CAPACITY = 1 << 16;
+
+    // The replica starts from the snapshot at path if there is one, so it
+    // matches a book restored from the same file (see start_sequence())
+    explicit BookCheckpointer(std::string path, const BookConfig& config = {});
+    ~BookCheckpointer(); // writes pending checkpoints, then stops
+
+    BookCheckpointer(const BookCheckpointer&) = delete;
+    BookCheckpointer& operator=(const BookCheckpointer&) = delete;
+
+    // Book thread, after applying msg numbered sequence
+    bool forward(const MarketMessage& msg, uint64_t sequence) {
+        Entry* entry = lost_ ? nullptr : queue_->claim();
+        if (!entry) [[unlikely]] return overflow();
+        entry->msg = msg;
+        entry->sequence = sequence;
+        entry->checkpoint = false;
+        queue_->commit(entry);
+        // the background thread sleeps while idle; wake it well before the
+        // ring fills rather than paying a fence on every message
+        if ((++forwarded_ & (NOTIFY_EVERY - 1)) == 0) wakeup_.notify();
+        return true;
+    }
+
+    // Book thread: snapshot the book as of the last forwarded message
+    bool checkpoint();
+
+    // Sequence number of the snapshot the replica started from, 0 if none
+    uint64_t start_sequence() const { return start_sequence_; }
+
+    // Any thread
+    uint64_t checkpoints() const { return checkpoints_.load(std::memory_order_acquire); }
+    uint64_t checkpoint_sequence() const { return checkpoint_sequence_.load(std::memory_order_acquire); }
+    uint64_t failures() const { return failures_.load(std::memory_order_relaxed); }
+    bool diverged() const { return diverged_.load(std::memory_order_relaxed); }
+
+private:
+    struct Entry {
+        MarketMessage msg;
+        uint64_t sequence;
+        bool checkpoint;
+    };
+    using Queue = SlotQueue<Entry, QUEUE_CAPACITY>;
+
+    static constexpr uint64_t NOTIFY_EVERY = 1024;
+
+    std::string path_;
+    OrderBook replica_; // background thread only
+    std::unique_ptr<Queue> queue_;
+    Wakeup wakeup_;
+    EventLoop<Queue, BlockingWait> loop_;
+
+    uint64_t forwarded_ = 0; // book thread only
+    bool lost_ = false;      // book thread only
+    uint64_t start_sequence_ = 0;
+    uint64_t applied_sequence_ = 0; // background thread only
+
+    std::atomic<uint64_t> checkpoints_{0};
+    std::atomic<uint64_t> checkpoint_sequence_{0};
+    std::atomic<uint64_t> failures_{0};
+    std::atomic<bool> diverged_{false};
+
+    bool overflow() {
+        lost_ = true;
+        diverged_.store(true, std::memory_order_relaxed);
+        return false;
+    }
+
+    void handle(const Entry& entry);
+};
+
+} // namespace trading
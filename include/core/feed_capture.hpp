@@ -0,0 +1,103 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace trading {
+
+/*/
+Capture file layout (little-endian, no padding):
+
++----------------------+----------------------------------------+
+| CaptureFileHeader    | frame | frame | ...                    |
++----------------------+----------------------------------------+
+
+frame:
++----------------+----------+--------------+----------------------+
+| 4 bytes size   | 2 bytes  | 2 bytes      | 8 bytes ingest time  | size bytes
+| of wire bytes  | kind     | reserved (0) | (ns since epoch)     | as received
++----------------+----------+--------------+----------------------+
+/*/
+struct CaptureFileHeader {
+    uint64_t magic;
+    uint32_t version;
+    uint32_t reserved;
+};
+
+constexpr uint64_t CAPTURE_MAGIC = 0x3130504143445254ULL; // "TRDCAP01"
+constexpr uint32_t CAPTURE_VERSION = 1;
+constexpr size_t CAPTURE_FRAME_HEADER_SIZE = 16;
+
+// What the recorded bytes were handed to
+enum class CaptureKind : uint16_t {
+    Message,  // push_raw_message
+    Packet,   // push_raw_packet
+    Sequenced // push_sequenced
+};
+
+// A frame read from a capture; data points into the mapped file
+struct CaptureFrame {
+    uint64_t timestamp_ns;
+    CaptureKind kind;
+    const uint8_t* data;
+    uint32_t size;
+};
+
+// Appends frames to a capture file through a large in-memory buffer, so
+// recording costs a memcpy per message and a write per buffer.
+class CaptureWriter {
+public:
+    explicit CaptureWriter(const std::string& path, size_t buffer_size = 1 << 20);
+    ~CaptureWriter();
+
+    CaptureWriter(const CaptureWriter&) = delete;
+    CaptureWriter& operator=(const CaptureWriter&) = delete;
+
+    bool is_open() const { return file_ != nullptr; }
+
+    // Returns false if the file is not open or a write failed
+    bool write(const uint8_t* data, size_t size, uint64_t timestamp_ns,
+               CaptureKind kind = CaptureKind::Message);
+
+    bool flush();
+
+    uint64_t frames() const { return frames_; }
+
+private:
+    std::FILE* file_ = nullptr;
+    std::vector<uint8_t> buffer_;
+    size_t used_ = 0;
+    uint64_t frames_ = 0;
+};
+
+// Read-only memory mapping of a capture; frames are returned in place.
+class CaptureReader {
+public:
+    explicit CaptureReader(const std::string& path);
+    ~CaptureReader();
+
+    CaptureReader(const CaptureReader&) = delete;
+    CaptureReader& operator=(const CaptureReader&) = delete;
+
+    // False if the file could not be mapped or has a bad header
+    bool is_open() const { return data_ != nullptr; }
+
+    // Next frame; false at the end or at a truncated trailing frame
+    bool next(CaptureFrame& out);
+
+    void rewind() { offset_ = sizeof(CaptureFileHeader); }
+
+    size_t size_bytes() const { return size_; }
+
+private:
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+    size_t offset_ = 0;
+};
+
+// Wall-clock ingest timestamp used for recording
+uint64_t capture_timestamp_ns();
+
+} // namespace trading
@@ -1,7 +1,10 @@
 #pragma once
-#include "../utils/memory_pool.hpp"
-#include "../utils/lock_free_queue.hpp"
+#include "../utils/slot_queue.hpp"
+#include "../utils/sequenced_queue.hpp"
+#include "../utils/telemetry.hpp"
 #include "../core/order_book.hpp"
+#include "../core/feed_capture.hpp"
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <cstring>
@@ -10,13 +13,16 @@
 
 namespace trading {
 
+using InstrumentId = uint32_t;
+
 enum class MessageType : uint8_t {
     AddOrder,
     CancelOrder,
     ModifyOrder,
     Execute,
     Trade,
-    BBOUpdate
+    BBOUpdate,
+    LevelUpdate
 };
 
 struct AddOrderMsg { OrderId orderId; Side side; Price price; Quantity qty; };
@@ -25,9 +31,11 @@ struct ModifyOrderMsg { OrderId orderId; Quantity newQty; };
 struct ExecuteMsg { OrderId orderId; Quantity qty; Price price; };
 struct TradeMsg { uint64_t buyOrderId; uint64_t sellOrderId; Quantity qty; Price price; };
 struct BBOUpdateMsg { Price bestBid; Price bestAsk; Quantity bidSize; Quantity askSize; };
+struct LevelUpdateMsg { Side side; Price price; Quantity qty; }; // qty 0: level removed
 
 struct MarketMessage {
     MessageType type;
+    InstrumentId instrument;
     union {
         AddOrderMsg add;
         CancelOrderMsg cancel;
@@ -35,24 +43,104 @@ struct MarketMessage {
         ExecuteMsg execute;
         TradeMsg trade;
         BBOUpdateMsg bbo;
+        LevelUpdateMsg level;
     };
+#ifdef TRADING_TELEMETRY
+    telemetry::MessageStamps stamps; // not on the wire
+#endif
 };
 
 #pragma pack(pop)
 
+// Wire header: message type followed by the instrument id
+constexpr size_t MESSAGE_HEADER_SIZE = sizeof(MessageType) + sizeof(InstrumentId);
+
+// Payload bytes following the header, 0 for unknown types
+size_t payload_size(MessageType type);
+
+// False if the payload (payload_size(type) bytes) carries a side other than
+// Bid or Ask. The book indexes its ladders by side, so decoders drop such a
+// message as malformed.
+inline bool valid_side(MessageType type, const uint8_t* payload) {
+    size_t offset;
+    switch (type) {
+        case MessageType::AddOrder:    offset = offsetof(AddOrderMsg, side); break;
+        case MessageType::LevelUpdate: offset = offsetof(LevelUpdateMsg, side); break;
+        default:                       return true;
+    }
+    std::underlying_type_t<Side> side;
+    std::memcpy(&side, payload + offset, sizeof(side));
+    return side == static_cast<std::underlying_type_t<Side>>(Side::Bid) ||
+           side == static_cast<std::underlying_type_t<Side>>(Side::Ask);
+}
+
+// Encodes msg in wire format into out; returns the bytes written
+size_t encode_message(const MarketMessage& msg, uint8_t* out);
+
+// Applies an order message to a book; other message types are ignored
+void apply_message(OrderBook& book, const MarketMessage& msg);
+
+class SequencedDecoder;
+class Wakeup;
+
+// Decodes wire messages straight into queue slots: the consumer reads them
+// in place via queue.consume() and hands them back with queue.release().
+//
+// The queue is chosen per build: SPSC by default, or MPSC/MPMC (defining
+// TRADING_FEED_QUEUE_MPSC or TRADING_FEED_QUEUE_MPMC) so several handlers,
+// e.g. A/B lines or venues, can share one queue.
 class MarketDataHandler {
 public:
-    using Queue = LockFreeQueue<MarketMessage, 4096>;
+#if defined(TRADING_FEED_QUEUE_MPMC)
+    using Queue = MpmcQueue<MarketMessage, 4096>;
+#elif defined(TRADING_FEED_QUEUE_MPSC)
+    using Queue = MpscQueue<MarketMessage, 4096>;
+#else
+    using Queue = SlotQueue<MarketMessage, 4096>;
+#endif
 
     explicit MarketDataHandler(Queue& queue);
 
-    void push_raw_message(const uint8_t* buffer, size_t size);
+    // Returns false if the message was dropped (unknown type, short payload,
+    // invalid side or queue full)
+    bool push_raw_message(const uint8_t* buffer, size_t size);
+
+    // Decodes back-to-back frames and publishes them with one queue commit
+    // (one per frame on queues without batched commits).
+    // Stops at the first malformed frame; returns the messages accepted.
+    size_t push_raw_packet(const uint8_t* buffer, size_t size);
+
+    // Decodes the sequenced format (see sequenced_decoder.hpp) into queue
+    // slots, with one commit per buffer. Returns the bytes consumed; stops
+    // early when the queue is full, leaving the rest for a retry.
+    size_t push_sequenced(SequencedDecoder& decoder, const uint8_t* buffer, size_t size);
 
-    void release_message(MarketMessage* msg) {pool_.release(msg);}
+    // True if the last push stopped because the queue was full, false if it
+    // finished or stopped at a malformed message. Only a full queue is worth
+    // a retry; unlike the queue's size, this cannot change under the caller
+    // as the consumer frees slots.
+    bool queue_full() const { return queue_full_; }
+
+    // Records the buffers handed to the push functions, as received, with
+    // their ingest time. Each byte is recorded once, when the push is done
+    // with it: what a full queue left behind is recorded by the retry, so a
+    // capture taken under backpressure replays the feed the book received.
+    // nullptr detaches. Not owned.
+    void set_recorder(CaptureWriter* recorder) { recorder_ = recorder; }
+
+    // Notified after every publish, for a consumer that sleeps when idle
+    // (BlockingWait in event_loop.hpp). nullptr detaches. Not owned.
+    void set_wakeup(Wakeup* wakeup) { wakeup_ = wakeup; }
 
 private:
     Queue& queue_;
-    MemoryPool<MarketMessage, 4096> pool_;
+    CaptureWriter* recorder_ = nullptr;
+    Wakeup* wakeup_ = nullptr;
+    bool queue_full_ = false;
+
+    void record(const uint8_t* buffer, size_t size, CaptureKind kind) {
+        if (recorder_ && size > 0) recorder_->write(buffer, size, capture_timestamp_ns(), kind);
+    }
 };
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,120 @@
+#pragma once
+#include "../core/order_book.hpp"
+#include "../core/market_data_handler.hpp"
+#include "../utils/flat_hash_map.hpp"
+#include <vector>
+#include <cstdint>
+
+namespace trading {
+
+// Trade/execute events the engine can buffer before they must be drained
+constexpr size_t DEFAULT_EVENT_CAPACITY = 1 << 12;
+
+// Pre-allocated ring of engine output events, drained by the caller.
+// Events that do not fit are counted and dropped.
+class EventRing {
+public:
+    explicit EventRing(size_t capacity);
+
+    bool push(const MarketMessage& msg) {
+        if (tail_ - head_ == buffer_.size()) {
+            ++dropped_;
+            return false;
+        }
+        buffer_[tail_++ & mask_] = msg;
+        return true;
+    }
+
+    bool pop(MarketMessage& out) {
+        if (head_ == tail_) return false;
+        out = buffer_[head_++ & mask_];
+        return true;
+    }
+
+    size_t size() const { return tail_ - head_; }
+    bool empty() const { return head_ == tail_; }
+    uint64_t dropped() const { return dropped_; }
+
+private:
+    std::vector<MarketMessage> buffer_;
+    size_t mask_;
+    size_t head_ = 0;
+    size_t tail_ = 0;
+    uint64_t dropped_ = 0;
+};
+
+// Price-time priority matching on top of an OrderBook.
+//
+// The book keeps aggregated levels and best prices; the engine adds a FIFO
+// queue per price level, threaded through a pre-allocated slab of order
+// nodes. Aggressive orders sweep the opposite side in price then time order,
+// emitting a TradeMsg and an ExecuteMsg (for the resting order) per fill;
+// any remainder rests in the book.
+class MatchingEngine {
+public:
+    // Trade and execute events are tagged with instrument, so consumers
+    // downstream of several engines can route them
+    explicit MatchingEngine(const BookConfig& config = {},
+                            size_t event_capacity = DEFAULT_EVENT_CAPACITY,
+                            InstrumentId instrument = 0);
+
+    // Matches a limit order and rests the remainder. Returns the filled quantity.
+    Quantity submit(const Order& order);
+
+    bool cancel_order(OrderId id);
+
+    // Reducing keeps time priority; increasing moves the order to the back.
+    // False, with nothing changed, for a negative quantity.
+    bool modify_order(OrderId id, Quantity new_quantity);
+
+    // Applies an externally reported fill to a resting order. False, with
+    // nothing changed, if the quantity is 0 or less.
+    bool execute_order(OrderId id, Quantity exec_quantity);
+
+    bool poll_event(MarketMessage& out) { return events_.pop(out); }
+    const EventRing& events() const { return events_; }
+
+    InstrumentId instrument() const { return instrument_; }
+    const OrderBook& book() const { return book_; }
+    size_t resting_orders() const { return index_.size(); }
+
+private:
+    static constexpr uint32_t NIL = UINT32_MAX;
+
+    struct OrderNode {
+        OrderId id;
+        Side side;
+        Price price;
+        Quantity quantity;
+        uint32_t prev;
+        uint32_t next;
+        OrderHandle handle; // the order's entry in book_, so fills skip its id lookup
+    };
+
+    struct LevelQueue {
+        uint32_t head = NIL;
+        uint32_t tail = NIL;
+    };
+
+    InstrumentId instrument_;
+    OrderBook book_;
+    EventRing events_;
+
+    std::vector<OrderNode> nodes_;
+    uint32_t free_head_ = NIL; // free nodes chained through next
+
+    FlatHashMap<OrderId, uint32_t> index_;
+    std::array<FlatHashMap<Price, LevelQueue>, 2> queues_; // indexed by Side
+
+    FlatHashMap<Price, LevelQueue>& queues(Side side) { return queues_[static_cast<int>(side)]; }
+
+    uint32_t allocate_node();
+    void free_node(uint32_t n);
+
+    void enqueue(uint32_t n);
+    void unlink(uint32_t n);
+
+    void emit_fill(const Order& aggressor, const OrderNode& resting, Quantity qty);
+};
+
+} // namespace trading
@@ -0,0 +1,55 @@
+#pragma once
+#include "../core/order_book.hpp"
+#include "../core/market_data_handler.hpp"
+#include "../utils/slot_queue.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace trading {
+
+// Conflated incremental market-by-price stream for one book.
+//
+// The book records the levels each applied message touches. After a batch,
+// the book thread calls publish(), which sends one LevelUpdate per distinct
+// changed level (best first) carrying its current quantity (0 once gone),
+// then a BBOUpdate if the top of book changed. Levels that do not fit in the
+// ring stay pending and merge with later changes, so a slow subscriber gets
+// the latest state instead of every intermediate one, and the book thread
+// never waits on it. The BBOUpdate goes out only once all pending levels
+// have, so it marks a point where the subscriber's book is consistent.
+class MbpPublisher {
+public:
+    using Queue = SlotQueue<MarketMessage, 4096>;
+
+    // Enables change tracking on book until destroyed
+    MbpPublisher(OrderBook& book, Queue& out, InstrumentId instrument = 0);
+    ~MbpPublisher();
+
+    MbpPublisher(const MbpPublisher&) = delete;
+    MbpPublisher& operator=(const MbpPublisher&) = delete;
+
+    // Book thread, after applying a batch. Returns the messages published.
+    size_t publish();
+
+    uint64_t messages() const { return messages_; }
+    uint64_t bytes() const { return bytes_; }              // as encoded on the wire
+    uint64_t level_changes() const { return changes_; }    // touched levels, repeats included
+    size_t pending() const { return pending_.size(); }     // levels waiting for ring space
+
+private:
+    OrderBook& book_;
+    Queue& out_;
+    InstrumentId instrument_;
+
+    std::vector<LevelChange> pending_;
+    BBOUpdateMsg last_bbo_{};
+    bool bbo_dirty_ = false;
+
+    uint64_t messages_ = 0;
+    uint64_t bytes_ = 0;
+    uint64_t changes_ = 0;
+
+    BBOUpdateMsg current_bbo() const;
+};
+
+} // namespace trading
@@ -1,9 +1,21 @@
 #pragma once
 #include "../utils/config.hpp"
+#include "../core/price_ladder.hpp"
+#include "../core/book_policies.hpp"
+#include "../utils/flat_hash_map.hpp"
+#include "../utils/slab.hpp"
+#include "../utils/telemetry.hpp"
 #include <array>
+#include <cassert>
+#include <cstdlib>
+#include <optional>
+#include <span>
+#include <string>
 #include <unordered_map>
+#include <vector>
 #include <cstdint>
 #include <algorithm>
+#include <bit>
 
 namespace trading {
 
@@ -20,15 +32,316 @@ struct Order {
     Quantity quantity;
 };
 
-class OrderBook {
+struct BookConfig {
+    Price tick_size = DEFAULT_TICK_SIZE;
+    size_t ladder_width = DEFAULT_LADDER_WIDTH;
+    size_t order_capacity = DEFAULT_ORDER_CAPACITY;
+};
+
+// A price level touched by an update, see OrderBook::track_changes
+struct LevelChange {
+    Side side;
+    Price price;
+};
+
+// What sweeping one side of the book for a quantity would fill
+struct FillEstimate {
+    Quantity filled = 0;  // less than asked if the side ran out
+    Price worst = 0;      // last level touched
+    double vwap = 0.0;    // volume-weighted average price of the fill
+};
+
+// Stable reference to a resting order, returned by add_order. Mutating
+// through the handle skips the OrderId lookup; a handle to an order that has
+// since left the book is stale and rejected.
+//
+// index is where the Index policy stored the order and generation the stamp
+// it got on insert (slab-backed indexes only); id lets a policy whose
+// entries move re-find the order.
+struct OrderHandle {
+    static constexpr uint32_t NIL = UINT32_MAX;
+
+    uint32_t index = NIL;
+    uint32_t generation = 0;
+    OrderId id = 0;
+
+    bool valid() const { return index != NIL; }
+    friend bool operator==(const OrderHandle&, const OrderHandle&) = default;
+};
+
+// Index policy: owns the resting orders and finds them by OrderId or by
+// handle. Needs insert (null handle if the id is taken), find (null handle
+// if absent), locate by id or handle (a Location whose order is nullptr if
+// absent or stale), erase of a located order, get (const, by handle), clear,
+// reserve, size, capacity (orders held before growing), for_each(fn(handle,
+// order)) and a constructor taking the expected order count. The book works
+// through locate and erase, so a lookup by id never builds a handle.
+
+// Default index: orders stored inline in a pre-sized flat Robin Hood table
+// keyed by id, so a lookup by id lands on the order itself. A handle is the
+// order's table slot plus its id; entries move when a probe run around them
+// changes (insert, erase, rehash), and a handle whose slot no longer holds
+// its id falls back to a lookup by id.
+//
+// Entries carry no generation, to keep them as small as the by-id path
+// wants: a handle is stale once its id leaves the book, but finds the new
+// order if the same id is added again. Keep handles across id reuse only
+// with a slab-backed index.
+class HashOrderIndex {
+public:
+    explicit HashOrderIndex(size_t capacity) : map_(capacity) {}
+
+    OrderHandle insert(const Order& order) {
+        auto [it, inserted] = map_.emplace(order.id, order);
+        if (!inserted) return {};
+        return {static_cast<uint32_t>(it.slot()), 0, order.id};
+    }
+
+    OrderHandle find(OrderId id) const {
+        auto it = map_.find(id);
+        if (it == map_.end()) return {};
+        return {static_cast<uint32_t>(it.slot()), 0, id};
+    }
+
+    // A located order and its slot, valid until the next insert or erase
+    struct Location {
+        Order* order = nullptr;
+        size_t slot = 0;
+    };
+
+    Location locate(OrderId id) {
+        auto it = map_.find(id);
+        if (it == map_.end()) return {};
+        return {&it->second, it.slot()};
+    }
+
+    Location locate(OrderHandle handle) {
+        Map::value_type* entry = map_.at_slot(handle.index);
+        if (entry && entry->first == handle.id) [[likely]] return {&entry->second, handle.index};
+        if (!handle.valid()) return {};
+        return locate(handle.id); // moved since the handle was taken
+    }
+
+    const Order* get(OrderHandle handle) const { return const_cast<HashOrderIndex*>(this)->locate(handle).order; }
+
+    void erase(const Location& at) { map_.erase_at(at.slot); }
+
+    void clear() { map_.clear(); }
+    void reserve(size_t capacity) { map_.reserve(capacity); }
+    size_t size() const { return map_.size(); }
+    size_t capacity() const { return map_.capacity(); }
+
+    template <typename Fn>
+    void for_each(Fn&& fn) const {
+        for (auto it = map_.begin(); it != map_.end(); ++it)
+            fn(OrderHandle{static_cast<uint32_t>(it.slot()), 0, it->first}, it->second);
+    }
+
+private:
+    using Map = FlatHashMap<OrderId, Order>;
+
+    Map map_;
+};
+
+// Id maps for SlabOrderIndex: OrderId to SlabHandle. Need find (null handle
+// if absent), insert (false if the id is taken), erase, clear, reserve and
+// size, plus a constructor taking the expected order count.
+template <typename Map>
+class MapOrderIds {
+public:
+    explicit MapOrderIds(size_t capacity) : map_(capacity) {}
+
+    SlabHandle find(OrderId id) const {
+        auto it = map_.find(id);
+        return it == map_.end() ? SlabHandle{} : it->second;
+    }
+
+    bool insert(OrderId id, SlabHandle handle) { return map_.emplace(id, handle).second; }
+    void erase(OrderId id) { map_.erase(id); }
+    void clear() { map_.clear(); }
+    void reserve(size_t capacity) { map_.reserve(capacity); }
+    size_t size() const { return map_.size(); }
+
+private:
+    Map map_;
+};
+
+// For feeds whose order ids are dense or sequential: handles sit in a flat
+// array at id - base (base is the first id added to an empty map), so a
+// lookup is one bounds check and one load. The array doubles as ids arrive,
+// up to MAX_SPAN slots; ids below the base or beyond the span fall back to a
+// hash map, so sparse outliers cost a probe rather than memory.
+class DirectOrderIds {
+public:
+    static constexpr size_t MAX_SPAN = size_t(1) << 24; // 128 MiB of handles
+    static constexpr size_t MIN_SPAN = 4096;
+
+    explicit DirectOrderIds(size_t capacity) { reserve(capacity); }
+
+    SlabHandle find(OrderId id) const {
+        uint64_t offset = id - base_;
+        if (offset < slots_.size()) return slots_[offset];
+        if (overflow_.empty()) return {};
+        auto it = overflow_.find(id);
+        return it == overflow_.end() ? SlabHandle{} : it->second;
+    }
+
+    bool insert(OrderId id, SlabHandle handle) {
+        if (size_ == 0) base_ = id; // every slot is null, so the array can move
+        uint64_t offset = id - base_;
+        if (offset >= slots_.size()) {
+            if (offset >= MAX_SPAN) {
+                if (!overflow_.emplace(id, handle).second) return false;
+                ++size_;
+                return true;
+            }
+            slots_.resize(std::max(MIN_SPAN, std::bit_ceil(offset + 1)));
+        }
+        if (slots_[offset].valid()) return false;
+        slots_[offset] = handle;
+        ++size_;
+        return true;
+    }
+
+    void erase(OrderId id) {
+        uint64_t offset = id - base_;
+        if (offset < slots_.size()) {
+            if (slots_[offset].valid()) --size_;
+            slots_[offset] = {};
+        } else {
+            size_ -= overflow_.erase(id);
+        }
+    }
+
+    void clear() {
+        std::fill(slots_.begin(), slots_.end(), SlabHandle{});
+        overflow_.clear();
+        size_ = 0;
+    }
+
+    void reserve(size_t capacity) { slots_.reserve(std::min(capacity, MAX_SPAN)); }
+    size_t size() const { return size_; }
+
+private:
+    std::vector<SlabHandle> slots_;
+    FlatHashMap<OrderId, SlabHandle> overflow_;
+    OrderId base_ = 0;
+    size_t size_ = 0;
+};
+
+// Index policy keeping orders in a generational Slab, found by id through
+// an Ids map of slab handles. A handle never moves, but a lookup by id is
+// two dependent loads (map, then slab), so this pays off with DirectOrderIds
+// (whose map load is a predictable array access) rather than a hash map.
+template <typename Ids>
+class SlabOrderIndex {
 public:
-    OrderBook();
+    explicit SlabOrderIndex(size_t capacity) : orders_(capacity), ids_(capacity) {}
+
+    OrderHandle insert(const Order& order) {
+        SlabHandle handle = orders_.insert(order);
+        if (!ids_.insert(order.id, handle)) {
+            orders_.erase(handle);
+            return {};
+        }
+        return {handle.index, handle.generation, order.id};
+    }
 
-    void add_order(const Order& order);
+    OrderHandle find(OrderId id) const {
+        SlabHandle handle = ids_.find(id);
+        return handle.valid() ? OrderHandle{handle.index, handle.generation, id} : OrderHandle{};
+    }
+
+    struct Location {
+        Order* order = nullptr;
+        SlabHandle handle;
+    };
+
+    Location locate(OrderId id) {
+        SlabHandle handle = ids_.find(id);
+        return {orders_.get(handle), handle};
+    }
+
+    Location locate(OrderHandle handle) {
+        SlabHandle slab{handle.index, handle.generation};
+        return {orders_.get(slab), slab};
+    }
+
+    const Order* get(OrderHandle handle) const { return orders_.get({handle.index, handle.generation}); }
+
+    void erase(const Location& at) {
+        ids_.erase(at.order->id);
+        orders_.erase(at.handle);
+    }
+
+    void clear() {
+        orders_.clear();
+        ids_.clear();
+    }
+
+    void reserve(size_t capacity) {
+        orders_.reserve(capacity);
+        ids_.reserve(capacity);
+    }
+
+    size_t size() const { return orders_.size(); }
+    size_t capacity() const { return orders_.capacity(); }
+
+    template <typename Fn>
+    void for_each(Fn&& fn) const {
+        orders_.for_each([&](SlabHandle handle, const Order& order) {
+            fn(OrderHandle{handle.index, handle.generation, order.id}, order);
+        });
+    }
+
+private:
+    Slab<Order> orders_;
+    Ids ids_;
+};
+
+using StdOrderIndex = SlabOrderIndex<MapOrderIds<std::unordered_map<OrderId, SlabHandle>>>;
+using DirectOrderIndex = SlabOrderIndex<DirectOrderIds>;
+
+// Limit order book, specialised at compile time by three policies:
+//
+// - Traits: tick grid and price band (book_policies.hpp). RuntimeTicks takes
+//   the tick from BookConfig; TickTraits fixes tick and band as constants.
+// - Ladder: per-side level store. PriceLadder slides a window over an
+//   unbounded price range; FixedLadder<Traits> covers a TickTraits band.
+// - Index: where resting orders live and how they are found, see
+//   HashOrderIndex.
+//
+// OrderBook is the default, runtime-configured book.
+template <typename Traits = RuntimeTicks, typename Ladder = PriceLadder, typename Index = HashOrderIndex>
+class BasicOrderBook {
+public:
+    // With a TickTraits, config.tick_size is ignored (and ladder_width too
+    // for a FixedLadder)
+    explicit BasicOrderBook(const BookConfig& config = {});
+
+    // Returns a null handle, and leaves the book alone, for an id already
+    // resting or (with a bounded Traits band) a price outside the band
+    OrderHandle add_order(const Order& order);
     bool cancel_order(OrderId id);
     bool modify_order(OrderId id, Quantity new_quantity);
     bool execute_order(OrderId id, Quantity exec_quantity);
 
+    // Same as the OrderId versions without the id lookup; false for a stale
+    // handle. Executes return false, and leave the book alone, if nothing
+    // traded (a quantity of 0 or less).
+    bool cancel_order(OrderHandle handle);
+    bool modify_order(OrderHandle handle, Quantity new_quantity);
+    bool execute_order(OrderHandle handle, Quantity exec_quantity);
+
+    // Null handle / nullptr if the order is not resting
+    OrderHandle find(OrderId id) const { return orders_.find(id); }
+    const Order* get_order(OrderHandle handle) const { return orders_.get(handle); }
+    size_t order_count() const { return orders_.size(); }
+
+    // Orders the index holds before it has to grow: BookConfig::order_capacity,
+    // or more after a larger snapshot was loaded
+    size_t order_capacity() const { return orders_.capacity(); }
+
     std::optional<Price> get_best_bid() const {
         if (!best_bid_) return std::nullopt;
         return -*best_bid_;
@@ -36,18 +349,299 @@ public:
 
     std::optional<Price> get_best_ask() const { return best_ask_; }
 
+    // Aggregated quantity resting at a price level
+    Quantity get_level(Side side, Price price) const {
+        return ladder(side).quantity(normalize(side, price));
+    }
+
+    // Top levels of one side, best first, written into the caller's arrays
+    // (as many as the shorter span holds). Returns the number written.
+    size_t get_depth(Side side, std::span<Price> prices, std::span<Quantity> quantities) const;
+
+    // Total quantity resting at limit or better
+    Quantity get_cumulative_depth(Side side, Price limit) const {
+        return ladder(side).depth_to(normalize(side, limit));
+    }
+
+    // Fill for taking quantity from side (asks for a buy, bids for a sell)
+    FillEstimate get_vwap(Side side, Quantity quantity) const;
+
+    Price tick_size() const {
+        if constexpr (Traits::TICK_SIZE != 0) return Traits::TICK_SIZE;
+        else return ladders_[0].tick_size();
+    }
+
+    // While enabled, every level an update touches is appended to
+    // changed_levels() (repeats included) until clear_changes(); used for
+    // incremental publishing (see mbp_publisher.hpp)
+    void track_changes(bool enabled) { track_changes_ = enabled; }
+    const std::vector<LevelChange>& changed_levels() const { return changed_; }
+    void clear_changes() { changed_.clear(); }
+
+    // Writes the whole book to path, tagged with the sequence number of the
+    // last message applied. False on I/O error. (Format and definitions in
+    // book_snapshot.hpp.)
+    bool save_snapshot(const std::string& path, uint64_t sequence) const;
+
+    // Replaces the book with the snapshot at path and returns its sequence
+    // number. A missing or corrupt file, or one taken with a different tick
+    // size, leaves the book unchanged and returns nullopt.
+    std::optional<uint64_t> load_snapshot(const std::string& path);
+
 private:
-    std::array<Quantity, MAX_SIZE> levels_{};
-    std::unordered_map<OrderId, Order> orders_;
+    // Indexed by Side; bids are stored as negative prices
+    std::array<Ladder, 2> ladders_;
+    Index orders_;
+    size_t configured_capacity_; // BookConfig::order_capacity, for indexes built later
 
     std::optional<Price> best_bid_;
     std::optional<Price> best_ask_;
 
-    int price_to_index(int norm_price) const {
-        return (norm_price + HALF_SIZE) & (MAX_SIZE - 1);
+    bool track_changes_ = false;
+    std::vector<LevelChange> changed_;
+
+    static Price normalize(Side side, Price price) {
+        return side == Side::Bid ? -price : price;
     }
 
-    void update_best_prices();
+    static Ladder make_ladder(Side side, Price tick_size, size_t width) {
+        if constexpr (Ladder::SLIDING) return Ladder(Traits::TICK_SIZE != 0 ? Traits::TICK_SIZE : tick_size, width);
+        else return Ladder(side == Side::Bid);
+    }
+
+    // Side comes off the wire: decoders reject anything else, this backs them up
+    Ladder& ladder(Side side) {
+        assert(side == Side::Bid || side == Side::Ask);
+        return ladders_[static_cast<int>(side)];
+    }
+    const Ladder& ladder(Side side) const {
+        assert(side == Side::Bid || side == Side::Ask);
+        return ladders_[static_cast<int>(side)];
+    }
+
+    std::optional<Price>& best_price(Side side) {
+        return side == Side::Bid ? best_bid_ : best_ask_;
+    }
+
+    void note_change(Side side, Price norm_price) {
+        if (track_changes_) [[unlikely]] changed_.push_back({side, normalize(side, norm_price)});
+    }
+
+    // The OrderId and OrderHandle versions share these: Key is anything
+    // Index::locate takes
+    template <typename Key> bool cancel(Key key);
+    template <typename Key> bool modify(Key key, Quantity new_quantity);
+    template <typename Key> bool execute(Key key, Quantity exec_quantity);
+    void remove(const typename Index::Location& at);
+
+    void update_best_prices(Side side);
+    void maybe_recenter();
 };
 
+using OrderBook = BasicOrderBook<>;
+
+template <typename Traits, typename Ladder, typename Index>
+BasicOrderBook<Traits, Ladder, Index>::BasicOrderBook(const BookConfig& config)
+    : ladders_{make_ladder(Side::Bid, config.tick_size, config.ladder_width),
+               make_ladder(Side::Ask, config.tick_size, config.ladder_width)},
+      orders_(config.order_capacity), configured_capacity_(config.order_capacity) {
+    best_bid_ = std::nullopt;
+    best_ask_ = std::nullopt;
+}
+
+template <typename Traits, typename Ladder, typename Index>
+size_t BasicOrderBook<Traits, Ladder, Index>::get_depth(Side side, std::span<Price> prices,
+                                                        std::span<Quantity> quantities) const {
+    size_t n = ladder(side).depth(std::min(prices.size(), quantities.size()), prices.data(), quantities.data());
+    if (side == Side::Bid)
+        for (size_t i = 0; i < n; ++i) prices[i] = -prices[i];
+    return n;
+}
+
+template <typename Traits, typename Ladder, typename Index>
+FillEstimate BasicOrderBook<Traits, Ladder, Index>::get_vwap(Side side, Quantity quantity) const {
+    auto sweep = ladder(side).sweep(quantity);
+    FillEstimate fill;
+    fill.filled = sweep.filled;
+    if (sweep.filled == 0) return fill;
+
+    double tick = static_cast<double>(tick_size());
+    fill.worst = normalize(side, sweep.last);
+    fill.vwap = normalize(side, 1) * tick * static_cast<double>(sweep.notional_ticks) / sweep.filled;
+    return fill;
+}
+
+template <typename Traits, typename Ladder, typename Index>
+void BasicOrderBook<Traits, Ladder, Index>::update_best_prices(Side side) {
+    telemetry::count(telemetry::Counter::BestPriceRescans);
+    best_price(side) = ladder(side).best();
+
+    maybe_recenter();
+}
+
+// Keep both windows centred on the mid (or on the only populated side)
+template <typename Traits, typename Ladder, typename Index>
+void BasicOrderBook<Traits, Ladder, Index>::maybe_recenter() {
+    if constexpr (Ladder::SLIDING) {
+        Price mid;
+        if (best_bid_ && best_ask_) mid = (*best_ask_ - *best_bid_) / 2;
+        else if (best_bid_) mid = -*best_bid_;
+        else if (best_ask_) mid = *best_ask_;
+        else return;
+
+        for (Side side : {Side::Bid, Side::Ask}) {
+            Ladder& l = ladder(side);
+            Price tick = tick_size();
+            Price center = normalize(side, mid - mid % tick);
+            Price threshold = static_cast<Price>(l.width() / RECENTER_DIVISOR) * tick;
+            if (std::abs(l.center() - center) > threshold) l.recenter(center);
+        }
+    }
+}
+
+template <typename Traits, typename Ladder, typename Index>
+OrderHandle BasicOrderBook<Traits, Ladder, Index>::add_order(const Order& order) {
+    if constexpr (Traits::BOUNDED)
+        if (!Traits::contains(order.price)) [[unlikely]] return {};
+
+    OrderHandle handle = orders_.insert(order);
+    if (!handle.valid()) [[unlikely]] return {};
+
+    Price norm_price = normalize(order.side, order.price);
+
+    // update level
+    ladder(order.side).add(norm_price, order.quantity);
+    note_change(order.side, norm_price);
+
+    // update best price
+    std::optional<Price>& best = best_price(order.side);
+    if (!best || norm_price < *best) {
+        best = norm_price;
+        maybe_recenter();
+    }
+    return handle;
+}
+
+template <typename Traits, typename Ladder, typename Index>
+bool BasicOrderBook<Traits, Ladder, Index>::cancel_order(OrderId id) {
+    return cancel(id);
+}
+
+template <typename Traits, typename Ladder, typename Index>
+bool BasicOrderBook<Traits, Ladder, Index>::modify_order(OrderId id, Quantity newQuantity) {
+    return modify(id, newQuantity);
+}
+
+template <typename Traits, typename Ladder, typename Index>
+bool BasicOrderBook<Traits, Ladder, Index>::execute_order(OrderId id, Quantity execQuantity) {
+    return execute(id, execQuantity);
+}
+
+template <typename Traits, typename Ladder, typename Index>
+bool BasicOrderBook<Traits, Ladder, Index>::cancel_order(OrderHandle handle) {
+    return cancel(handle);
+}
+
+template <typename Traits, typename Ladder, typename Index>
+bool BasicOrderBook<Traits, Ladder, Index>::modify_order(OrderHandle handle, Quantity newQuantity) {
+    return modify(handle, newQuantity);
+}
+
+template <typename Traits, typename Ladder, typename Index>
+bool BasicOrderBook<Traits, Ladder, Index>::execute_order(OrderHandle handle, Quantity execQuantity) {
+    return execute(handle, execQuantity);
+}
+
+template <typename Traits, typename Ladder, typename Index>
+template <typename Key>
+bool BasicOrderBook<Traits, Ladder, Index>::cancel(Key key) {
+    auto at = orders_.locate(key);
+    if (!at.order) return false;
+    remove(at);
+    return true;
+}
+
+template <typename Traits, typename Ladder, typename Index>
+void BasicOrderBook<Traits, Ladder, Index>::remove(const typename Index::Location& at) {
+    const Order order = *at.order;
+    Price norm_price = normalize(order.side, order.price);
+
+    Quantity level = ladder(order.side).add(norm_price, -order.quantity);
+    note_change(order.side, norm_price);
+    orders_.erase(at);
+
+    // If this level became empty and it was the best price, recompute
+    if (level == 0) {
+        const std::optional<Price>& best = best_price(order.side);
+        if (best && norm_price == *best) update_best_prices(order.side);
+    }
+}
+
+template <typename Traits, typename Ladder, typename Index>
+template <typename Key>
+bool BasicOrderBook<Traits, Ladder, Index>::modify(Key key, Quantity newQuantity) {
+    auto at = orders_.locate(key);
+    Order* o = at.order;
+    if (!o) return false;
+
+    if (newQuantity == 0) {
+        remove(at);
+        return true;
+    }
+
+    Price norm_price = normalize(o->side, o->price);
+
+    Quantity delta = newQuantity - o->quantity;
+    if (delta == 0) return true; // nothing to touch or report
+
+    Quantity level = ladder(o->side).add(norm_price, delta);
+    assert(level >= 0);
+    note_change(o->side, norm_price);
+
+    o->quantity = newQuantity;
+
+    if (level == 0) {
+        const std::optional<Price>& best = best_price(o->side);
+        if (best && norm_price == *best) update_best_prices(o->side);
+    }
+
+    return true;
+}
+
+template <typename Traits, typename Ladder, typename Index>
+template <typename Key>
+bool BasicOrderBook<Traits, Ladder, Index>::execute(Key key, Quantity execQuantity) {
+    auto at = orders_.locate(key);
+    Order* o = at.order;
+    if (!o) return false;
+
+    Side side = o->side;
+
+    Quantity traded = std::min(execQuantity, o->quantity);
+    if (traded <= 0) return false; // nothing traded: no level change to report
+
+    Price norm_price = normalize(side, o->price);
+
+    // Subtract executed quantity
+    Quantity level = ladder(side).add(norm_price, -traded);
+    assert(level >= 0);
+    note_change(side, norm_price);
+
+    o->quantity -= traded;
+
+    // Remove order if fully executed
+    if (o->quantity == 0) orders_.erase(at);
+
+    // If this level became empty and it was best price, recompute
+    if (level == 0) {
+        const std::optional<Price>& best = best_price(side);
+        if (best && norm_price == *best) update_best_prices(side);
+    }
+
+    return true;
+}
+
+// The default book is compiled once, in order_book.cpp
+extern template class BasicOrderBook<>;
+
 } // namespace trading
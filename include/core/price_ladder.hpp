@@ -0,0 +1,98 @@
+#pragma once
+#include "../utils/config.hpp"
+#include "../utils/bitmap.hpp"
+#include <algorithm>
+#include <vector>
+#include <map>
+#include <optional>
+#include <cstdint>
+
+namespace trading {
+
+using Quantity = int64_t;
+
+// Aggregated quantity per price level for one side of the book.
+//
+// Prices are normalized by the caller so the best level is always the lowest
+// one (bids are stored negated). A window of `width` ticks lives in a circular
+// array for O(1) indexed access; levels outside the window are kept in an
+// ordered overflow map until a recenter brings them back. An occupancy bitmap
+// over the window finds the next non-empty level without scanning.
+class PriceLadder {
+public:
+    static constexpr bool SLIDING = true; // window follows the mid, see BasicOrderBook::maybe_recenter
+
+    explicit PriceLadder(Price tick_size = DEFAULT_TICK_SIZE,
+                         size_t width = DEFAULT_LADDER_WIDTH);
+
+    // Adds delta to the level at norm_price and returns the new level quantity
+    Quantity add(Price norm_price, Quantity delta);
+
+    Quantity quantity(Price norm_price) const;
+
+    // Lowest non-empty normalized price
+    std::optional<Price> best() const;
+
+    // Up to n non-empty levels, best first, into norm_prices/quantities;
+    // returns the number written
+    size_t depth(size_t n, Price* norm_prices, Quantity* quantities) const;
+
+    // Total quantity at normalized prices <= norm_limit
+    Quantity depth_to(Price norm_limit) const;
+
+    // Result of taking quantity from the best levels outward
+    struct Sweep {
+        Quantity filled = 0;        // less than asked if the side ran out
+        int64_t notional_ticks = 0; // sum of filled quantity * normalized tick
+        Price last = 0;             // normalized price of the last level touched
+    };
+
+    // What taking quantity would fill; the levels are not changed
+    Sweep sweep(Quantity quantity) const;
+
+    // Slides the window so that norm_price sits at its centre
+    void recenter(Price norm_price);
+
+    Price center() const { return (low_tick_ + static_cast<int64_t>(width_ / 2)) * tick_size_; }
+    bool anchored() const { return anchored_; }
+
+    bool in_window(Price norm_price) const {
+        return static_cast<uint64_t>(to_tick(norm_price) - low_tick_) < width_;
+    }
+
+    Price tick_size() const { return tick_size_; }
+    size_t width() const { return width_; }
+    size_t overflow_levels() const { return overflow_.size(); }
+
+private:
+    Price tick_size_;
+    size_t width_;
+    size_t mask_;
+
+    int64_t low_tick_ = 0; // first tick covered by the window
+    bool anchored_ = false;
+
+    std::vector<Quantity> levels_;
+    HierarchicalBitmap occupied_; // one bit per non-empty window slot
+    std::map<int64_t, Quantity> overflow_; // tick -> quantity, outside the window only
+
+    int64_t to_tick(Price norm_price) const { return norm_price / tick_size_; }
+    size_t slot(int64_t tick) const { return static_cast<size_t>(tick) & mask_; }
+
+    // Next occupied tick in [tick, end), or end if none
+    int64_t next_occupied(int64_t tick, int64_t end) const;
+
+    // Calls fn(levels, count, first_tick) for each contiguous run of slots
+    // covering ticks [begin, end) of the window, until fn returns false
+    template <typename Fn>
+    void for_each_run(int64_t begin, int64_t end, Fn&& fn) const {
+        while (begin < end) {
+            size_t s = slot(begin);
+            size_t n = static_cast<size_t>(std::min<int64_t>(end - begin, static_cast<int64_t>(width_ - s)));
+            if (!fn(levels_.data() + s, n, begin)) return;
+            begin += static_cast<int64_t>(n);
+        }
+    }
+};
+
+} // namespace trading
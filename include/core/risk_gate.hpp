@@ -0,0 +1,155 @@
+#pragma once
+#include "../core/order_book.hpp"
+#include "../utils/tsc.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstdlib>
+
+namespace trading {
+
+// Why the gate refused an order; the first failing check in this order wins
+enum class RiskReject : uint8_t {
+    None,          // accepted
+    OrderSize,     // quantity <= 0 or above max_order_quantity
+    NoReference,   // book empty on both sides and require_reference set
+    PriceBand,     // too far from the touch
+    Notional,      // side's open notional would exceed its limit
+    Position,      // position if every open order on the side filled would exceed its limit
+    Throttle,      // message rate over the limit
+};
+constexpr size_t RISK_REJECT_COUNT = 7;
+
+inline const char* reject_name(RiskReject reason) {
+    constexpr const char* NAMES[RISK_REJECT_COUNT] = {"none",     "order_size", "no_reference", "price_band",
+                                                      "notional", "position",   "throttle"};
+    return NAMES[static_cast<size_t>(reason)];
+}
+
+struct RiskLimits {
+    Quantity max_order_quantity = 1000;
+    Price max_price_deviation = 500;             // from the mid (or the only populated side)
+    bool require_reference = true;
+    std::array<int64_t, 2> max_open_notional{50000000, 50000000}; // price * quantity, indexed by Side
+    std::array<Quantity, 2> max_position{5000, 5000};            // long (Bid), short (Ask)
+    uint32_t max_messages = 1000;                // per throttle window; 0 = unthrottled
+    uint64_t throttle_window_ns = 1000000000;
+};
+
+// Pre-trade checks for our own outbound orders, run before an order goes to
+// the book or the exchange.
+//
+// Every check is evaluated on every call and folded into a bit mask with
+// compares rather than early returns, so the cost does not depend on which
+// check fails and there is nothing for the branch predictor to get wrong
+// when rejects are rare and bursty. An accepted order's exposure is booked
+// with the same mask, again without a branch. Limits and state fill four
+// cache lines inside the gate; nothing allocates after construction.
+//
+// The throttle is a GCRA (virtual scheduling) rate limiter: one timestamp of
+// state, bursts of up to max_messages, then one message per
+// throttle_window_ns / max_messages.
+//
+// Exposure is released by the caller as orders leave: on_fill for
+// executions, on_cancel for cancels and the reduced part of a modify. Not
+// thread-safe; one gate per order-sending thread.
+class RiskGate {
+public:
+    explicit RiskGate(const RiskLimits& limits = {}) { set_limits(limits); }
+
+    void set_limits(const RiskLimits& limits) {
+        limits_ = limits;
+        double ticks_per_ns = TscClock::instance().ticks_per_ns();
+        uint64_t window = static_cast<uint64_t>(limits.throttle_window_ns * ticks_per_ns);
+        interval_ = limits.max_messages > 0 ? window / limits.max_messages : 0;
+        tolerance_ = window - interval_;
+    }
+
+    const RiskLimits& limits() const { return limits_; }
+
+    // A new order against the book's current touch; books the order's
+    // exposure and a throttle slot if accepted
+    template <typename Book>
+    RiskReject check(const Order& order, const Book& book, uint64_t now = tsc_now()) {
+        std::optional<Price> bid = book.get_best_bid();
+        std::optional<Price> ask = book.get_best_ask();
+        uint32_t has_bid = bid.has_value(), has_ask = ask.has_value();
+        int s = static_cast<int>(order.side);
+
+        // mid of the touch, or the only side present (the missing one adds 0)
+        Price reference = (bid.value_or(0) + ask.value_or(0)) >> (has_bid & has_ask);
+        uint32_t has_reference = has_bid | has_ask;
+        int64_t notional = order.price * order.quantity;
+        // signed so the short side counts a sell as position growth
+        Quantity worst_position = (s == 0 ? position_ : -position_) + open_quantity_[s] + order.quantity;
+
+        uint32_t fail = 0;
+        fail |= uint32_t((order.quantity <= 0) | (order.quantity > limits_.max_order_quantity))
+                << bit(RiskReject::OrderSize);
+        fail |= uint32_t(!has_reference & limits_.require_reference) << bit(RiskReject::NoReference);
+        fail |= uint32_t(has_reference & (std::abs(order.price - reference) > limits_.max_price_deviation))
+                << bit(RiskReject::PriceBand);
+        fail |= uint32_t(open_notional_[s] + notional > limits_.max_open_notional[s]) << bit(RiskReject::Notional);
+        fail |= uint32_t(worst_position > limits_.max_position[s]) << bit(RiskReject::Position);
+        fail |= uint32_t(throttle_at_ > now + tolerance_) << bit(RiskReject::Throttle);
+
+        // all ones if accepted
+        uint64_t accept = uint64_t(0) - uint64_t(fail == 0);
+        open_quantity_[s] += order.quantity & static_cast<Quantity>(accept);
+        open_notional_[s] += notional & static_cast<int64_t>(accept);
+        throttle_at_ += (std::max(throttle_at_, now) + interval_ - throttle_at_) & accept;
+
+        return finish(fail);
+    }
+
+    // A cancel or modify going out: only the throttle applies
+    RiskReject check_message(uint64_t now = tsc_now()) {
+        uint32_t fail = uint32_t(throttle_at_ > now + tolerance_) << bit(RiskReject::Throttle);
+        uint64_t accept = uint64_t(0) - uint64_t(fail == 0);
+        throttle_at_ += (std::max(throttle_at_, now) + interval_ - throttle_at_) & accept;
+        return finish(fail);
+    }
+
+    // An accepted order traded quantity at price
+    void on_fill(Side side, Price price, Quantity quantity) {
+        on_cancel(side, price, quantity);
+        position_ += side == Side::Bid ? quantity : -quantity;
+    }
+
+    // An accepted order left the book (or shrank) without trading
+    void on_cancel(Side side, Price price, Quantity quantity) {
+        int s = static_cast<int>(side);
+        open_quantity_[s] -= quantity;
+        open_notional_[s] -= price * quantity;
+    }
+
+    Quantity position() const { return position_; }
+    Quantity open_quantity(Side side) const { return open_quantity_[static_cast<int>(side)]; }
+    int64_t open_notional(Side side) const { return open_notional_[static_cast<int>(side)]; }
+
+    // Checks by outcome, RiskReject::None counting accepts
+    uint64_t count(RiskReject reason) const { return counts_[static_cast<size_t>(reason)]; }
+
+private:
+    static constexpr uint32_t bit(RiskReject reason) { return static_cast<uint32_t>(reason) - 1; }
+
+    RiskReject finish(uint32_t fail) {
+        // lowest set bit names the reason; countr_zero(0) + 1 is masked to None
+        uint32_t reason = (std::countr_zero(fail) + 1) & (0u - uint32_t(fail != 0));
+        ++counts_[reason];
+        return static_cast<RiskReject>(reason);
+    }
+
+    alignas(64) RiskLimits limits_;
+    uint64_t interval_ = 0;  // TSC ticks per message at the limit rate
+    uint64_t tolerance_ = 0; // burst allowance in TSC ticks
+
+    alignas(64) std::array<Quantity, 2> open_quantity_{0, 0};
+    std::array<int64_t, 2> open_notional_{0, 0};
+    Quantity position_ = 0;
+    uint64_t throttle_at_ = 0; // GCRA theoretical arrival time
+    std::array<uint64_t, RISK_REJECT_COUNT> counts_{};
+};
+
+} // namespace trading
@@ -0,0 +1,146 @@
+#pragma once
+#include "../core/market_data_handler.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+
+namespace trading {
+
+/*/
+Sequenced wire format, messages back to back:
+
++----------+--------+----------+------------+-------------+--------------------+
+| 2 bytes  | 1 byte | 1 byte   | 4 bytes    | 8 bytes     | length - 16 bytes  |
+| length   | type   | reserved | instrument | sequence    | payload            |
++----------+--------+----------+------------+-------------+--------------------+
+
+length covers the whole message including this header. It may exceed the
+payload known for the type (trailing fields from newer versions are
+skipped), and messages of unknown types are skipped whole, so the stream
+stays in step either way. The 16-byte header keeps payloads 8-byte aligned.
+/*/
+constexpr size_t SEQUENCED_HEADER_SIZE = 16;
+
+// Encodes msg with the given sequence number; returns the bytes written
+size_t encode_sequenced(const MarketMessage& msg, uint64_t sequence, uint8_t* out);
+
+// Decodes the sequenced format, tracking the expected sequence number.
+//
+// Every message (even one of an unknown type) consumes a sequence number.
+// Messages behind the expected number are duplicates (e.g. the slower of
+// an A/B line pair) and are dropped; a message ahead of it is delivered and
+// the skipped range is reported to the gap handler for recovery.
+class SequencedDecoder {
+public:
+    // Called with the first missing and the first received sequence number
+    using GapHandler = std::function<void(uint64_t expected, uint64_t received)>;
+
+    explicit SequencedDecoder(uint64_t next_sequence = 1) : expected_(next_sequence) {}
+
+    void set_gap_handler(GapHandler handler) { gap_handler_ = std::move(handler); }
+
+    // Decodes complete messages from buffer, calling sink(const MarketMessage&)
+    // for each one in sequence. If the sink returns false the message is left
+    // unconsumed and decoding stops. Returns the bytes consumed: a partial
+    // trailing message is left for the caller to complete, and decoding also
+    // stops at a length too small to be a message (the stream cannot resync).
+    template <typename Sink>
+    size_t decode(const uint8_t* buffer, size_t size, Sink&& sink);
+
+    uint64_t expected_sequence() const { return expected_; }
+    void reset(uint64_t next_sequence) { expected_ = next_sequence; }
+
+    uint64_t messages() const { return messages_; }
+    uint64_t gaps() const { return gaps_; }
+    uint64_t duplicates() const { return duplicates_; }
+    uint64_t unknown() const { return unknown_; }
+    uint64_t malformed() const { return malformed_; } // too short for the type, or an invalid side
+
+private:
+    // Payload bytes by type byte, 0 for unknown: one load instead of a switch
+    static constexpr std::array<uint8_t, 256> PAYLOAD_SIZES = [] {
+        std::array<uint8_t, 256> sizes{};
+        sizes[static_cast<uint8_t>(MessageType::AddOrder)] = sizeof(AddOrderMsg);
+        sizes[static_cast<uint8_t>(MessageType::CancelOrder)] = sizeof(CancelOrderMsg);
+        sizes[static_cast<uint8_t>(MessageType::ModifyOrder)] = sizeof(ModifyOrderMsg);
+        sizes[static_cast<uint8_t>(MessageType::Execute)] = sizeof(ExecuteMsg);
+        sizes[static_cast<uint8_t>(MessageType::Trade)] = sizeof(TradeMsg);
+        sizes[static_cast<uint8_t>(MessageType::BBOUpdate)] = sizeof(BBOUpdateMsg);
+        sizes[static_cast<uint8_t>(MessageType::LevelUpdate)] = sizeof(LevelUpdateMsg);
+        return sizes;
+    }();
+
+    static constexpr size_t MAX_PAYLOAD = std::max({sizeof(AddOrderMsg), sizeof(CancelOrderMsg),
+                                                     sizeof(ModifyOrderMsg), sizeof(ExecuteMsg),
+                                                     sizeof(TradeMsg), sizeof(BBOUpdateMsg),
+                                                     sizeof(LevelUpdateMsg)});
+
+    uint64_t expected_;
+    GapHandler gap_handler_;
+
+    uint64_t messages_ = 0;
+    uint64_t gaps_ = 0;
+    uint64_t duplicates_ = 0;
+    uint64_t unknown_ = 0;
+    uint64_t malformed_ = 0;
+
+    void note_gap(uint64_t received);
+};
+
+template <typename Sink>
+size_t SequencedDecoder::decode(const uint8_t* buffer, size_t size, Sink&& sink) {
+    size_t offset = 0;
+    MarketMessage msg;
+
+    while (size - offset >= SEQUENCED_HEADER_SIZE) {
+        const uint8_t* p = buffer + offset;
+
+        uint16_t length;
+        std::memcpy(&length, p, sizeof(length));
+        if (length < SEQUENCED_HEADER_SIZE) [[unlikely]] {
+            ++malformed_;
+            break;
+        }
+        if (length > size - offset) break; // incomplete
+
+        uint64_t sequence;
+        std::memcpy(&sequence, p + 8, sizeof(sequence));
+        if (sequence < expected_) [[unlikely]] {
+            ++duplicates_;
+            offset += length;
+            continue;
+        }
+
+        size_t payload = PAYLOAD_SIZES[p[2]];
+        if (payload == 0 || length < SEQUENCED_HEADER_SIZE + payload ||
+            !valid_side(static_cast<MessageType>(p[2]), p + SEQUENCED_HEADER_SIZE)) [[unlikely]] {
+            // skipped, but it still took its sequence number
+            if (payload == 0) ++unknown_;
+            else ++malformed_;
+            if (sequence != expected_) note_gap(sequence);
+            expected_ = sequence + 1;
+            offset += length;
+            continue;
+        }
+
+        msg.type = static_cast<MessageType>(p[2]);
+        std::memcpy(&msg.instrument, p + 4, sizeof(InstrumentId));
+        // away from the buffer end, copy the full union so the copy has a
+        // fixed size and does not branch on the type
+        if (size - offset >= SEQUENCED_HEADER_SIZE + MAX_PAYLOAD) [[likely]]
+            std::memcpy(&msg.add, p + SEQUENCED_HEADER_SIZE, MAX_PAYLOAD);
+        else
+            std::memcpy(&msg.add, p + SEQUENCED_HEADER_SIZE, payload);
+        if (!sink(static_cast<const MarketMessage&>(msg))) break;
+
+        if (sequence != expected_) [[unlikely]] note_gap(sequence);
+        expected_ = sequence + 1;
+        offset += length;
+        ++messages_;
+    }
+    return offset;
+}
+
+} // namespace trading
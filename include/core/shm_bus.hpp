@@ -0,0 +1,161 @@
+#pragma once
+#include "../core/market_data_handler.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+namespace trading {
+
+/*/
+Broadcast ring in a named POSIX shared memory segment (/dev/shm/<name> on
+Linux): one writer process publishes MarketMessages, any number of reader
+processes map the segment read-only and each keep their own cursor.
+
++---------------+----------------+----------------+-----+
+| ShmBusHeader  | slot 0         | slot 1         | ... |   capacity slots
++---------------+----------------+----------------+-----+
+
+slot: seq (8 bytes) + MarketMessage, padded to whole cache lines
+
+Slot seqs work as per-slot seqlocks. Position p lives in slot p & (capacity
+- 1); while the writer fills it the seq is 2p + 1, once published 2p + 2. A
+reader expecting position c sees 2c + 2 (ready), something smaller (not
+published yet) or something larger (the writer has lapped it: overrun). It
+copies the message out and re-checks the seq, so a slot overwritten during
+the copy is caught too. The writer never looks at readers and never waits.
+/*/
+struct ShmBusHeader {
+    std::atomic<uint64_t> magic;  // stored last, once the segment is initialised
+    uint32_t version;
+    uint32_t slot_size;           // sizeof(ShmBusSlot): MarketMessage differs with TRADING_TELEMETRY
+    uint64_t capacity;
+
+    alignas(64) std::atomic<uint64_t> write; // next position to publish
+    std::atomic<uint32_t> closed;            // set when the writer goes away
+};
+
+struct alignas(64) ShmBusSlot {
+    std::atomic<uint64_t> seq;
+    MarketMessage msg;
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "shared memory atomics must be address-free");
+
+constexpr uint64_t SHM_BUS_MAGIC = 0x3130535542445254ULL; // "TRDBUS01"
+constexpr uint32_t SHM_BUS_VERSION = 1;
+
+enum class BusRead : uint8_t {
+    Message, // out holds the next message
+    Empty,   // caught up with the writer
+    Overrun  // lapped: messages were lost, the cursor has jumped to the writer
+};
+
+// The publishing side. Creating a bus replaces any segment left under the
+// same name (readers still attached to the old one see no more messages);
+// the destructor marks the bus closed and unlinks the name.
+class ShmBusWriter {
+public:
+    // capacity: slots, a power of two. Not open if it is not or the segment
+    // could not be created.
+    explicit ShmBusWriter(const std::string& name, size_t capacity = 1 << 16);
+    ~ShmBusWriter();
+
+    ShmBusWriter(const ShmBusWriter&) = delete;
+    ShmBusWriter& operator=(const ShmBusWriter&) = delete;
+
+    bool is_open() const { return header_ != nullptr; }
+
+    // Next message to fill in place; readers skip it until commit()
+    MarketMessage* claim() {
+        ShmBusSlot& slot = slots_[next_ & mask_];
+        slot.seq.store(2 * next_ + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release); // seq before the message bytes
+        return &slot.msg;
+    }
+
+    // Publishes the claimed message
+    void commit() {
+        slots_[next_ & mask_].seq.store(2 * next_ + 2, std::memory_order_release);
+        header_->write.store(++next_, std::memory_order_release);
+    }
+
+    void publish(const MarketMessage& msg) {
+        *claim() = msg;
+        commit();
+    }
+
+    // Messages published so far
+    uint64_t position() const { return next_; }
+    size_t capacity() const { return mask_ + 1; }
+    const std::string& name() const { return name_; }
+
+private:
+    std::string name_;
+    ShmBusHeader* header_ = nullptr;
+    ShmBusSlot* slots_ = nullptr;
+    size_t mask_ = 0;
+    size_t map_size_ = 0;
+    uint64_t next_ = 0;
+};
+
+// One reader's view of a bus: attaches read-only and starts at the writer's
+// current position, i.e. only sees messages published from now on. Nothing
+// it does is visible to the writer or other readers.
+class ShmBusReader {
+public:
+    // Not open if the segment does not exist or was built with a different
+    // layout (version, MarketMessage size)
+    explicit ShmBusReader(const std::string& name);
+    ~ShmBusReader();
+
+    ShmBusReader(const ShmBusReader&) = delete;
+    ShmBusReader& operator=(const ShmBusReader&) = delete;
+
+    bool is_open() const { return header_ != nullptr; }
+
+    // Copies the next message into out. On Overrun the cursor moves to the
+    // writer's position and the gap is added to lost(); the consumer must
+    // resynchronise (e.g. from a book snapshot) before trusting its state.
+    BusRead poll(MarketMessage& out) {
+        const ShmBusSlot& slot = slots_[cursor_ & mask_];
+        uint64_t expected = 2 * cursor_ + 2;
+        uint64_t seq = slot.seq.load(std::memory_order_acquire);
+        if (seq < expected) return BusRead::Empty;
+        if (seq == expected) {
+            std::memcpy(static_cast<void*>(&out), &slot.msg, sizeof(MarketMessage));
+            std::atomic_thread_fence(std::memory_order_acquire); // message bytes before the re-check
+            if (slot.seq.load(std::memory_order_relaxed) == expected) {
+                ++cursor_;
+                return BusRead::Message;
+            }
+        }
+        skip_to_writer();
+        return BusRead::Overrun;
+    }
+
+    // Messages published but not yet read (may exceed capacity when lapped)
+    uint64_t lag() const { return header_->write.load(std::memory_order_acquire) - cursor_; }
+
+    // The writer has shut down; whatever is still in the ring can be read
+    bool writer_closed() const { return header_->closed.load(std::memory_order_acquire) != 0; }
+
+    uint64_t position() const { return cursor_; }
+    uint64_t overruns() const { return overruns_; }
+    uint64_t lost() const { return lost_; }
+    size_t capacity() const { return mask_ + 1; }
+
+private:
+    const ShmBusHeader* header_ = nullptr;
+    const ShmBusSlot* slots_ = nullptr;
+    size_t mask_ = 0;
+    size_t map_size_ = 0;
+    uint64_t cursor_ = 0;
+    uint64_t overruns_ = 0;
+    uint64_t lost_ = 0;
+
+    void skip_to_writer();
+};
+
+} // namespace trading
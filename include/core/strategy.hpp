@@ -0,0 +1,171 @@
+#pragma once
+#include "../core/order_book.hpp"
+#include "../core/market_data_handler.hpp"
+#include <tuple>
+#include <type_traits>
+
+namespace trading {
+
+// Base for strategies driven by BookEvents (CRTP). A strategy subscribes to
+// an event by defining the matching handler in Derived; the inherited no-op
+// handlers mark events it ignores, and BookEvents skips those at compile
+// time, including the work to detect the event if no strategy wants it.
+// Handlers are called directly on the concrete type, so they inline.
+//
+// Handlers must not be overloaded (the subscription test takes their
+// address).
+template <typename Derived>
+class Strategy {
+public:
+    void on_bbo(const BBOUpdateMsg&) {}     // top of book price or size changed; empty side is 0 / 0
+    void on_level(const LevelUpdateMsg&) {} // a level's quantity changed; qty 0: level removed
+    void on_trade(const TradeMsg&) {}       // trade print
+    void on_execute(const ExecuteMsg&) {}   // a resting order in the book traded
+};
+
+// Whether S defines a handler rather than inheriting the no-op
+template <typename S>
+constexpr bool handles_bbo = !std::is_same_v<decltype(&S::on_bbo), decltype(&Strategy<S>::on_bbo)>;
+template <typename S>
+constexpr bool handles_level = !std::is_same_v<decltype(&S::on_level), decltype(&Strategy<S>::on_level)>;
+template <typename S>
+constexpr bool handles_trade = !std::is_same_v<decltype(&S::on_trade), decltype(&Strategy<S>::on_trade)>;
+template <typename S>
+constexpr bool handles_execute = !std::is_same_v<decltype(&S::on_execute), decltype(&Strategy<S>::on_execute)>;
+
+// Applies market data to a book and calls the strategies' handlers with what
+// actually changed.
+//
+// Level events come from the book's change tracking: after each message the
+// touched levels are read back once and reported with their new quantity. A
+// BBO event follows only if the best price moved or a touched level is at
+// the touch, and the new top differs from the last one reported. An execute
+// is reported only if the book found the order. Per message the order is:
+// levels, BBO, then trade / execute; strategies are called in the order they
+// were passed.
+//
+// Takes over the book's change tracking, so it cannot share a book with an
+// MbpPublisher. Book thread only.
+template <typename Book, typename... Strategies>
+class BookEvents {
+public:
+    static constexpr bool ANY_BBO = (handles_bbo<Strategies> || ...);
+    static constexpr bool ANY_LEVEL = (handles_level<Strategies> || ...);
+    static constexpr bool ANY_TRADE = (handles_trade<Strategies> || ...);
+    static constexpr bool ANY_EXECUTE = (handles_execute<Strategies> || ...);
+    static constexpr bool TRACK_LEVELS = ANY_BBO || ANY_LEVEL;
+
+    explicit BookEvents(Book& book, Strategies&... strategies) : book_(book), strategies_(strategies...) {
+        if constexpr (TRACK_LEVELS) {
+            book_.track_changes(true);
+            book_.clear_changes();
+        }
+        if constexpr (ANY_BBO) last_bbo_ = current_bbo();
+    }
+
+    ~BookEvents() {
+        if constexpr (TRACK_LEVELS) book_.track_changes(false);
+    }
+
+    BookEvents(const BookEvents&) = delete;
+    BookEvents& operator=(const BookEvents&) = delete;
+
+    void apply(const MarketMessage& msg) {
+        bool executed = false;
+        switch (msg.type) {
+            case MessageType::AddOrder:
+                book_.add_order({msg.add.orderId, msg.add.side, msg.add.price, msg.add.qty});
+                break;
+            case MessageType::CancelOrder:
+                book_.cancel_order(msg.cancel.orderId);
+                break;
+            case MessageType::ModifyOrder:
+                book_.modify_order(msg.modify.orderId, msg.modify.newQty);
+                break;
+            case MessageType::Execute:
+                executed = book_.execute_order(msg.execute.orderId, msg.execute.qty);
+                break;
+            case MessageType::Trade:
+            case MessageType::BBOUpdate:
+            case MessageType::LevelUpdate:
+                break;
+        }
+
+        if constexpr (TRACK_LEVELS) dispatch_changes();
+
+        if constexpr (ANY_TRADE) {
+            if (msg.type == MessageType::Trade) {
+                for_each([&](auto& s) {
+                    if constexpr (handles_trade<std::remove_cvref_t<decltype(s)>>) s.on_trade(msg.trade);
+                });
+            }
+        }
+        if constexpr (ANY_EXECUTE) {
+            if (executed) {
+                for_each([&](auto& s) {
+                    if constexpr (handles_execute<std::remove_cvref_t<decltype(s)>>) s.on_execute(msg.execute);
+                });
+            }
+        }
+    }
+
+    Book& book() { return book_; }
+    const BBOUpdateMsg& last_bbo() const { return last_bbo_; }
+
+private:
+    Book& book_;
+    std::tuple<Strategies&...> strategies_;
+    BBOUpdateMsg last_bbo_{};
+
+    template <typename Fn>
+    void for_each(Fn&& fn) {
+        std::apply([&](auto&... s) { (fn(s), ...); }, strategies_);
+    }
+
+    BBOUpdateMsg current_bbo() const {
+        BBOUpdateMsg bbo{};
+        if (auto bid = book_.get_best_bid()) {
+            bbo.bestBid = *bid;
+            bbo.bidSize = book_.get_level(Side::Bid, *bid);
+        }
+        if (auto ask = book_.get_best_ask()) {
+            bbo.bestAsk = *ask;
+            bbo.askSize = book_.get_level(Side::Ask, *ask);
+        }
+        return bbo;
+    }
+
+    void dispatch_changes() {
+        const std::vector<LevelChange>& changes = book_.changed_levels();
+        if (changes.empty()) return;
+
+        Price bid = book_.get_best_bid().value_or(0);
+        Price ask = book_.get_best_ask().value_or(0);
+        bool touch = bid != last_bbo_.bestBid || ask != last_bbo_.bestAsk;
+
+        for (const LevelChange& change : changes) {
+            touch |= change.price == (change.side == Side::Bid ? bid : ask);
+            if constexpr (ANY_LEVEL) {
+                LevelUpdateMsg level{change.side, change.price, book_.get_level(change.side, change.price)};
+                for_each([&](auto& s) {
+                    if constexpr (handles_level<std::remove_cvref_t<decltype(s)>>) s.on_level(level);
+                });
+            }
+        }
+        book_.clear_changes();
+
+        if constexpr (ANY_BBO) {
+            if (!touch) return;
+            BBOUpdateMsg bbo = current_bbo();
+            if (bbo.bestBid == last_bbo_.bestBid && bbo.bestAsk == last_bbo_.bestAsk &&
+                bbo.bidSize == last_bbo_.bidSize && bbo.askSize == last_bbo_.askSize)
+                return;
+            last_bbo_ = bbo;
+            for_each([&](auto& s) {
+                if constexpr (handles_bbo<std::remove_cvref_t<decltype(s)>>) s.on_bbo(bbo);
+            });
+        }
+    }
+};
+
+} // namespace trading
@@ -0,0 +1,234 @@
+#pragma once
+#include "slot_queue.hpp"
+#include "cpu.hpp"
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <memory>
+#include <string>
+#include <thread>
+#include <type_traits>
+
+namespace trading {
+
+enum class OverflowPolicy {
+    Drop,  // count the record and return at once
+    Block  // spin until the background thread frees a slot
+};
+
+// Logger whose hot-thread cost is a timestamp, a slot claim and a few stores.
+//
+// log() records a pointer to the format string (its id) plus the raw
+// argument values into an SPSC ring; a background thread formats "{}"
+// placeholders and writes lines to the file. Format strings and const char*
+// arguments are stored by pointer, so they must outlive the logger (string
+// literals). One producer thread per logger.
+template <size_t N = (1 << 14)>
+class BasicAsyncLogger {
+public:
+    static constexpr size_t MAX_ARGS = 8;
+
+    // Writes to path (truncated); check is_open()
+    explicit BasicAsyncLogger(const std::string& path, OverflowPolicy policy = OverflowPolicy::Drop)
+        : file_(std::fopen(path.c_str(), "w")), owns_file_(true), policy_(policy) {
+        if (file_) start();
+    }
+
+    // Writes to an already open stream, e.g. stdout; not closed
+    explicit BasicAsyncLogger(std::FILE* file, OverflowPolicy policy = OverflowPolicy::Drop)
+        : file_(file), owns_file_(false), policy_(policy) {
+        if (file_) start();
+    }
+
+    BasicAsyncLogger(const BasicAsyncLogger&) = delete;
+    BasicAsyncLogger& operator=(const BasicAsyncLogger&) = delete;
+
+    // Writes out everything queued, then stops
+    ~BasicAsyncLogger() {
+        running_.store(false, std::memory_order_release);
+        if (thread_.joinable()) thread_.join();
+        if (file_ && owns_file_) std::fclose(file_);
+    }
+
+    bool is_open() const { return file_ != nullptr; }
+
+    // Hot thread. Returns false if the record was dropped.
+    template <typename... Args>
+    bool log(const char* format, Args... args) {
+        static_assert(sizeof...(Args) <= MAX_ARGS, "too many log arguments");
+        if (!file_) return false;
+
+        Record* record = queue_->claim();
+        if (!record) {
+            if (policy_ == OverflowPolicy::Drop) {
+                dropped_.store(dropped_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                return false;
+            }
+            while (!(record = queue_->claim())) cpu_relax();
+        }
+
+        record->timestamp_ns = now_ns();
+        record->format = format;
+        record->count = sizeof...(Args);
+        size_t i = 0;
+        (encode(*record, i++, args), ...);
+        (void)i;
+        queue_->commit(record);
+        return true;
+    }
+
+    uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+    uint64_t written() const { return written_.load(std::memory_order_relaxed); }
+
+private:
+    enum class ArgType : uint8_t { Signed, Unsigned, Double, Char, Bool, String };
+
+    struct Record {
+        uint64_t timestamp_ns;
+        const char* format;
+        uint8_t count;
+        ArgType types[MAX_ARGS];
+        uint64_t values[MAX_ARGS];
+    };
+
+    using Queue = SlotQueue<Record, N>;
+
+    std::FILE* file_;
+    bool owns_file_;
+    OverflowPolicy policy_;
+    std::unique_ptr<Queue> queue_ = std::make_unique<Queue>();
+
+    std::atomic<bool> running_{false};
+    std::thread thread_;
+
+    // single writer each: producer / background thread
+    alignas(64) std::atomic<uint64_t> dropped_{0};
+    alignas(64) std::atomic<uint64_t> written_{0};
+
+    static uint64_t now_ns() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+    template <typename T>
+    static void encode(Record& record, size_t i, T value) {
+        uint64_t bits = 0;
+        if constexpr (std::is_same_v<T, bool>) {
+            record.types[i] = ArgType::Bool;
+            bits = value;
+        } else if constexpr (std::is_same_v<T, char>) {
+            record.types[i] = ArgType::Char;
+            bits = static_cast<unsigned char>(value);
+        } else if constexpr (std::is_enum_v<T>) {
+            record.types[i] = ArgType::Signed;
+            bits = static_cast<uint64_t>(static_cast<int64_t>(value));
+        } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+            record.types[i] = ArgType::Signed;
+            bits = static_cast<uint64_t>(static_cast<int64_t>(value));
+        } else if constexpr (std::is_integral_v<T>) {
+            record.types[i] = ArgType::Unsigned;
+            bits = value;
+        } else if constexpr (std::is_floating_point_v<T>) {
+            record.types[i] = ArgType::Double;
+            double d = value;
+            std::memcpy(&bits, &d, sizeof(bits));
+        } else {
+            static_assert(std::is_convertible_v<T, const char*>, "unsupported log argument type");
+            record.types[i] = ArgType::String;
+            bits = reinterpret_cast<uintptr_t>(static_cast<const char*>(value));
+        }
+        record.values[i] = bits;
+    }
+
+    void start() {
+        running_.store(true, std::memory_order_relaxed);
+        thread_ = std::thread(&BasicAsyncLogger::run, this);
+    }
+
+    // Background thread: format and write until stopped, then drain
+    void run() {
+        while (true) {
+            bool stopping = !running_.load(std::memory_order_acquire);
+            size_t n = 0;
+            while (Record* record = queue_->consume()) {
+                write(*record);
+                queue_->release(record);
+                ++n;
+            }
+            if (n > 0) {
+                written_.store(written_.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+                continue;
+            }
+            std::fflush(file_);
+            if (stopping) break;
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    }
+
+    void write(const Record& record) {
+        char line[1024];
+        char* out = line;
+        char* end = line + sizeof(line) - 1; // room for the newline
+
+        // HH:MM:SS.nnnnnnnnn | message
+        std::time_t seconds = static_cast<std::time_t>(record.timestamp_ns / 1000000000);
+        std::tm tm;
+        localtime_r(&seconds, &tm);
+        out += std::strftime(out, end - out, "%H:%M:%S", &tm);
+        out += std::snprintf(out, end - out, ".%09llu | ",
+                             static_cast<unsigned long long>(record.timestamp_ns % 1000000000));
+
+        size_t arg = 0;
+        for (const char* f = record.format; *f && out < end; ++f) {
+            if (f[0] == '{' && f[1] == '}' && arg < record.count) {
+                out = format_arg(out, end, record.types[arg], record.values[arg]);
+                ++arg;
+                ++f;
+            } else {
+                *out++ = *f;
+            }
+        }
+        *out++ = '\n';
+        std::fwrite(line, 1, out - line, file_);
+    }
+
+    static char* format_arg(char* out, char* end, ArgType type, uint64_t bits) {
+        switch (type) {
+            case ArgType::Signed:
+                return std::to_chars(out, end, static_cast<int64_t>(bits)).ptr;
+            case ArgType::Unsigned:
+                return std::to_chars(out, end, bits).ptr;
+            case ArgType::Double: {
+                double d;
+                std::memcpy(&d, &bits, sizeof(d));
+                auto result = std::to_chars(out, end, d);
+                return result.ec == std::errc() ? result.ptr : out;
+            }
+            case ArgType::Char:
+                *out = static_cast<char>(bits);
+                return out + 1;
+            case ArgType::Bool: {
+                const char* text = bits ? "true" : "false";
+                size_t len = std::min<size_t>(std::strlen(text), end - out);
+                std::memcpy(out, text, len);
+                return out + len;
+            }
+            case ArgType::String: {
+                const char* text = reinterpret_cast<const char*>(static_cast<uintptr_t>(bits));
+                size_t len = text ? std::min<size_t>(std::strlen(text), end - out) : 0;
+                std::memcpy(out, text, len);
+                return out + len;
+            }
+        }
+        return out;
+    }
+};
+
+using AsyncLogger = BasicAsyncLogger<>;
+
+} // namespace trading
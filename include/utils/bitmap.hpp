@@ -0,0 +1,77 @@
+#pragma once
+#include <bit>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <cassert>
+
+namespace trading {
+
+// Three-level occupancy bitmap over up to 64^3 slots.
+//
+// Each bit of a summary word says whether the 64-bit word below it has any
+// bit set, so find_next() touches at most one word per level and resolves
+// with a handful of count-trailing-zeros instructions whatever the size.
+class HierarchicalBitmap {
+public:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+    static constexpr size_t MAX_BITS = 64 * 64 * 64;
+
+    explicit HierarchicalBitmap(size_t size)
+        : size_(size), l0_((size + 63) / 64, 0), l1_((l0_.size() + 63) / 64, 0) {
+        assert(size <= MAX_BITS);
+    }
+
+    void set(size_t i) {
+        l0_[i >> 6] |= bit(i);
+        l1_[i >> 12] |= bit(i >> 6);
+        l2_ |= bit(i >> 12);
+    }
+
+    void clear(size_t i) {
+        if ((l0_[i >> 6] &= ~bit(i)) != 0) return;
+        if ((l1_[i >> 12] &= ~bit(i >> 6)) != 0) return;
+        l2_ &= ~bit(i >> 12);
+    }
+
+    bool test(size_t i) const { return (l0_[i >> 6] & bit(i)) != 0; }
+    bool empty() const { return l2_ == 0; }
+    size_t size() const { return size_; }
+
+    // First set bit at or after i, npos if none
+    size_t find_next(size_t i) const {
+        if (i >= size_) return npos;
+
+        size_t w = i >> 6;
+        uint64_t bits = l0_[w] & (~0ULL << (i & 63));
+        if (bits) return (w << 6) | std::countr_zero(bits);
+
+        // next non-empty word in the same summary block
+        size_t w1 = w + 1;
+        size_t s = w1 >> 6;
+        if (s >= l1_.size()) return npos;
+        uint64_t b1 = l1_[s] & (~0ULL << (w1 & 63));
+        if (b1) return lowest_in_word((s << 6) | std::countr_zero(b1));
+
+        // next non-empty summary block
+        size_t s1 = s + 1;
+        if (s1 >= 64) return npos;
+        uint64_t b2 = l2_ & (~0ULL << s1);
+        if (!b2) return npos;
+
+        size_t sn = std::countr_zero(b2);
+        return lowest_in_word((sn << 6) | std::countr_zero(l1_[sn]));
+    }
+
+private:
+    size_t size_;
+    std::vector<uint64_t> l0_; // one bit per slot
+    std::vector<uint64_t> l1_; // one bit per l0 word
+    uint64_t l2_ = 0;          // one bit per l1 word
+
+    static uint64_t bit(size_t i) { return 1ULL << (i & 63); }
+
+    size_t lowest_in_word(size_t w) const { return (w << 6) | std::countr_zero(l0_[w]); }
+};
+
+} // namespace trading
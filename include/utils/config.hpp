@@ -1,21 +1,22 @@
 #pragma once
 #include <cstdint>
-#include <algorithm>
+#include <cstddef>
 
 namespace trading {
 
 using Price = int64_t;
 
-// Order book
-constexpr int MAX_SIZE = 256;
-constexpr int HALF_SIZE = MAX_SIZE / 2;
+// Price ladder
+constexpr Price DEFAULT_TICK_SIZE = 1;
+constexpr size_t DEFAULT_LADDER_WIDTH = 4096; // levels per side, power of two, <= 64^3
+
+// Recenter once the mid drifts this far (in ticks) from the window centre
+constexpr size_t RECENTER_DIVISOR = 4; // width / 4
+
+// Resting orders a book is pre-sized for
+constexpr size_t DEFAULT_ORDER_CAPACITY = 1 << 16;
 
 // Price limits
 constexpr Price MIN_PRICE = 1;
-constexpr Price MAX_PRICE = HALF_SIZE - 1;
-
-inline Price clamp_price(Price price) {
-    return std::clamp(price, MIN_PRICE, MAX_PRICE);
-}
 
 } // namespace trading
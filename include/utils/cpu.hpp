@@ -0,0 +1,42 @@
+#pragma once
+#include <thread>
+#include <algorithm>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace trading {
+
+// Pins the calling thread to a core; returns false where affinity is unsupported
+inline bool pin_current_thread(int core) {
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(core, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)core;
+    return false;
+#endif
+}
+
+// Spin-wait hint: lets the sibling hyperthread run and saves power
+inline void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield" ::: "memory");
+#endif
+}
+
+inline unsigned num_cores() {
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+} // namespace trading
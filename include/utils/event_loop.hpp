@@ -0,0 +1,268 @@
+#pragma once
+#include "cpu.hpp"
+#include "tsc.hpp"
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <utility>
+
+namespace trading {
+
+// Eventcount that lets an idle consumer sleep on a futex (std::atomic::wait,
+// a futex on Linux) until a producer publishes.
+//
+// Producers call notify() after every publish; while nobody sleeps that is a
+// fence and a load. A consumer announces itself, re-checks its queue and only
+// then sleeps, so a publish can never slip in between unnoticed.
+class Wakeup {
+public:
+    // Producer, after publishing
+    void notify() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sleepers_.load(std::memory_order_relaxed) == 0) return;
+        epoch_.fetch_add(1, std::memory_order_seq_cst);
+        epoch_.notify_all();
+    }
+
+    // Consumer: sleeps until the next notify() unless ready() holds once this
+    // thread is visible to producers. Returns true if it slept.
+    template <typename Ready>
+    bool wait(Ready&& ready) {
+        uint32_t epoch = epoch_.load(std::memory_order_seq_cst);
+        sleepers_.fetch_add(1, std::memory_order_seq_cst);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        bool slept = !ready();
+        if (slept) epoch_.wait(epoch, std::memory_order_seq_cst);
+
+        sleepers_.fetch_sub(1, std::memory_order_relaxed);
+        return slept;
+    }
+
+private:
+    alignas(64) std::atomic<uint32_t> epoch_{0};
+    alignas(64) std::atomic<uint32_t> sleepers_{0};
+};
+
+// Wait strategies: what an EventLoop does when its queue is empty.
+// reset() is called after work is found; idle(ready) once per empty poll,
+// where ready() re-checks for work; wake() when the loop is being stopped.
+
+// Lowest latency: spin with the pause hint, a full core per consumer
+struct BusySpinWait {
+    void reset() {}
+    template <typename Ready>
+    void idle(Ready&&) { cpu_relax(); }
+    void wake() {}
+};
+
+// Spins for a while after the last message, then yields the core between polls
+class SpinYieldWait {
+public:
+    explicit SpinYieldWait(uint32_t spins = 1000) : spin_limit_(spins) {}
+
+    void reset() { spins_ = 0; }
+
+    template <typename Ready>
+    void idle(Ready&&) {
+        if (spins_ < spin_limit_) {
+            ++spins_;
+            cpu_relax();
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    void wake() {}
+
+private:
+    uint32_t spin_limit_;
+    uint32_t spins_ = 0;
+};
+
+// Spins for a while, then sleeps until a producer calls wakeup.notify().
+// Every producer feeding the queue must notify after publishing.
+class BlockingWait {
+public:
+    explicit BlockingWait(Wakeup& wakeup, uint32_t spins = 1000)
+        : wakeup_(&wakeup), spin_limit_(spins) {}
+
+    void reset() { spins_ = 0; }
+
+    template <typename Ready>
+    void idle(Ready&& ready) {
+        if (spins_ < spin_limit_) {
+            ++spins_;
+            cpu_relax();
+            return;
+        }
+        if (wakeup_->wait(ready)) ++sleeps_;
+        spins_ = 0;
+    }
+
+    void wake() { wakeup_->notify(); }
+
+    uint64_t sleeps() const { return sleeps_; }
+
+private:
+    Wakeup* wakeup_;
+    uint32_t spin_limit_;
+    uint32_t spins_ = 0;
+    uint64_t sleeps_ = 0;
+};
+
+// Single-consumer loop over a claim/consume/release queue: hands each message
+// to a handler in place, releases it, and idles with the Wait strategy.
+//
+// Time is split into busy (polling that found work, plus handling) and idle
+// (empty polls and waiting), stamped with the TSC when the loop switches
+// between the two and every PUBLISH_EVERY messages, so a steady stream costs
+// one extra clock read per batch and stats() stays current under load. An
+// idle stretch still in progress is counted by stats() up to the time it is
+// called, so idle time keeps rising while the loop spins, yields or sleeps.
+template <typename Queue, typename Wait = BusySpinWait>
+class EventLoop {
+public:
+    struct Stats {
+        uint64_t messages;
+        uint64_t busy_ns;
+        uint64_t idle_ns;
+
+        // Fraction of the loop's time spent handling messages
+        double utilisation() const {
+            uint64_t total = busy_ns + idle_ns;
+            return total ? double(busy_ns) / total : 0.0;
+        }
+    };
+
+    explicit EventLoop(Queue& queue, Wait wait = Wait{}) : queue_(queue), wait_(std::move(wait)) {}
+    ~EventLoop() { stop(); }
+
+    EventLoop(const EventLoop&) = delete;
+    EventLoop& operator=(const EventLoop&) = delete;
+
+    // Runs on a new thread, pinned to core unless it is negative
+    template <typename Handler>
+    void start(Handler handler, int core = -1) {
+        running_.store(true, std::memory_order_relaxed);
+        thread_ = std::thread([this, handler = std::move(handler), core]() mutable {
+            if (core >= 0) pin_current_thread(core);
+            loop(handler);
+        });
+    }
+
+    // Runs on the calling thread until stop() from another thread
+    template <typename Handler>
+    void run(Handler&& handler) {
+        running_.store(true, std::memory_order_relaxed);
+        loop(handler);
+    }
+
+    // Handles what is already queued, then returns (joining a started thread)
+    void stop() {
+        running_.store(false, std::memory_order_seq_cst);
+        wait_.wake();
+        if (thread_.joinable()) thread_.join();
+    }
+
+    bool running() const { return running_.load(std::memory_order_relaxed); }
+
+    // Any thread
+    Stats stats() const {
+        uint64_t since, idle;
+        do { // the loop clears idle_since_ before it folds the stretch into idle_ticks_
+            since = idle_since_.load(std::memory_order_acquire);
+            idle = idle_ticks_.load(std::memory_order_acquire);
+        } while (since != idle_since_.load(std::memory_order_acquire));
+        if (since != 0) {
+            uint64_t now = tsc_now();
+            if (now > since) idle += now - since;
+        }
+
+        const TscClock& clock = TscClock::instance();
+        return {messages_.load(std::memory_order_relaxed),
+                clock.to_ns(busy_ticks_.load(std::memory_order_relaxed)), clock.to_ns(idle)};
+    }
+
+    const Wait& wait_strategy() const { return wait_; }
+
+private:
+    Queue& queue_;
+    Wait wait_;
+    std::atomic<bool> running_{false};
+    std::thread thread_;
+
+    static constexpr uint64_t PUBLISH_EVERY = 1024; // power of two
+
+    // written by the loop thread only
+    alignas(64) std::atomic<uint64_t> messages_{0};
+    std::atomic<uint64_t> busy_ticks_{0};
+    std::atomic<uint64_t> idle_ticks_{0};
+    std::atomic<uint64_t> idle_since_{0}; // TSC the current idle stretch began, 0 while busy
+
+    template <typename Handler>
+    void loop(Handler& handler) {
+        auto ready = [this]() {
+            return !running_.load(std::memory_order_seq_cst) || queue_.size_approx() > 0;
+        };
+
+        uint64_t messages = messages_.load(std::memory_order_relaxed);
+        uint64_t busy = busy_ticks_.load(std::memory_order_relaxed);
+        uint64_t idle = idle_ticks_.load(std::memory_order_relaxed);
+        uint64_t mark = tsc_now();
+        bool idling = false;
+
+        while (running_.load(std::memory_order_relaxed)) {
+            auto* msg = queue_.consume();
+            if (!msg) {
+                if (!idling) {
+                    uint64_t now = tsc_now();
+                    busy += now - mark;
+                    mark = now;
+                    idling = true;
+                    busy_ticks_.store(busy, std::memory_order_relaxed);
+                    idle_since_.store(mark, std::memory_order_release);
+                }
+                wait_.idle(ready);
+                continue;
+            }
+
+            if (idling) {
+                uint64_t now = tsc_now();
+                idle += now - mark;
+                mark = now;
+                idling = false;
+                idle_since_.store(0, std::memory_order_relaxed);
+                idle_ticks_.store(idle, std::memory_order_release);
+                wait_.reset();
+            }
+            handler(*msg);
+            queue_.release(msg);
+            messages_.store(++messages, std::memory_order_relaxed);
+
+            // a loop that never goes idle would otherwise never publish its busy time
+            if ((messages & (PUBLISH_EVERY - 1)) == 0) {
+                uint64_t now = tsc_now();
+                busy += now - mark;
+                mark = now;
+                busy_ticks_.store(busy, std::memory_order_relaxed);
+            }
+        }
+
+        // drain
+        while (auto* msg = queue_.consume()) {
+            handler(*msg);
+            queue_.release(msg);
+            ++messages;
+        }
+
+        uint64_t now = tsc_now();
+        (idling ? idle : busy) += now - mark;
+        idle_since_.store(0, std::memory_order_relaxed);
+        busy_ticks_.store(busy, std::memory_order_relaxed);
+        idle_ticks_.store(idle, std::memory_order_release);
+        messages_.store(messages, std::memory_order_relaxed);
+    }
+};
+
+} // namespace trading
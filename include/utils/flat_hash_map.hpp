@@ -0,0 +1,228 @@
+#pragma once
+#include <vector>
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+#include <functional>
+#include <new>
+#include <bit>
+#include <cstdint>
+#include <cstddef>
+
+namespace trading {
+
+// Allocator handing out cache-line aligned blocks
+template <typename T, size_t Align = 64>
+struct CacheAlignedAllocator {
+    using value_type = T;
+
+    template <typename U> struct rebind { using other = CacheAlignedAllocator<U, Align>; };
+
+    CacheAlignedAllocator() = default;
+    template <typename U> CacheAlignedAllocator(const CacheAlignedAllocator<U, Align>&) {}
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{Align}));
+    }
+
+    void deallocate(T* p, size_t) { ::operator delete(p, std::align_val_t{Align}); }
+
+    template <typename U> bool operator==(const CacheAlignedAllocator<U, Align>&) const { return true; }
+};
+
+// Open-addressing hash map with Robin Hood probing and backward-shift deletion.
+//
+// Entries are stored inline in one flat array; a parallel byte array holds
+// each entry's probe distance (0 = empty), so probing scans a contiguous
+// metadata run and only compares keys whose distance matches. Deletion shifts
+// the following run back by one, so there are no tombstones.
+//
+// The table is sized up front for `capacity` entries and only rehashes if
+// that is exceeded. Iterators and pointers are invalidated by insert/erase.
+template <typename K, typename V, typename Hash = std::hash<K>>
+class FlatHashMap {
+public:
+    using value_type = std::pair<K, V>;
+
+    template <bool Const>
+    class Iterator {
+    public:
+        using Map = std::conditional_t<Const, const FlatHashMap, FlatHashMap>;
+        using Ref = std::conditional_t<Const, const value_type&, value_type&>;
+        using Ptr = std::conditional_t<Const, const value_type*, value_type*>;
+
+        Iterator(Map* map, size_t index) : map_(map), index_(index) {}
+
+        Ref operator*() const { return map_->slots_[index_]; }
+        Ptr operator->() const { return &map_->slots_[index_]; }
+
+        Iterator& operator++() {
+            index_ = map_->next_occupied(index_ + 1);
+            return *this;
+        }
+
+        bool operator==(const Iterator& other) const { return index_ == other.index_; }
+        bool operator!=(const Iterator& other) const { return index_ != other.index_; }
+
+        // Position in the table, see at_slot()
+        size_t slot() const { return index_; }
+
+    private:
+        friend class FlatHashMap;
+        Map* map_;
+        size_t index_;
+    };
+
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    explicit FlatHashMap(size_t capacity = 16) { rehash(slots_for(capacity)); }
+
+    iterator begin() { return iterator(this, next_occupied(0)); }
+    iterator end() { return iterator(this, slots_.size()); }
+    const_iterator begin() const { return const_iterator(this, next_occupied(0)); }
+    const_iterator end() const { return const_iterator(this, slots_.size()); }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    size_t bucket_count() const { return slots_.size(); }
+    size_t capacity() const { return max_load_; } // entries before a rehash
+
+    void reserve(size_t capacity) {
+        size_t slots = slots_for(capacity);
+        if (slots > slots_.size()) rehash(slots);
+    }
+
+    void clear() {
+        std::fill(dist_.begin(), dist_.end(), 0);
+        size_ = 0;
+    }
+
+    iterator find(const K& key) { return iterator(this, lookup(key)); }
+    const_iterator find(const K& key) const { return const_iterator(this, lookup(key)); }
+
+    std::pair<iterator, bool> emplace(const K& key, const V& value) {
+        size_t found = lookup(key);
+        if (found != slots_.size()) return {iterator(this, found), false};
+
+        if (size_ + 1 > max_load_) rehash(slots_.size() * 2);
+        return {iterator(this, insert(value_type(key, value))), true};
+    }
+
+    size_t erase(const K& key) {
+        size_t found = lookup(key);
+        if (found == slots_.size()) return 0;
+        erase_slot(found);
+        return 1;
+    }
+
+    void erase(iterator it) { erase_slot(it.index_); }
+
+    // The entry at a position from Iterator::slot(), nullptr if that slot is
+    // empty or out of range. Inserts and erases move entries (Robin Hood
+    // displacement, backward shift, rehash), so a position kept across them
+    // may now hold another entry or none: callers check the key.
+    value_type* at_slot(size_t slot) { return slot < dist_.size() && dist_[slot] != 0 ? &slots_[slot] : nullptr; }
+    const value_type* at_slot(size_t slot) const { return const_cast<FlatHashMap*>(this)->at_slot(slot); }
+
+    // Erases the entry at_slot(slot) returned non-null for
+    void erase_at(size_t slot) { erase_slot(slot); }
+
+private:
+    static constexpr uint8_t MAX_DIST = 255;
+
+    std::vector<value_type, CacheAlignedAllocator<value_type>> slots_;
+    std::vector<uint8_t, CacheAlignedAllocator<uint8_t>> dist_; // probe distance + 1, 0 = empty
+    size_t mask_ = 0;
+    int shift_ = 0;
+    size_t size_ = 0;
+    size_t max_load_ = 0;
+
+    // Power-of-two slot count keeping `capacity` entries under 7/8 load
+    static size_t slots_for(size_t capacity) {
+        return std::bit_ceil(std::max<size_t>(capacity + capacity / 7 + 1, 8));
+    }
+
+    // Fibonacci hashing: the multiply spreads sequential ids over the table
+    size_t home(const K& key) const {
+        uint64_t h = static_cast<uint64_t>(Hash{}(key)) * 0x9E3779B97F4A7C15ULL;
+        return static_cast<size_t>(h >> shift_);
+    }
+
+    size_t next_occupied(size_t i) const {
+        while (i < dist_.size() && dist_[i] == 0) ++i;
+        return i;
+    }
+
+    size_t lookup(const K& key) const {
+        size_t i = home(key);
+        for (uint32_t d = 1;; ++d) {
+            // a resident closer to home than we are means the key is absent
+            if (dist_[i] < d) return slots_.size();
+            if (dist_[i] == d && slots_[i].first == key) return i;
+            i = (i + 1) & mask_;
+        }
+    }
+
+    // Robin Hood insert of a key known to be absent; returns its slot
+    size_t insert(value_type entry) {
+        size_t i = home(entry.first);
+        size_t placed = slots_.size();
+        K key = entry.first;
+        uint32_t d = 1;
+
+        while (true) {
+            if (dist_[i] == 0) {
+                slots_[i] = std::move(entry);
+                dist_[i] = static_cast<uint8_t>(d);
+                ++size_;
+                return placed == slots_.size() ? i : placed;
+            }
+            if (dist_[i] < d) {
+                // steal from the richer resident and carry it forward
+                std::swap(entry, slots_[i]);
+                uint32_t resident = dist_[i];
+                dist_[i] = static_cast<uint8_t>(d);
+                d = resident;
+                if (placed == slots_.size()) placed = i;
+            }
+            i = (i + 1) & mask_;
+            if (++d == MAX_DIST) {
+                // pathological probe run: grow, place the carried entry, re-find the key
+                rehash(slots_.size() * 2);
+                insert(std::move(entry));
+                return lookup(key);
+            }
+        }
+    }
+
+    void erase_slot(size_t i) {
+        // backward shift: pull the following displaced entries one slot closer
+        size_t next = (i + 1) & mask_;
+        while (dist_[next] > 1) {
+            slots_[i] = std::move(slots_[next]);
+            dist_[i] = static_cast<uint8_t>(dist_[next] - 1);
+            i = next;
+            next = (next + 1) & mask_;
+        }
+        dist_[i] = 0;
+        --size_;
+    }
+
+    void rehash(size_t slots) {
+        decltype(slots_) old_slots(slots);
+        decltype(dist_) old_dist(slots, 0);
+        old_slots.swap(slots_);
+        old_dist.swap(dist_);
+
+        mask_ = slots - 1;
+        shift_ = 64 - std::countr_zero(slots);
+        max_load_ = slots - slots / 8;
+        size_ = 0;
+
+        for (size_t i = 0; i < old_slots.size(); ++i)
+            if (old_dist[i] != 0) insert(std::move(old_slots[i]));
+    }
+};
+
+} // namespace trading
@@ -1,98 +1,267 @@
 #pragma once
 #include "../core/market_data_handler.hpp"
 #include "config.hpp"
+#include "cpu.hpp"
+#include "tsc.hpp"
+#include <array>
+#include <atomic>
 #include <thread>
 #include <chrono>
 #include <random>
+#include <span>
 #include <vector>
 #include <cstring>
 #include <algorithm>
 
 namespace trading {
 
+// How send times are spaced at a target rate
+enum class Arrival {
+    Constant, // evenly spaced
+    Poisson,  // exponential gaps
+    Bursty    // `burst` messages back to back, then a gap keeping the average rate
+};
+
+struct FeedProfile {
+    uint64_t seed = 1;
+    size_t cycle = 1 << 16;        // messages pre-encoded; the feed then repeats
+    InstrumentId instrument = 0;
+
+    // order flow
+    Price mid = 10000;
+    Price tick_size = DEFAULT_TICK_SIZE;
+    double near_touch = 0.35;      // ticks behind the touch are geometric(near_touch)
+    double mid_drift = 0.002;      // chance per message that the mid moves a tick
+    std::array<unsigned, 4> mix{40, 45, 10, 5}; // add, cancel, modify, execute (%)
+    size_t max_live = 20000;       // adds become cancels above this many live orders
+
+    // pacing; rate 0 sends as fast as the handler accepts
+    Arrival arrival = Arrival::Poisson;
+    double rate = 1000;            // msgs/sec
+    size_t burst = 64;
+};
+
+// Seeded, reproducible open-loop load generator.
+//
+// One cycle of order flow and its send schedule are built up front: adds
+// cluster near the touch of a slowly drifting mid, and cancels, modifies and
+// executes only name live orders. Each cycle ends by cancelling what is still
+// live, so the feed can repeat without reusing a live id. Sending walks the
+// contiguous encoded buffer and calls push_raw_message at each scheduled
+// time; the schedule never slips to wait for the consumer (a full queue is
+// retried and the delay shows up as late messages), so the measured
+// latencies are not flattered by a generator that backs off.
 class FeedGenerator {
 public:
-    FeedGenerator(MarketDataHandler& handler)
-        : handler_(handler), stop_(false) {}
+    explicit FeedGenerator(MarketDataHandler& handler, const FeedProfile& profile = {})
+        : handler_(handler), profile_(profile) {
+        build();
+    }
+
+    ~FeedGenerator() { stop(); }
+
+    FeedGenerator(const FeedGenerator&) = delete;
+    FeedGenerator& operator=(const FeedGenerator&) = delete;
 
     void start() {
-        thread_ = std::thread(&FeedGenerator::run, this);
+        stop_.store(false, std::memory_order_relaxed);
+        thread_ = std::thread([this]() { drive(UINT64_MAX); });
     }
 
     void stop() {
-        stop_ = true;
+        stop_.store(true, std::memory_order_relaxed);
         if (thread_.joinable()) thread_.join();
     }
 
+    // Sends messages on the calling thread; returns when done
+    void run(uint64_t messages) {
+        stop_.store(false, std::memory_order_relaxed);
+        drive(messages);
+    }
+
+    // Encoded wire bytes of one cycle, and where each message starts
+    std::span<const uint8_t> bytes() const { return bytes_; }
+    std::span<const uint32_t> offsets() const { return {offsets_.data(), offsets_.size() - 1}; }
+    size_t cycle_length() const { return offsets_.size() - 1; }
+
+    // Any thread
+    uint64_t sent() const { return sent_.load(std::memory_order_relaxed); }
+    uint64_t retries() const { return retries_.load(std::memory_order_relaxed); } // queue full
+    uint64_t late() const { return late_.load(std::memory_order_relaxed); }       // sent > 1us behind schedule
+
 private:
+    // Longer waits sleep most of the way instead of spinning a core
+    static constexpr uint64_t SLEEP_ABOVE_NS = 200000;
+    static constexpr uint64_t LATE_NS = 1000;
+
+    struct Live {
+        OrderId id;
+        Side side;
+        Price price;
+        Quantity qty;
+    };
+
     MarketDataHandler& handler_;
+    FeedProfile profile_;
     std::thread thread_;
-    bool stop_;
-    std::vector<OrderId> activeOrders_; // track existing order IDs
+    std::atomic<bool> stop_{false};
+
+    std::vector<uint8_t> bytes_;
+    std::vector<uint32_t> offsets_; // plus end sentinel
+    std::vector<uint64_t> gaps_;    // TSC ticks before each message
 
-    void run() {
-        std::random_device rd;
-        std::mt19937 gen(rd());
+    std::atomic<uint64_t> sent_{0};
+    std::atomic<uint64_t> retries_{0};
+    std::atomic<uint64_t> late_{0};
 
-        std::uniform_int_distribution<uint64_t> id_dist(1, 1000000);
-        std::uniform_int_distribution<int> side_dist(0, 1); // 0=Buy,1=Sell
-        std::uniform_int_distribution<uint32_t> qty_dist(1, 100);
-        std::normal_distribution<double> price_dist(65, 20); // mid-market 65, sigma 20
-        std::uniform_int_distribution<int> action_dist(0, 99); // 0-99 for probability
+    void build() {
+        std::mt19937_64 gen(profile_.seed);
+        std::discrete_distribution<int> action(profile_.mix.begin(), profile_.mix.end());
+        std::geometric_distribution<int> behind(profile_.near_touch);
+        std::uniform_int_distribution<Quantity> qty_dist(1, 100);
+        std::uniform_real_distribution<double> unit(0.0, 1.0);
 
-        while (!stop_) {
-            int action = action_dist(gen);
-            std::vector<uint8_t> buffer(1);
+        std::vector<Live> live;
+        live.reserve(profile_.max_live + 1);
+        OrderId next_id = 1;
+        Price mid = profile_.mid;
+        Price tick = profile_.tick_size;
 
-            if (action < 50) { // AddOrder
-                AddOrderMsg msg{};
-                msg.orderId = id_dist(gen);
-                msg.side = static_cast<Side>(side_dist(gen));
+        bytes_.reserve(profile_.cycle * (MESSAGE_HEADER_SIZE + sizeof(AddOrderMsg)));
+        offsets_.reserve(profile_.cycle + profile_.max_live + 1);
 
-                msg.price = clamp_price(static_cast<Price>(price_dist(gen)));
-                msg.qty = qty_dist(gen);
+        auto emit = [&](const MarketMessage& msg) {
+            uint8_t frame[MESSAGE_HEADER_SIZE + sizeof(MarketMessage)];
+            size_t size = encode_message(msg, frame);
+            offsets_.push_back(static_cast<uint32_t>(bytes_.size()));
+            bytes_.insert(bytes_.end(), frame, frame + size);
+        };
+        auto remove = [&](size_t i) {
+            live[i] = live.back();
+            live.pop_back();
+        };
 
-                buffer.resize(1 + sizeof(AddOrderMsg));
-                buffer[0] = static_cast<uint8_t>(MessageType::AddOrder);
-                std::memcpy(buffer.data() + 1, &msg, sizeof(msg));
+        for (size_t n = 0; n < profile_.cycle; ++n) {
+            if (unit(gen) < profile_.mid_drift) mid += gen() % 2 ? tick : -tick;
 
-                activeOrders_.push_back(msg.orderId);
+            int kind = live.empty() ? 0 : action(gen);
+            if (kind == 0 && live.size() >= profile_.max_live) kind = 1;
+            size_t pick = live.empty() ? 0 : gen() % live.size();
+
+            MarketMessage msg{};
+            msg.instrument = profile_.instrument;
+            switch (kind) {
+                case 0: {
+                    Side side = gen() % 2 ? Side::Ask : Side::Bid;
+                    Price offset = (1 + behind(gen)) * tick;
+                    Price price = side == Side::Bid ? mid - offset : mid + offset;
+                    Live order{next_id++, side, std::max(price, tick), qty_dist(gen)};
+                    msg.type = MessageType::AddOrder;
+                    msg.add = {order.id, order.side, order.price, order.qty};
+                    live.push_back(order);
+                    break;
+                }
+                case 1:
+                    msg.type = MessageType::CancelOrder;
+                    msg.cancel = {live[pick].id};
+                    remove(pick);
+                    break;
+                case 2:
+                    live[pick].qty = qty_dist(gen);
+                    msg.type = MessageType::ModifyOrder;
+                    msg.modify = {live[pick].id, live[pick].qty};
+                    break;
+                default: {
+                    Quantity qty = std::min(qty_dist(gen), live[pick].qty);
+                    msg.type = MessageType::Execute;
+                    msg.execute = {live[pick].id, qty, live[pick].price};
+                    if ((live[pick].qty -= qty) == 0) remove(pick);
+                    break;
+                }
+            }
+            emit(msg);
+        }
+
+        // close the cycle: nothing stays live into the next lap
+        for (const Live& order : live) {
+            MarketMessage msg{};
+            msg.type = MessageType::CancelOrder;
+            msg.instrument = profile_.instrument;
+            msg.cancel = {order.id};
+            emit(msg);
+        }
+        offsets_.push_back(static_cast<uint32_t>(bytes_.size()));
 
-            } else if (action < 70 && !activeOrders_.empty()) { // CancelOrder
-                CancelOrderMsg msg{};
-                msg.orderId = activeOrders_[gen() % activeOrders_.size()];
+        build_schedule(gen);
+    }
 
-                buffer.resize(1 + sizeof(CancelOrderMsg));
-                buffer[0] = static_cast<uint8_t>(MessageType::CancelOrder);
-                std::memcpy(buffer.data() + 1, &msg, sizeof(msg));
+    template <typename Gen>
+    void build_schedule(Gen& gen) {
+        size_t n = offsets_.size() - 1;
+        gaps_.assign(n, 0);
+        if (profile_.rate <= 0) return;
 
-            } else if (action < 85 && !activeOrders_.empty()) { // ModifyOrder
-                ModifyOrderMsg msg{};
-                msg.orderId = activeOrders_[gen() % activeOrders_.size()];
-                msg.newQty = qty_dist(gen);
+        double period = TscClock::instance().ticks_per_ns() * 1e9 / profile_.rate;
+        std::exponential_distribution<double> exponential(1.0);
+        size_t burst = std::max<size_t>(1, profile_.burst);
+        for (size_t i = 0; i < n; ++i) {
+            switch (profile_.arrival) {
+                case Arrival::Constant: gaps_[i] = static_cast<uint64_t>(period); break;
+                case Arrival::Poisson: gaps_[i] = static_cast<uint64_t>(period * exponential(gen)); break;
+                case Arrival::Bursty: gaps_[i] = i % burst == 0 ? static_cast<uint64_t>(period * burst) : 0; break;
+            }
+        }
+    }
 
-                buffer.resize(1 + sizeof(ModifyOrderMsg));
-                buffer[0] = static_cast<uint8_t>(MessageType::ModifyOrder);
-                std::memcpy(buffer.data() + 1, &msg, sizeof(msg));
+    void wait_until(uint64_t due, uint64_t sleep_above) {
+        uint64_t now = tsc_now();
+        if (due > now + sleep_above) {
+            const TscClock& clock = TscClock::instance();
+            std::this_thread::sleep_for(std::chrono::nanoseconds(clock.to_ns(due - now - sleep_above / 2)));
+        }
+        while (tsc_now() < due) cpu_relax();
+    }
 
-            } else if (!activeOrders_.empty()) { // Execute
-                ExecuteMsg msg{};
-                msg.orderId = activeOrders_[gen() % activeOrders_.size()];
-                msg.qty = qty_dist(gen);
+    void drive(uint64_t limit) {
+        const TscClock& clock = TscClock::instance();
+        uint64_t sleep_above = static_cast<uint64_t>(SLEEP_ABOVE_NS * clock.ticks_per_ns());
+        uint64_t late_ticks = static_cast<uint64_t>(LATE_NS * clock.ticks_per_ns());
+        bool paced = profile_.rate > 0;
 
-                msg.price = clamp_price(static_cast<Price>(price_dist(gen)));
+        // counters go out every 1024 messages, not per message
+        uint64_t sent = 0, retries = 0, late = 0;
+        uint64_t base_sent = sent_.load(std::memory_order_relaxed);
+        uint64_t base_retries = retries_.load(std::memory_order_relaxed);
+        uint64_t base_late = late_.load(std::memory_order_relaxed);
+        auto publish = [&]() {
+            sent_.store(base_sent + sent, std::memory_order_relaxed);
+            retries_.store(base_retries + retries, std::memory_order_relaxed);
+            late_.store(base_late + late, std::memory_order_relaxed);
+        };
 
-                buffer.resize(1 + sizeof(ExecuteMsg));
-                buffer[0] = static_cast<uint8_t>(MessageType::Execute);
-                std::memcpy(buffer.data() + 1, &msg, sizeof(msg));
+        size_t n = offsets_.size() - 1;
+        size_t i = sent_.load(std::memory_order_relaxed) % n; // carry on where the last run stopped
+        uint64_t due = tsc_now();
+        while (sent < limit && !stop_.load(std::memory_order_relaxed)) {
+            if (paced) {
+                due += gaps_[i];
+                wait_until(due, sleep_above);
             }
 
-            // Push message to handler
-            handler_.push_raw_message(buffer.data(), buffer.size());
+            const uint8_t* msg = bytes_.data() + offsets_[i];
+            size_t size = offsets_[i + 1] - offsets_[i];
+            bool pushed;
+            while (!(pushed = handler_.push_raw_message(msg, size)) && !stop_.load(std::memory_order_relaxed)) {
+                ++retries;
+                cpu_relax();
+            }
+            if (!pushed) break;
+            if (paced && tsc_now() > due + late_ticks) ++late;
 
-            // Simulate rate variability
-            std::this_thread::sleep_for(std::chrono::microseconds(500 + (gen() % 1000)));
+            if (++i == n) i = 0;
+            if ((++sent & 1023) == 0) publish();
         }
+        publish();
     }
 };
 
@@ -0,0 +1,170 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <iomanip>
+#include <memory>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace trading {
+
+// HDR-style log-linear latency histogram over the full uint64 range.
+//
+// Values below 128 get exact buckets; above that, each power of two is split
+// into 64 linear sub-buckets, so any recorded value is reported within
+// 1/64 (~1.6%) of its true value. Recording is a count-leading-zeros, a
+// shift and an increment; memory is fixed (~30 KB) and never grows.
+class LatencyHistogram {
+public:
+    static constexpr int SUB_BITS = 7;
+    static constexpr uint64_t SUB_COUNT = 1ULL << SUB_BITS;  // exact range
+    static constexpr uint64_t HALF_COUNT = SUB_COUNT / 2;    // sub-buckets per power of two
+    static constexpr size_t BUCKETS = (64 - SUB_BITS + 1) * HALF_COUNT + HALF_COUNT;
+
+    LatencyHistogram() : counts_(BUCKETS, 0) {}
+
+    void record(uint64_t value, uint64_t count = 1) {
+        counts_[index_of(value)] += count;
+        total_ += count;
+        sum_ += value * count;
+        min_ = std::min(min_, value);
+        max_ = std::max(max_, value);
+    }
+
+    void merge(const LatencyHistogram& other) {
+        for (size_t i = 0; i < BUCKETS; ++i) counts_[i] += other.counts_[i];
+        total_ += other.total_;
+        sum_ += other.sum_;
+        min_ = std::min(min_, other.min_);
+        max_ = std::max(max_, other.max_);
+    }
+
+    // Adds raw per-bucket counts (BUCKETS entries) with their exact sum/min/max
+    void add_buckets(const uint64_t* counts, uint64_t sum, uint64_t min, uint64_t max) {
+        uint64_t added = 0;
+        for (size_t i = 0; i < BUCKETS; ++i) {
+            counts_[i] += counts[i];
+            added += counts[i];
+        }
+        if (added == 0) return;
+        total_ += added;
+        sum_ += sum;
+        min_ = std::min(min_, min);
+        max_ = std::max(max_, max);
+    }
+
+    void reset() {
+        std::fill(counts_.begin(), counts_.end(), 0);
+        total_ = sum_ = max_ = 0;
+        min_ = UINT64_MAX;
+    }
+
+    uint64_t count() const { return total_; }
+    uint64_t min() const { return total_ ? min_ : 0; }
+    uint64_t max() const { return max_; }
+    double mean() const { return total_ ? double(sum_) / total_ : 0.0; }
+
+    // Smallest recorded value v such that percent% of values are <= v
+    // (to bucket precision)
+    uint64_t percentile(double percent) const {
+        if (total_ == 0) return 0;
+        auto rank = static_cast<uint64_t>(percent / 100.0 * total_ + 0.5);
+        rank = std::clamp<uint64_t>(rank, 1, total_);
+
+        uint64_t seen = 0;
+        for (size_t i = 0; i < BUCKETS; ++i) {
+            seen += counts_[i];
+            if (seen >= rank) return std::clamp(highest_in(i), min_, max_);
+        }
+        return max_;
+    }
+
+    // Human-readable summary, same layout as the other benchmarks
+    void print(std::ostream& out, const std::string& name, const char* unit = "ns") const {
+        out << name << std::endl;
+        out << "  count:   " << std::setw(10) << total_ << std::endl;
+        out << "  mean:    " << std::setw(10) << std::fixed << std::setprecision(2) << mean()
+            << " " << unit << std::endl;
+        for (auto [label, p] : {std::pair{"p50:     ", 50.0}, {"p90:     ", 90.0},
+                                {"p99:     ", 99.0}, {"p99.9:   ", 99.9}, {"p99.99:  ", 99.99}})
+            out << "  " << label << std::setw(10) << percentile(p) << " " << unit << std::endl;
+        out << "  max:     " << std::setw(10) << max() << " " << unit << std::endl;
+        out << std::endl;
+    }
+
+    // {"count":..,"min":..,"mean":..,"p50":..,...,"max":..}
+    std::string to_json() const {
+        std::ostringstream out;
+        out << "{\"count\":" << total_ << ",\"min\":" << min() << ",\"mean\":" << std::fixed
+            << std::setprecision(2) << mean();
+        for (auto [label, p] : {std::pair{"p50", 50.0}, {"p90", 90.0}, {"p99", 99.0},
+                                {"p99.9", 99.9}, {"p99.99", 99.99}})
+            out << ",\"" << label << "\":" << percentile(p);
+        out << ",\"max\":" << max() << "}";
+        return out.str();
+    }
+
+    static size_t index_of(uint64_t value) {
+        // shift is 0 for the exact range, then one more per power of two
+        int msb = 63 - std::countl_zero(value | (SUB_COUNT - 1));
+        int shift = msb - (SUB_BITS - 1);
+        return (static_cast<size_t>(shift) << (SUB_BITS - 1)) + (value >> shift);
+    }
+
+private:
+    std::vector<uint64_t> counts_;
+    uint64_t total_ = 0;
+    uint64_t sum_ = 0;
+    uint64_t min_ = UINT64_MAX;
+    uint64_t max_ = 0;
+
+    static uint64_t highest_in(size_t index) {
+        if (index < SUB_COUNT) return index;
+        int shift = static_cast<int>(index / HALF_COUNT) - 1;
+        uint64_t sub = index - static_cast<uint64_t>(shift) * HALF_COUNT;
+        return ((sub + 1) << shift) - 1;
+    }
+};
+
+// Single-writer LatencyHistogram that other threads may read at any time.
+// Counts are relaxed atomics updated with plain load/store by the owner, so
+// recording needs no locked instructions; readers take a snapshot().
+class ConcurrentHistogram {
+public:
+    ConcurrentHistogram()
+        : counts_(std::make_unique<std::atomic<uint64_t>[]>(LatencyHistogram::BUCKETS)) {}
+
+    // Owner thread only
+    void record(uint64_t value) {
+        bump(counts_[LatencyHistogram::index_of(value)], 1);
+        bump(sum_, value);
+        if (value < min_.load(std::memory_order_relaxed)) min_.store(value, std::memory_order_relaxed);
+        if (value > max_.load(std::memory_order_relaxed)) max_.store(value, std::memory_order_relaxed);
+    }
+
+    // Any thread; may lag the owner by a few records
+    LatencyHistogram snapshot() const {
+        std::vector<uint64_t> counts(LatencyHistogram::BUCKETS);
+        for (size_t i = 0; i < counts.size(); ++i) counts[i] = counts_[i].load(std::memory_order_relaxed);
+        LatencyHistogram out;
+        out.add_buckets(counts.data(), sum_.load(std::memory_order_relaxed),
+                        min_.load(std::memory_order_relaxed), max_.load(std::memory_order_relaxed));
+        return out;
+    }
+
+private:
+    std::unique_ptr<std::atomic<uint64_t>[]> counts_;
+    std::atomic<uint64_t> sum_{0};
+    std::atomic<uint64_t> min_{UINT64_MAX};
+    std::atomic<uint64_t> max_{0};
+
+    static void bump(std::atomic<uint64_t>& a, uint64_t n) {
+        a.store(a.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+};
+
+} // namespace trading
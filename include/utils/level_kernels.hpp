@@ -0,0 +1,95 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace trading {
+
+// Scans over contiguous arrays of level quantities (int64, zero for empty
+// levels), used for depth queries on the price ladder. Built with AVX2
+// (e.g. -march=native on a Haswell or later) they add four levels per
+// instruction; otherwise the scalar loops below are used.
+namespace kernels {
+
+// Sum of q[0, n)
+inline int64_t sum(const int64_t* q, size_t n) {
+    size_t i = 0;
+    int64_t total = 0;
+#if defined(__AVX2__)
+    __m256i a = _mm256_setzero_si256();
+    __m256i b = _mm256_setzero_si256();
+    for (; i + 8 <= n; i += 8) {
+        a = _mm256_add_epi64(a, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(q + i)));
+        b = _mm256_add_epi64(b, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(q + i + 4)));
+    }
+    alignas(32) int64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), _mm256_add_epi64(a, b));
+    total = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#endif
+    for (; i < n; ++i) total += q[i];
+    return total;
+}
+
+// Levels of q[0, n) (all >= 0) taken whole before the running total would
+// reach target. Adds their quantity to filled and sum(i * q[i]) to weighted,
+// and returns their count: q[result] is the level that reaches target, or
+// result == n if none does.
+inline size_t take_below(const int64_t* q, size_t n, int64_t target, int64_t& filled, int64_t& weighted) {
+    size_t i = 0;
+    int64_t sum = 0;
+    int64_t w = 0;
+#if defined(__AVX2__)
+    // Per lane l, chunk c (level 4c + l): R sums q, and adding R to W before
+    // each chunk leaves sum_c(c * q) = (chunks - 1) * R - W, so the weighted
+    // sum needs no 64-bit multiplies (which AVX2 lacks).
+    __m256i r = _mm256_setzero_si256();
+    __m256i wv = _mm256_setzero_si256();
+    size_t chunks = 0;
+    alignas(32) int64_t lanes[4];
+    for (; i + 16 <= n; i += 16) {
+        const __m256i* p = reinterpret_cast<const __m256i*>(q + i);
+        __m256i c0 = _mm256_loadu_si256(p);
+        __m256i c1 = _mm256_loadu_si256(p + 1);
+        __m256i c2 = _mm256_loadu_si256(p + 2);
+        __m256i c3 = _mm256_loadu_si256(p + 3);
+
+        __m256i block = _mm256_add_epi64(_mm256_add_epi64(c0, c1), _mm256_add_epi64(c2, c3));
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), block);
+        int64_t block_sum = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+        if (sum + block_sum >= target) break;
+        sum += block_sum;
+
+        wv = _mm256_add_epi64(wv, r);
+        r = _mm256_add_epi64(r, c0);
+        wv = _mm256_add_epi64(wv, r);
+        r = _mm256_add_epi64(r, c1);
+        wv = _mm256_add_epi64(wv, r);
+        r = _mm256_add_epi64(r, c2);
+        wv = _mm256_add_epi64(wv, r);
+        r = _mm256_add_epi64(r, c3);
+        chunks += 4;
+    }
+    if (chunks > 0) {
+        alignas(32) int64_t rs[4];
+        alignas(32) int64_t ws[4];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(rs), r);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(ws), wv);
+        for (int l = 0; l < 4; ++l)
+            w += 4 * (static_cast<int64_t>(chunks - 1) * rs[l] - ws[l]) + l * rs[l];
+    }
+#endif
+    for (; i < n; ++i) {
+        if (sum + q[i] >= target) break;
+        sum += q[i];
+        w += static_cast<int64_t>(i) * q[i];
+    }
+    filled += sum;
+    weighted += w;
+    return i;
+}
+
+} // namespace kernels
+} // namespace trading
@@ -3,54 +3,99 @@
 #include <atomic>
 #include <cstddef>
 
+// SPSC ring of pointers.
+//
+// Indices grow monotonically and wrap with a mask, so all N slots are usable.
+// Producer and consumer indices live on separate cache lines, and each side
+// keeps a local copy of the other's index, re-reading the shared atomic only
+// when the copy says the ring is full (producer) or empty (consumer).
 template <typename T, size_t N>
 class LockFreeQueue {
+    static_assert(N > 0 && (N & (N - 1)) == 0, "capacity must be a power of two");
+
 public:
-    LockFreeQueue() : head_(0), tail_(0) {}
+    LockFreeQueue() = default;
+    LockFreeQueue(const LockFreeQueue&) = delete;
+    LockFreeQueue& operator=(const LockFreeQueue&) = delete;
 
     // Producer: push
     bool push(T* item) {
-        size_t next = (head_ + 1) % N;
+        size_t head = head_.load(std::memory_order_relaxed);
 
-        // Acquire ensures we see latest tail updated by consumer
-        if (next == tail_.load(std::memory_order_acquire)) return false; // full
+        if (head - tail_cache_ == N) {
+            // Acquire ensures we see the consumer is done with the slot
+            tail_cache_ = tail_.load(std::memory_order_acquire);
+            if (head - tail_cache_ == N) return false; // full
+        }
 
-        // Write the item
-        buffer_[head_] = item;
+        buffer_[head & MASK] = item;
 
-        // Release fence ensures item write is visible before updating head_
-        std::atomic_thread_fence(std::memory_order_release);
+        // Release makes the item visible before the new head
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
 
-        // Update head (plain is okay, producer only)
-        head_ = next;
+    // Producer: push up to n items with a single release; returns how many fit
+    size_t push_n(T* const* items, size_t n) {
+        size_t head = head_.load(std::memory_order_relaxed);
 
-        return true;
+        if (N - (head - tail_cache_) < n) tail_cache_ = tail_.load(std::memory_order_acquire);
+        size_t space = N - (head - tail_cache_);
+        if (n > space) n = space;
+
+        for (size_t i = 0; i < n; ++i) buffer_[(head + i) & MASK] = items[i];
+
+        head_.store(head + n, std::memory_order_release);
+        return n;
     }
 
     // Consumer: pop
     T* pop() {
-        // Read current tail
-        size_t current_tail = tail_.load(std::memory_order_relaxed);
+        size_t tail = tail_.load(std::memory_order_relaxed);
 
-        // Acquire fence ensures we see producer's write to buffer before reading
-        std::atomic_thread_fence(std::memory_order_acquire);
+        if (tail == head_cache_) {
+            // Acquire ensures we see the producer's write to the slot
+            head_cache_ = head_.load(std::memory_order_acquire);
+            if (tail == head_cache_) return nullptr; // empty
+        }
 
-        // Check if empty
-        if (current_tail == head_) return nullptr;
+        T* item = buffer_[tail & MASK];
 
-        // Read the item
-        T* item = buffer_[current_tail];
+        // Release hands the slot back to the producer
+        tail_.store(tail + 1, std::memory_order_release);
+        return item;
+    }
 
-        // Update tail (release ensures consumer progress visible to producer)
-        tail_.store((current_tail + 1) % N, std::memory_order_release);
+    // Consumer: pop up to max items with a single release; returns how many were read
+    size_t pop_n(T** out, size_t max) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
 
-        return item;
+        if (head_cache_ - tail < max) head_cache_ = head_.load(std::memory_order_acquire);
+        size_t available = head_cache_ - tail;
+        if (max > available) max = available;
+
+        for (size_t i = 0; i < max; ++i) out[i] = buffer_[(tail + i) & MASK];
+
+        tail_.store(tail + max, std::memory_order_release);
+        return max;
+    }
+
+    size_t size_approx() const {
+        return head_.load(std::memory_order_relaxed) - tail_.load(std::memory_order_relaxed);
     }
 
+    static constexpr size_t capacity() { return N; }
+
 private:
-    T* buffer_[N];
-    size_t head_;   // producer only
-    // tail is written by consumer, read by producer
-    // separate cache line to avoid false sharing
-    alignas(64) std::atomic<size_t> tail_; // consumer only
-};
\ No newline at end of file
+    static constexpr size_t MASK = N - 1;
+
+    // head is written by producer, tail by consumer; each on its own cache line
+    alignas(64) std::atomic<size_t> head_{0};
+    alignas(64) std::atomic<size_t> tail_{0};
+
+    // side-local copies of the remote index
+    alignas(64) size_t tail_cache_ = 0; // producer only
+    alignas(64) size_t head_cache_ = 0; // consumer only
+
+    alignas(64) std::array<T*, N> buffer_{};
+};
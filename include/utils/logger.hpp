@@ -1,12 +1,14 @@
 #pragma once
 #include <string>
 #include <vector>
+#include <deque>
 #include <mutex>
 #include <sstream>
 #include <iostream>
 #include <chrono>
 #include <iomanip>
 
+// Simple in-memory logger; see async_logger.hpp for hot-path logging
 class Logger {
 public:
     explicit Logger(size_t maxMessages = 1000)
@@ -23,13 +25,13 @@ public:
 
         std::lock_guard<std::mutex> lock(mutex_);
         if (messages_.size() >= maxMessages_)
-            messages_.erase(messages_.begin());
+            messages_.pop_front();
         messages_.push_back(oss.str());
     }
 
     std::vector<std::string> get_messages() const {
         std::lock_guard<std::mutex> lock(mutex_);
-        return messages_;
+        return {messages_.begin(), messages_.end()};
     }
 
     void print() const {
@@ -39,6 +41,6 @@ public:
 
 private:
     mutable std::mutex mutex_;
-    std::vector<std::string> messages_;
+    std::deque<std::string> messages_;
     size_t maxMessages_;
 };
@@ -1,25 +1,135 @@
 #pragma once
-#include <array>
+#include "telemetry.hpp"
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
 
+// Fixed-size object pool for the allocate-on-one-thread, free-on-another
+// pattern (e.g. feed thread allocates, book thread frees).
+//
+// The owner thread allocates and releases through a plain intrusive free
+// list, so the single-thread path is a pointer pop/push. Other threads return
+// objects through a lock-free list: a Cache collects frees locally and hands a
+// whole chain back with one CAS, and the owner takes the entire list with a
+// single exchange once its own list runs dry. Since nodes are only ever
+// removed all at once, there is no ABA problem.
+//
+// When both lists are empty the pool either grows by another slab of N
+// objects (growable) or returns nullptr; both events are counted.
 template <typename T, size_t N>
 class MemoryPool {
+    static_assert(N > 0, "slab must hold at least one object");
+
+    struct Node {
+        T value; // first, so a T* handed out converts straight back to its node
+        Node* next = nullptr;
+    };
+
 public:
-    MemoryPool() : freeCount(N) {
-        for (size_t i = 0; i < N; ++i) freeSlots_[i] = &storage[i];
-    }
+    explicit MemoryPool(bool growable = false) : growable_(growable) { add_slab(); }
+    MemoryPool(const MemoryPool&) = delete;
+    MemoryPool& operator=(const MemoryPool&) = delete;
 
+    // Owner thread: nullptr if exhausted and not growable
     T* allocate() {
-        if (freeCount == 0) return nullptr;
-        return freeSlots_[--freeCount];
+        if (!free_) {
+            free_ = remote_.exchange(nullptr, std::memory_order_acquire);
+            if (!free_) {
+                exhaustions_.store(exhaustions_.load(std::memory_order_relaxed) + 1,
+                                   std::memory_order_relaxed);
+                trading::telemetry::count(trading::telemetry::Counter::PoolExhausted);
+                if (!growable_) return nullptr;
+                add_slab();
+            }
+        }
+        Node* node = free_;
+        free_ = node->next;
+        return &node->value;
     }
 
+    // Owner thread
     void release(T* ptr) {
-        freeSlots_[freeCount++] = ptr;
+        Node* node = to_node(ptr);
+        node->next = free_;
+        free_ = node;
+    }
+
+    // Any thread: returns one object straight to the owner
+    void release_remote(T* ptr) {
+        Node* node = to_node(ptr);
+        push_remote(node, node);
     }
 
+    // Per-thread batch of remote frees, handed back every `batch` objects
+    // and on destruction.
+    class Cache {
+    public:
+        explicit Cache(MemoryPool& pool, size_t batch = 32) : pool_(pool), batch_(batch) {}
+        Cache(const Cache&) = delete;
+        Cache& operator=(const Cache&) = delete;
+        ~Cache() { flush(); }
+
+        void release(T* ptr) {
+            Node* node = to_node(ptr);
+            node->next = head_;
+            head_ = node;
+            if (!tail_) tail_ = node;
+            if (++count_ == batch_) flush();
+        }
+
+        void flush() {
+            if (!head_) return;
+            pool_.push_remote(head_, tail_);
+            head_ = tail_ = nullptr;
+            count_ = 0;
+        }
+
+    private:
+        MemoryPool& pool_;
+        size_t batch_;
+        Node* head_ = nullptr;
+        Node* tail_ = nullptr;
+        size_t count_ = 0;
+    };
+
+    // Times allocate found both free lists empty
+    uint64_t exhaustions() const { return exhaustions_.load(std::memory_order_relaxed); }
+    size_t slabs() const { return slabs_count_.load(std::memory_order_relaxed); }
+    size_t capacity() const { return slabs() * N; }
+
 private:
-    std::array<T, N> storage;
-    std::array<T*, N> freeSlots_;
-    size_t freeCount;
+    static Node* to_node(T* ptr) { return reinterpret_cast<Node*>(ptr); }
+
+    void push_remote(Node* first, Node* last) {
+        Node* head = remote_.load(std::memory_order_relaxed);
+        do {
+            last->next = head;
+        } while (!remote_.compare_exchange_weak(head, first, std::memory_order_release,
+                                                std::memory_order_relaxed));
+    }
+
+    // Owner thread: chains a fresh slab onto the local free list
+    void add_slab() {
+        auto slab = std::make_unique<Node[]>(N);
+        for (size_t i = N; i-- > 0;) {
+            slab[i].next = free_;
+            free_ = &slab[i];
+        }
+        slabs_.push_back(std::move(slab));
+        slabs_count_.store(slabs_.size(), std::memory_order_relaxed);
+    }
+
+    // owner only
+    Node* free_ = nullptr;
+    std::vector<std::unique_ptr<Node[]>> slabs_;
+    bool growable_;
+
+    // written by other threads
+    alignas(64) std::atomic<Node*> remote_{nullptr};
+
+    // written by the owner, sampled by anyone
+    alignas(64) std::atomic<uint64_t> exhaustions_{0};
+    std::atomic<size_t> slabs_count_{0};
 };
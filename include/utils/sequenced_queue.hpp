@@ -0,0 +1,134 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Bounded multi-producer ring with by-value slots (Vyukov-style).
+//
+// Each slot carries a sequence number saying whose turn it is: a slot at
+// position p is free for the producer of p when seq == p, holds a committed
+// item for the consumer of p when seq == p + 1, and is handed back for the
+// next lap by setting seq = p + N. Producers take positions with a CAS on the
+// write index; with MultiConsumer, consumers do the same on the read index,
+// otherwise the single consumer just advances it.
+//
+// Same claim/commit/consume/release interface as SlotQueue, except that slots
+// from different producers interleave, so every claimed slot must be
+// committed and every consumed slot released individually (BATCH_COMMIT is
+// false). A claimed slot that is not yet committed holds back the consumer.
+template <typename T, size_t N, bool MultiConsumer>
+class SequencedQueue {
+    static_assert(N > 0 && (N & (N - 1)) == 0, "capacity must be a power of two");
+
+public:
+    static constexpr bool BATCH_COMMIT = false;
+
+    SequencedQueue() {
+        for (size_t i = 0; i < N; ++i) slots_[i].seq.store(i, std::memory_order_relaxed);
+    }
+    SequencedQueue(const SequencedQueue&) = delete;
+    SequencedQueue& operator=(const SequencedQueue&) = delete;
+
+    // Producer: a free slot, nullptr if full. Not visible until committed.
+    T* claim() {
+        size_t pos = write_.load(std::memory_order_relaxed);
+        while (true) {
+            Slot& slot = slots_[pos & MASK];
+            size_t seq = slot.seq.load(std::memory_order_acquire);
+            auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (write_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    return &slot.value;
+            } else if (diff < 0) {
+                return nullptr; // the slot from the previous lap is still in use
+            } else {
+                pos = write_.load(std::memory_order_relaxed); // another producer took it
+            }
+        }
+    }
+
+    // Producer: publishes this slot
+    void commit(T* slot) {
+        Slot* s = to_slot(slot);
+        s->seq.store(s->seq.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // Consumer: next committed slot, nullptr if empty. Read it in place.
+    T* consume() {
+        size_t pos = read_.load(std::memory_order_relaxed);
+        while (true) {
+            Slot& slot = slots_[pos & MASK];
+            size_t seq = slot.seq.load(std::memory_order_acquire);
+            auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+            if (diff == 0) {
+                if constexpr (MultiConsumer) {
+                    if (read_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        return &slot.value;
+                } else {
+                    read_.store(pos + 1, std::memory_order_relaxed);
+                    return &slot.value;
+                }
+            } else if (diff < 0) {
+                return nullptr; // not yet committed
+            } else {
+                pos = read_.load(std::memory_order_relaxed); // another consumer took it
+            }
+        }
+    }
+
+    // Consumer: hands this slot back to the producers
+    void release(T* slot) {
+        Slot* s = to_slot(slot);
+        s->seq.store(s->seq.load(std::memory_order_relaxed) - 1 + N, std::memory_order_release);
+    }
+
+    // Copying convenience wrappers
+    bool push(const T& item) {
+        T* slot = claim();
+        if (!slot) return false;
+        *slot = item;
+        commit(slot);
+        return true;
+    }
+
+    bool pop(T& out) {
+        T* slot = consume();
+        if (!slot) return false;
+        out = *slot;
+        release(slot);
+        return true;
+    }
+
+    size_t size_approx() const {
+        size_t write = write_.load(std::memory_order_relaxed);
+        size_t read = read_.load(std::memory_order_relaxed);
+        return write > read ? write - read : 0;
+    }
+
+    static constexpr size_t capacity() { return N; }
+
+private:
+    static constexpr size_t MASK = N - 1;
+
+    // value first so a T* handed out converts straight back to its slot
+    struct alignas(64) Slot {
+        T value;
+        std::atomic<size_t> seq;
+    };
+
+    static Slot* to_slot(T* value) { return reinterpret_cast<Slot*>(value); }
+
+    // shared indices, one cache line each
+    alignas(64) std::atomic<size_t> write_{0}; // next position to claim
+    alignas(64) std::atomic<size_t> read_{0};  // next position to consume
+
+    Slot slots_[N];
+};
+
+// Several feed handlers into one book thread
+template <typename T, size_t N>
+using MpscQueue = SequencedQueue<T, N, false>;
+
+// Work distribution across several consumers
+template <typename T, size_t N>
+using MpmcQueue = SequencedQueue<T, N, true>;
@@ -0,0 +1,105 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace trading {
+
+// Stable reference into a Slab: the slot index plus the slot's generation
+// when the value was inserted. Eight bytes, trivially copyable.
+struct SlabHandle {
+    static constexpr uint32_t NIL = UINT32_MAX;
+
+    uint32_t index = NIL;
+    uint32_t generation = 0;
+
+    bool valid() const { return index != NIL; }
+    friend bool operator==(const SlabHandle&, const SlabHandle&) = default;
+};
+
+// Values in one contiguous vector of slots, addressed by SlabHandle.
+//
+// Freed slots go on an intrusive free list and are reused last-in first-out,
+// so a churning workload keeps touching the same warm slots. Each slot
+// carries a generation that is odd while it holds a value and is bumped on
+// insert and erase, so a handle to an erased value (or to whatever reused
+// its slot) no longer matches and get() returns nullptr instead of aliasing
+// the new value.
+//
+// Pointers from get() are invalidated by the next insert; handles are not.
+template <typename T>
+class Slab {
+public:
+    explicit Slab(size_t capacity = 0) { slots_.reserve(capacity); }
+
+    SlabHandle insert(const T& value) {
+        uint32_t index = free_;
+        if (index != SlabHandle::NIL) {
+            free_ = slots_[index].next_free;
+        } else {
+            index = static_cast<uint32_t>(slots_.size());
+            slots_.emplace_back();
+        }
+        Slot& slot = slots_[index];
+        slot.value = value;
+        ++slot.generation;
+        ++size_;
+        return {index, slot.generation};
+    }
+
+    // nullptr for a stale or null handle
+    T* get(SlabHandle handle) {
+        if (handle.index >= slots_.size()) return nullptr;
+        Slot& slot = slots_[handle.index];
+        return slot.generation == handle.generation ? &slot.value : nullptr;
+    }
+
+    const T* get(SlabHandle handle) const { return const_cast<Slab*>(this)->get(handle); }
+
+    // handle must be live
+    void erase(SlabHandle handle) {
+        Slot& slot = slots_[handle.index];
+        ++slot.generation;
+        slot.next_free = free_;
+        free_ = handle.index;
+        --size_;
+    }
+
+    // Every outstanding handle goes stale
+    void clear() {
+        free_ = SlabHandle::NIL;
+        for (size_t i = slots_.size(); i-- > 0;) {
+            Slot& slot = slots_[i];
+            if (slot.generation & 1) ++slot.generation;
+            slot.next_free = free_;
+            free_ = static_cast<uint32_t>(i);
+        }
+        size_ = 0;
+    }
+
+    void reserve(size_t capacity) { slots_.reserve(capacity); }
+    size_t size() const { return size_; }
+    size_t capacity() const { return slots_.capacity(); }
+
+    // Calls fn(handle, value) for every live value, in slot order
+    template <typename Fn>
+    void for_each(Fn&& fn) const {
+        for (size_t i = 0; i < slots_.size(); ++i) {
+            const Slot& slot = slots_[i];
+            if (slot.generation & 1) fn(SlabHandle{static_cast<uint32_t>(i), slot.generation}, slot.value);
+        }
+    }
+
+private:
+    struct Slot {
+        T value{};
+        uint32_t generation = 0; // odd while live
+        uint32_t next_free = SlabHandle::NIL;
+    };
+
+    std::vector<Slot> slots_;
+    uint32_t free_ = SlabHandle::NIL;
+    size_t size_ = 0;
+};
+
+} // namespace trading
@@ -0,0 +1,97 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+
+// SPSC ring that stores items by value in cache-line aligned slots.
+//
+// The producer claims slots and fills them in place, then commits; the
+// consumer reads slots in place, then releases them. Several claims (or
+// consumes) can be published with one commit (or release), so a batch costs a
+// single release store. Each side keeps a cached copy of the other side's
+// index and only re-reads the shared atomic when the cache says full/empty.
+template <typename T, size_t N>
+class SlotQueue {
+    static_assert(N > 0 && (N & (N - 1)) == 0, "capacity must be a power of two");
+
+public:
+    // commit(last) publishes every slot claimed so far
+    static constexpr bool BATCH_COMMIT = true;
+
+    SlotQueue() = default;
+    SlotQueue(const SlotQueue&) = delete;
+    SlotQueue& operator=(const SlotQueue&) = delete;
+
+    // Producer: next free slot, nullptr if full. Not visible until committed.
+    T* claim() {
+        if (claim_ - read_cache_ == N) {
+            read_cache_ = read_.load(std::memory_order_acquire);
+            if (claim_ - read_cache_ == N) return nullptr;
+        }
+        return &slots_[claim_++ & MASK].value;
+    }
+
+    // Producer: publishes all claimed slots up to and including last
+    void commit(T* last) {
+        (void)last;
+        write_.store(claim_, std::memory_order_release);
+    }
+
+    // Consumer: next committed slot, nullptr if empty. Read it in place.
+    T* consume() {
+        if (consume_ == write_cache_) {
+            write_cache_ = write_.load(std::memory_order_acquire);
+            if (consume_ == write_cache_) return nullptr;
+        }
+        return &slots_[consume_++ & MASK].value;
+    }
+
+    // Consumer: hands all consumed slots up to and including last back to the producer
+    void release(T* last) {
+        (void)last;
+        read_.store(consume_, std::memory_order_release);
+    }
+
+    // Copying convenience wrappers
+    bool push(const T& item) {
+        T* slot = claim();
+        if (!slot) return false;
+        *slot = item;
+        commit(slot);
+        return true;
+    }
+
+    bool pop(T& out) {
+        T* slot = consume();
+        if (!slot) return false;
+        out = *slot;
+        release(slot);
+        return true;
+    }
+
+    size_t size_approx() const {
+        return write_.load(std::memory_order_relaxed) - read_.load(std::memory_order_relaxed);
+    }
+
+    static constexpr size_t capacity() { return N; }
+
+private:
+    static constexpr size_t MASK = N - 1;
+
+    struct alignas(64) Slot {
+        T value;
+    };
+
+    // shared indices, one cache line each
+    alignas(64) std::atomic<size_t> write_{0}; // published by producer
+    alignas(64) std::atomic<size_t> read_{0};  // published by consumer
+
+    // producer only
+    alignas(64) size_t claim_ = 0;             // next slot to claim
+    size_t read_cache_ = 0;                    // producer's view of read_
+
+    // consumer only
+    alignas(64) size_t consume_ = 0;           // next slot to consume
+    size_t write_cache_ = 0;                   // consumer's view of write_
+
+    Slot slots_[N];
+};
@@ -0,0 +1,230 @@
+#pragma once
+#include "histogram.hpp"
+#include "tsc.hpp"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace trading::telemetry {
+
+// Optional hot-path instrumentation, compiled in with TRADING_TELEMETRY
+// (cmake -DTRADING_TELEMETRY=ON).
+//
+// Messages carry TSC stamps taken at ingest, enqueue and dequeue; when a
+// message has been applied its stage latencies go into histograms owned by
+// the thread that recorded them, so recording never touches another core's
+// cache lines. A monitoring thread reads everything with snapshot().
+//
+// Compiled out, every hook below is an empty inline and MarketMessage has no
+// stamps member, so the hot path is unchanged.
+#ifdef TRADING_TELEMETRY
+constexpr bool ENABLED = true;
+#else
+constexpr bool ENABLED = false;
+#endif
+
+// TSC ticks, 0 until stamped
+struct MessageStamps {
+    uint64_t ingest = 0;
+    uint64_t enqueue = 0;
+    uint64_t dequeue = 0;
+};
+
+enum class Stage : uint8_t {
+    Decode,     // ingest -> enqueue (producer thread)
+    QueueDwell, // enqueue -> dequeue
+    Apply,      // dequeue -> book update done
+    WireToBook, // ingest -> book update done
+};
+constexpr size_t STAGE_COUNT = 4;
+
+enum class Counter : uint8_t {
+    Messages,         // messages applied
+    QueueFull,        // messages dropped for lack of a queue slot
+    PoolExhausted,    // MemoryPool allocations that found no free node
+    BestPriceRescans, // best level emptied, ladder rescanned
+};
+constexpr size_t COUNTER_COUNT = 4;
+
+inline const char* stage_name(Stage stage) {
+    constexpr const char* NAMES[STAGE_COUNT] = {"decode", "queue_dwell", "apply", "wire_to_book"};
+    return NAMES[static_cast<size_t>(stage)];
+}
+
+inline const char* counter_name(Counter counter) {
+    constexpr const char* NAMES[COUNTER_COUNT] = {"messages", "queue_full", "pool_exhausted",
+                                                  "best_price_rescans"};
+    return NAMES[static_cast<size_t>(counter)];
+}
+
+// Stats of one thread. Written only by that thread, read by snapshot().
+struct ThreadStats {
+    std::string name;
+    std::array<ConcurrentHistogram, STAGE_COUNT> stages; // ns
+    ConcurrentHistogram queue_depth;                     // messages, sampled on dequeue
+    std::array<std::atomic<uint64_t>, COUNTER_COUNT> counters{};
+};
+
+// Read-side copy of one thread's stats
+struct ThreadSnapshot {
+    std::string name;
+    std::array<LatencyHistogram, STAGE_COUNT> stages;
+    LatencyHistogram queue_depth;
+    std::array<uint64_t, COUNTER_COUNT> counters{};
+
+    const LatencyHistogram& stage(Stage s) const { return stages[static_cast<size_t>(s)]; }
+    uint64_t counter(Counter c) const { return counters[static_cast<size_t>(c)]; }
+
+    void merge(const ThreadSnapshot& other) {
+        for (size_t i = 0; i < STAGE_COUNT; ++i) stages[i].merge(other.stages[i]);
+        queue_depth.merge(other.queue_depth);
+        for (size_t i = 0; i < COUNTER_COUNT; ++i) counters[i] += other.counters[i];
+    }
+};
+
+struct Snapshot {
+    std::vector<ThreadSnapshot> threads;
+
+    // All threads merged
+    ThreadSnapshot total() const {
+        ThreadSnapshot sum;
+        sum.name = "total";
+        for (const ThreadSnapshot& t : threads) sum.merge(t);
+        return sum;
+    }
+
+    // Counters and non-empty histograms, all threads merged
+    void print(std::ostream& out) const {
+        ThreadSnapshot sum = total();
+        out << "Telemetry (" << threads.size() << " threads)" << std::endl;
+        for (size_t i = 0; i < COUNTER_COUNT; ++i)
+            out << "  " << counter_name(static_cast<Counter>(i)) << ": " << sum.counters[i] << std::endl;
+        out << std::endl;
+        for (size_t i = 0; i < STAGE_COUNT; ++i)
+            if (sum.stages[i].count())
+                sum.stages[i].print(out, std::string("Stage ") + stage_name(static_cast<Stage>(i)));
+        if (sum.queue_depth.count()) sum.queue_depth.print(out, "Queue depth at dequeue", "msgs");
+    }
+};
+
+namespace detail {
+
+// Owns every thread's stats, so they outlive their threads for reporting
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ThreadStats>> threads;
+
+    static Registry& instance() {
+        static Registry registry;
+        return registry;
+    }
+};
+
+inline ThreadStats* register_thread() {
+    Registry& registry = Registry::instance();
+    std::lock_guard lock(registry.mutex);
+    registry.threads.push_back(std::make_unique<ThreadStats>());
+    registry.threads.back()->name = "thread " + std::to_string(registry.threads.size() - 1);
+    return registry.threads.back().get();
+}
+
+// Registered on first use by each thread
+inline ThreadStats& local() {
+    thread_local ThreadStats* stats = register_thread();
+    return *stats;
+}
+
+inline void bump(std::atomic<uint64_t>& counter, uint64_t n) {
+    counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+inline void record(Stage stage, uint64_t from, uint64_t to) {
+    // stamps from different cores can be a few ticks out of order
+    uint64_t ticks = to > from ? to - from : 0;
+    local().stages[static_cast<size_t>(stage)].record(TscClock::instance().to_ns(ticks));
+}
+
+} // namespace detail
+
+// Labels the calling thread in snapshots
+inline void set_thread_name(const std::string& name) {
+    if constexpr (ENABLED) {
+        ThreadStats& stats = detail::local();
+        std::lock_guard lock(detail::Registry::instance().mutex);
+        stats.name = name;
+    }
+}
+
+inline void count(Counter counter, uint64_t n = 1) {
+    if constexpr (ENABLED) detail::bump(detail::local().counters[static_cast<size_t>(counter)], n);
+}
+
+// Raw TSC stamp, 0 when compiled out
+inline uint64_t stamp() {
+    if constexpr (ENABLED) return tsc_now();
+    else return 0;
+}
+
+// The hooks below take the message as a template parameter so that, compiled
+// out, the stamps member they touch is never named.
+
+// Producer, just before publishing msg; ingest came from stamp() on arrival
+template <typename Message>
+inline void on_enqueue(Message& msg, uint64_t ingest) {
+    if constexpr (ENABLED) {
+        uint64_t now = tsc_now();
+        msg.stamps.ingest = ingest;
+        msg.stamps.enqueue = now;
+        detail::record(Stage::Decode, ingest, now);
+    }
+}
+
+// Consumer, right after taking msg from queue
+template <typename Message, typename Queue>
+inline void on_dequeue(Message& msg, const Queue& queue) {
+    if constexpr (ENABLED) {
+        uint64_t now = tsc_now();
+        msg.stamps.dequeue = now;
+        detail::record(Stage::QueueDwell, msg.stamps.enqueue, now);
+        detail::local().queue_depth.record(queue.size_approx());
+    }
+}
+
+// Consumer, once msg has been applied and before its slot is released
+template <typename Message>
+inline void on_applied(const Message& msg) {
+    if constexpr (ENABLED) {
+        uint64_t now = tsc_now();
+        detail::record(Stage::Apply, msg.stamps.dequeue, now);
+        detail::record(Stage::WireToBook, msg.stamps.ingest, now);
+        count(Counter::Messages);
+    }
+}
+
+// Monitoring thread: copies every registered thread's stats. Values may lag
+// their writers by a few records. Empty when compiled out.
+inline Snapshot snapshot() {
+    Snapshot out;
+    if constexpr (ENABLED) {
+        detail::Registry& registry = detail::Registry::instance();
+        std::lock_guard lock(registry.mutex);
+        out.threads.reserve(registry.threads.size());
+        for (const auto& stats : registry.threads) {
+            ThreadSnapshot& t = out.threads.emplace_back();
+            t.name = stats->name;
+            for (size_t i = 0; i < STAGE_COUNT; ++i) t.stages[i] = stats->stages[i].snapshot();
+            t.queue_depth = stats->queue_depth.snapshot();
+            for (size_t i = 0; i < COUNTER_COUNT; ++i)
+                t.counters[i] = stats->counters[i].load(std::memory_order_relaxed);
+        }
+    }
+    return out;
+}
+
+} // namespace trading::telemetry
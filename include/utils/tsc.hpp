@@ -0,0 +1,57 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace trading {
+
+// Raw cycle counter: rdtsc on x86, the virtual counter on aarch64, a
+// steady_clock fallback elsewhere. Cheap enough to stamp every message;
+// convert with TscClock.
+inline uint64_t tsc_now() {
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+    return __rdtsc();
+#elif defined(__aarch64__)
+    uint64_t ticks;
+    asm volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+    return ticks;
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+// Tick rate calibrated once against steady_clock (assumes an invariant TSC,
+// as on any recent x86 or ARM server)
+class TscClock {
+public:
+    static const TscClock& instance() {
+        static const TscClock clock;
+        return clock;
+    }
+
+    double ns_per_tick() const { return ns_per_tick_; }
+    double ticks_per_ns() const { return 1.0 / ns_per_tick_; }
+
+    uint64_t to_ns(uint64_t ticks) const { return static_cast<uint64_t>(ticks * ns_per_tick_); }
+
+private:
+    double ns_per_tick_;
+
+    TscClock() {
+        auto start = std::chrono::steady_clock::now();
+        uint64_t start_ticks = tsc_now();
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        auto end = std::chrono::steady_clock::now();
+        uint64_t end_ticks = tsc_now();
+
+        double ns = std::chrono::duration<double, std::nano>(end - start).count();
+        ns_per_tick_ = end_ticks > start_ticks ? ns / (end_ticks - start_ticks) : 1.0;
+    }
+};
+
+} // namespace trading
@@ -0,0 +1,104 @@
+#include "../../include/core/book_manager.hpp"
+#include "../../include/utils/cpu.hpp"
+
+namespace trading {
+
+BookManager::BookManager(size_t num_shards, const BookConfig& book_config, int first_core)
+    : book_config_(book_config), first_core_(first_core) {
+    shards_.reserve(num_shards);
+    for (size_t i = 0; i < num_shards; ++i) shards_.push_back(std::make_unique<Shard>());
+}
+
+BookManager::~BookManager() {
+    stop();
+}
+
+void BookManager::add_instrument(InstrumentId id) {
+    shards_[shard_of(id)]->instruments.push_back(id);
+}
+
+void BookManager::start() {
+    if (running_.exchange(true)) return;
+
+    int cores = static_cast<int>(num_cores());
+    for (size_t i = 0; i < shards_.size(); ++i) {
+        int core = (first_core_ + static_cast<int>(i)) % cores;
+        shards_[i]->thread = std::thread(&BookManager::run, this, std::ref(*shards_[i]), core);
+    }
+}
+
+void BookManager::stop() {
+    if (!running_.exchange(false)) return;
+
+    for (auto& shard : shards_)
+        if (shard->thread.joinable()) shard->thread.join();
+}
+
+bool BookManager::push_raw_message(const uint8_t* buffer, size_t size) {
+    if (size < MESSAGE_HEADER_SIZE) return false;
+
+    InstrumentId instrument;
+    std::memcpy(&instrument, buffer + sizeof(MessageType), sizeof(InstrumentId));
+    return shards_[shard_of(instrument)]->handler.push_raw_message(buffer, size);
+}
+
+uint64_t BookManager::processed() const {
+    uint64_t total = 0;
+    for (auto& shard : shards_) total += shard->processed.load(std::memory_order_relaxed);
+    return total;
+}
+
+uint64_t BookManager::unknown() const {
+    uint64_t total = 0;
+    for (auto& shard : shards_) total += shard->unknown.load(std::memory_order_relaxed);
+    return total;
+}
+
+const OrderBook* BookManager::book(InstrumentId id) const {
+    const Shard& shard = *shards_[shard_of(id)];
+    auto it = shard.index.find(id);
+    return it == shard.index.end() ? nullptr : shard.books[it->second].get();
+}
+
+void BookManager::run(Shard& shard, int core) {
+    pin_current_thread(core);
+    telemetry::set_thread_name("shard " + std::to_string(&shard - shards_.front().get()));
+
+    // Build the books on the owning thread so their memory is first touched
+    // (and placed) on this core's NUMA node
+    shard.index.reserve(shard.instruments.size());
+    for (InstrumentId id : shard.instruments) {
+        if (!shard.index.emplace(id, static_cast<uint32_t>(shard.books.size())).second) continue;
+        shard.books.push_back(std::make_unique<OrderBook>(book_config_));
+    }
+
+    uint64_t processed = shard.processed.load(std::memory_order_relaxed);
+    uint64_t unknown = shard.unknown.load(std::memory_order_relaxed);
+
+    auto apply = [&](MarketMessage* msg) {
+        telemetry::on_dequeue(*msg, shard.queue);
+        auto it = shard.index.find(msg->instrument);
+        if (it != shard.index.end()) apply_message(*shard.books[it->second], *msg);
+        else unknown++;
+        telemetry::on_applied(*msg);
+        shard.queue.release(msg);
+
+        // single writer: a relaxed store is enough for readers to sample
+        shard.processed.store(++processed, std::memory_order_relaxed);
+        shard.unknown.store(unknown, std::memory_order_relaxed);
+    };
+
+    while (running_.load(std::memory_order_relaxed)) {
+        MarketMessage* msg = shard.queue.consume();
+        if (!msg) {
+            cpu_relax();
+            continue;
+        }
+        apply(msg);
+    }
+
+    // Drain remaining messages
+    while (MarketMessage* msg = shard.queue.consume()) apply(msg);
+}
+
+} // namespace trading
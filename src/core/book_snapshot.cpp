@@ -0,0 +1,98 @@
+#include "../../include/core/book_snapshot.hpp"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace trading {
+
+SnapshotWriter::SnapshotWriter(const std::string& path) : path_(path), tmp_path_(path + ".tmp") {
+    // written aside, so the previous snapshot survives a failure
+    file_ = std::fopen(tmp_path_.c_str(), "wb");
+    ok_ = file_ != nullptr;
+}
+
+SnapshotWriter::~SnapshotWriter() {
+    if (!file_) return;
+    std::fclose(file_);
+    std::remove(tmp_path_.c_str());
+}
+
+bool SnapshotWriter::write(const void* data, size_t size) {
+    if (ok_ && size > 0) ok_ = std::fwrite(data, 1, size, file_) == size;
+    return ok_;
+}
+
+bool SnapshotWriter::commit() {
+    if (!file_) return false;
+    bool ok = ok_ && std::fflush(file_) == 0 && ::fsync(::fileno(file_)) == 0;
+    ok = std::fclose(file_) == 0 && ok;
+    file_ = nullptr;
+    if (ok) ok = std::rename(tmp_path_.c_str(), path_.c_str()) == 0;
+    if (!ok) std::remove(tmp_path_.c_str());
+    return ok;
+}
+
+SnapshotMapping::SnapshotMapping(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return;
+
+    struct stat st;
+    if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+        void* mapped = ::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped != MAP_FAILED) {
+            ::madvise(mapped, st.st_size, MADV_SEQUENTIAL);
+            data_ = static_cast<const uint8_t*>(mapped);
+            size_ = st.st_size;
+        }
+    }
+    ::close(fd);
+}
+
+SnapshotMapping::~SnapshotMapping() {
+    if (data_) ::munmap(const_cast<uint8_t*>(data_), size_);
+}
+
+BookCheckpointer::BookCheckpointer(std::string path, const BookConfig& config)
+    : path_(std::move(path)), replica_(config), queue_(std::make_unique<Queue>()),
+      loop_(*queue_, BlockingWait(wakeup_)) {
+    if (auto sequence = replica_.load_snapshot(path_)) {
+        start_sequence_ = applied_sequence_ = *sequence;
+        checkpoint_sequence_.store(*sequence, std::memory_order_relaxed);
+    }
+    loop_.start([this](Entry& entry) { handle(entry); });
+}
+
+BookCheckpointer::~BookCheckpointer() {
+    loop_.stop();
+}
+
+bool BookCheckpointer::checkpoint() {
+    // a marker that does not fit loses nothing; the caller can retry
+    Entry* entry = lost_ ? nullptr : queue_->claim();
+    if (!entry) return false;
+    entry->sequence = 0;
+    entry->checkpoint = true;
+    queue_->commit(entry);
+    wakeup_.notify();
+    return true;
+}
+
+void BookCheckpointer::handle(const Entry& entry) {
+    if (!entry.checkpoint) {
+        apply_message(replica_, entry.msg);
+        applied_sequence_ = entry.sequence;
+        return;
+    }
+
+    // entries arrive in order, so the replica is exact here even if the ring
+    // overflowed after this marker
+    if (replica_.save_snapshot(path_, applied_sequence_)) {
+        checkpoint_sequence_.store(applied_sequence_, std::memory_order_release);
+        checkpoints_.fetch_add(1, std::memory_order_release);
+    } else {
+        failures_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+} // namespace trading
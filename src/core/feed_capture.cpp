@@ -0,0 +1,115 @@
+#include "../../include/core/feed_capture.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace trading {
+
+uint64_t capture_timestamp_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+CaptureWriter::CaptureWriter(const std::string& path, size_t buffer_size)
+    : buffer_(std::max(buffer_size, CAPTURE_FRAME_HEADER_SIZE + 64)) {
+    file_ = std::fopen(path.c_str(), "wb");
+    if (!file_) return;
+
+    CaptureFileHeader header{CAPTURE_MAGIC, CAPTURE_VERSION, 0};
+    if (std::fwrite(&header, sizeof(header), 1, file_) != 1) {
+        std::fclose(file_);
+        file_ = nullptr;
+    }
+}
+
+CaptureWriter::~CaptureWriter() {
+    if (!file_) return;
+    flush();
+    std::fclose(file_);
+}
+
+bool CaptureWriter::write(const uint8_t* data, size_t size, uint64_t timestamp_ns, CaptureKind kind) {
+    if (!file_ || size > UINT32_MAX) return false;
+
+    size_t frame = CAPTURE_FRAME_HEADER_SIZE + size;
+    if (used_ + frame > buffer_.size()) {
+        if (!flush()) return false;
+        // frame larger than the whole buffer: grow it once
+        if (frame > buffer_.size()) buffer_.resize(frame);
+    }
+
+    uint8_t* out = buffer_.data() + used_;
+    uint32_t size32 = static_cast<uint32_t>(size);
+    uint16_t kind16 = static_cast<uint16_t>(kind);
+    uint16_t reserved = 0;
+    std::memcpy(out, &size32, 4);
+    std::memcpy(out + 4, &kind16, 2);
+    std::memcpy(out + 6, &reserved, 2);
+    std::memcpy(out + 8, &timestamp_ns, 8);
+    std::memcpy(out + CAPTURE_FRAME_HEADER_SIZE, data, size);
+
+    used_ += frame;
+    ++frames_;
+    return true;
+}
+
+bool CaptureWriter::flush() {
+    if (!file_) return false;
+    if (used_ > 0 && std::fwrite(buffer_.data(), 1, used_, file_) != used_) return false;
+    used_ = 0;
+    return std::fflush(file_) == 0;
+}
+
+CaptureReader::CaptureReader(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return;
+
+    struct stat st;
+    if (::fstat(fd, &st) == 0 && static_cast<size_t>(st.st_size) >= sizeof(CaptureFileHeader)) {
+        void* mapped = ::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped != MAP_FAILED) {
+            // one sequential pass: let the kernel read ahead aggressively
+            ::madvise(mapped, st.st_size, MADV_SEQUENTIAL);
+            data_ = static_cast<const uint8_t*>(mapped);
+            size_ = st.st_size;
+        }
+    }
+    ::close(fd);
+    if (!data_) return;
+
+    CaptureFileHeader header;
+    std::memcpy(&header, data_, sizeof(header));
+    if (header.magic != CAPTURE_MAGIC || header.version != CAPTURE_VERSION) {
+        ::munmap(const_cast<uint8_t*>(data_), size_);
+        data_ = nullptr;
+        size_ = 0;
+        return;
+    }
+    rewind();
+}
+
+CaptureReader::~CaptureReader() {
+    if (data_) ::munmap(const_cast<uint8_t*>(data_), size_);
+}
+
+bool CaptureReader::next(CaptureFrame& out) {
+    if (!data_ || size_ - offset_ < CAPTURE_FRAME_HEADER_SIZE) return false;
+
+    const uint8_t* frame = data_ + offset_;
+    uint16_t kind;
+    std::memcpy(&out.size, frame, 4);
+    std::memcpy(&kind, frame + 4, 2);
+    std::memcpy(&out.timestamp_ns, frame + 8, 8);
+    if (size_ - offset_ - CAPTURE_FRAME_HEADER_SIZE < out.size) return false;
+
+    out.kind = static_cast<CaptureKind>(kind);
+    out.data = frame + CAPTURE_FRAME_HEADER_SIZE;
+    offset_ += CAPTURE_FRAME_HEADER_SIZE + out.size;
+    return true;
+}
+
+} // namespace trading
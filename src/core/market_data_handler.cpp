@@ -1,68 +1,176 @@
 #include "../../include/core/market_data_handler.hpp"
+#include "../../include/core/sequenced_decoder.hpp"
+#include "../../include/utils/event_loop.hpp"
 
 namespace trading {
 
 MarketDataHandler::MarketDataHandler(Queue& queue)
     : queue_(queue) {}
 
-/*/
-+-------------------+---------------------------+
-| 1 byte            | N bytes                   |
-+-------------------+---------------------------+
-| MessageType value | Message payload (union)   |
-+-------------------+---------------------------+
-/*/
-void MarketDataHandler::push_raw_message(const uint8_t* buffer, size_t size) {
-    if (size < 1) return;
+size_t payload_size(MessageType type) {
+    switch (type) {
+        case MessageType::AddOrder:    return sizeof(AddOrderMsg);
+        case MessageType::CancelOrder: return sizeof(CancelOrderMsg);
+        case MessageType::ModifyOrder: return sizeof(ModifyOrderMsg);
+        case MessageType::Execute:     return sizeof(ExecuteMsg);
+        case MessageType::Trade:       return sizeof(TradeMsg);
+        case MessageType::BBOUpdate:   return sizeof(BBOUpdateMsg);
+        case MessageType::LevelUpdate: return sizeof(LevelUpdateMsg);
+    }
+    return 0;
+}
 
-    // copy type
-    auto type = static_cast<MessageType>(buffer[0]);
-    auto msg = pool_.allocate();
-    if (!msg) return;
-    msg->type = type;
+size_t encode_message(const MarketMessage& msg, uint8_t* out) {
+    out[0] = static_cast<uint8_t>(msg.type);
+    std::memcpy(out + sizeof(MessageType), &msg.instrument, sizeof(InstrumentId));
 
-    // copy payload
-    switch (type) {
+    // every payload starts at the same offset inside the union
+    size_t payload = payload_size(msg.type);
+    std::memcpy(out + MESSAGE_HEADER_SIZE, &msg.add, payload);
+    return MESSAGE_HEADER_SIZE + payload;
+}
+
+void apply_message(OrderBook& book, const MarketMessage& msg) {
+    switch (msg.type) {
         case MessageType::AddOrder:
-            if (size >= sizeof(AddOrderMsg) + 1)
-                std::memcpy(&msg->add, buffer + 1, sizeof(AddOrderMsg));
+            book.add_order({msg.add.orderId, msg.add.side, msg.add.price, msg.add.qty});
             break;
-
         case MessageType::CancelOrder:
-            if (size >= sizeof(CancelOrderMsg) + 1)
-                std::memcpy(&msg->cancel, buffer + 1, sizeof(CancelOrderMsg));
+            book.cancel_order(msg.cancel.orderId);
             break;
-
         case MessageType::ModifyOrder:
-            if (size >= sizeof(ModifyOrderMsg) + 1)
-                std::memcpy(&msg->modify, buffer + 1, sizeof(ModifyOrderMsg));
+            book.modify_order(msg.modify.orderId, msg.modify.newQty);
             break;
-
         case MessageType::Execute:
-            if (size >= sizeof(ExecuteMsg) + 1)
-                std::memcpy(&msg->execute, buffer + 1, sizeof(ExecuteMsg));
+            book.execute_order(msg.execute.orderId, msg.execute.qty);
             break;
-
         case MessageType::Trade:
-            if (size >= sizeof(TradeMsg) + 1)
-                std::memcpy(&msg->trade, buffer + 1, sizeof(TradeMsg));
-            break;
-
         case MessageType::BBOUpdate:
-            if (size >= sizeof(BBOUpdateMsg) + 1)
-                std::memcpy(&msg->bbo, buffer + 1, sizeof(BBOUpdateMsg));
+        case MessageType::LevelUpdate:
             break;
+    }
+}
+
+/*/
++-------------------+---------------+---------------------------+
+| 1 byte            | 4 bytes       | N bytes                   |
++-------------------+---------------+---------------------------+
+| MessageType value | InstrumentId  | Message payload (union)   |
++-------------------+---------------+---------------------------+
+/*/
+bool MarketDataHandler::push_raw_message(const uint8_t* buffer, size_t size) {
+    uint64_t ingest = telemetry::stamp();
+    queue_full_ = false;
+
+    // validate before claiming: unknown types, short payloads and invalid
+    // sides are dropped rather than queued half-filled
+    auto type = static_cast<MessageType>(size >= MESSAGE_HEADER_SIZE ? buffer[0] : 0xff); // 0xff: no such type
+    size_t payload = payload_size(type);
+    if (payload == 0 || size < MESSAGE_HEADER_SIZE + payload || !valid_side(type, buffer + MESSAGE_HEADER_SIZE)) {
+        record(buffer, size, CaptureKind::Message); // dropped, but still part of the feed as received
+        return false;
+    }
+
+    // decode in place into the next ring slot
+    auto msg = queue_.claim();
+    if (!msg) {
+        telemetry::count(telemetry::Counter::QueueFull);
+        queue_full_ = true;
+        return false;
+    }
+    msg->type = type;
+    std::memcpy(&msg->instrument, buffer + sizeof(MessageType), sizeof(InstrumentId));
+
+    // every payload starts at the same offset inside the union
+    std::memcpy(&msg->add, buffer + MESSAGE_HEADER_SIZE, payload);
+
+    // publish to the consumer
+    telemetry::on_enqueue(*msg, ingest);
+    queue_.commit(msg);
+    if (wakeup_) wakeup_->notify();
+    record(buffer, size, CaptureKind::Message);
+    return true;
+}
+
+/*/
++---------+---------+-----+---------+
+| frame 0 | frame 1 | ... | frame N |
++---------+---------+-----+---------+
+Each frame is header + payload as above, sized by its type
+/*/
+size_t MarketDataHandler::push_raw_packet(const uint8_t* buffer, size_t size) {
+    uint64_t ingest = telemetry::stamp();
+    queue_full_ = false;
+
+    MarketMessage* last = nullptr;
+    size_t accepted = 0;
+    size_t offset = 0;
 
-        default:
+    while (size - offset >= MESSAGE_HEADER_SIZE) {
+        auto type = static_cast<MessageType>(buffer[offset]);
+        size_t payload = payload_size(type);
+        if (payload == 0 || size - offset < MESSAGE_HEADER_SIZE + payload) break;
+        if (!valid_side(type, buffer + offset + MESSAGE_HEADER_SIZE)) break;
+
+        MarketMessage* msg = queue_.claim();
+        if (!msg) {
+            telemetry::count(telemetry::Counter::QueueFull);
+            queue_full_ = true;
             break;
+        }
+
+        msg->type = type;
+        std::memcpy(&msg->instrument, buffer + offset + sizeof(MessageType), sizeof(InstrumentId));
+        std::memcpy(&msg->add, buffer + offset + MESSAGE_HEADER_SIZE, payload);
+        offset += MESSAGE_HEADER_SIZE + payload;
+        telemetry::on_enqueue(*msg, ingest);
+
+        // multi-producer queues publish slot by slot
+        if constexpr (!Queue::BATCH_COMMIT) queue_.commit(msg);
+
+        last = msg;
+        ++accepted;
+    }
+
+    // one commit publishes the whole packet
+    if constexpr (Queue::BATCH_COMMIT) {
+        if (last) queue_.commit(last);
     }
+    if (last && wakeup_) wakeup_->notify();
+
+    // a malformed tail is dropped and recorded with the frames before it;
+    // frames left behind by a full queue are recorded when retried
+    record(buffer, queue_full_ ? offset : size, CaptureKind::Packet);
+    return accepted;
+}
+
+size_t MarketDataHandler::push_sequenced(SequencedDecoder& decoder, const uint8_t* buffer, size_t size) {
+    uint64_t ingest = telemetry::stamp();
+    queue_full_ = false;
+
+    MarketMessage* last = nullptr;
+    size_t consumed = decoder.decode(buffer, size, [&](const MarketMessage& in) {
+        MarketMessage* msg = queue_.claim();
+        if (!msg) {
+            telemetry::count(telemetry::Counter::QueueFull);
+            queue_full_ = true;
+            return false;
+        }
+        *msg = in;
+        telemetry::on_enqueue(*msg, ingest);
+        if constexpr (!Queue::BATCH_COMMIT) queue_.commit(msg);
+        last = msg;
+        return true;
+    });
 
-    // push into queue
-    if (!queue_.push(msg)) {
-        pool_.release(msg);
-        return;
+    if constexpr (Queue::BATCH_COMMIT) {
+        if (last) queue_.commit(last);
     }
+    if (last && wakeup_) wakeup_->notify();
 
+    // the caller hands back whatever was not consumed
+    record(buffer, consumed, CaptureKind::Sequenced);
+    return consumed;
 }
 
-} // namespace trading
\ No newline at end of file
+} // namespace trading
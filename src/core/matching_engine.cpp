@@ -0,0 +1,177 @@
+#include "../../include/core/matching_engine.hpp"
+#include <bit>
+#include <cassert>
+
+namespace trading {
+
+EventRing::EventRing(size_t capacity)
+    : buffer_(std::bit_ceil(capacity)), mask_(buffer_.size() - 1) {}
+
+MatchingEngine::MatchingEngine(const BookConfig& config, size_t event_capacity, InstrumentId instrument)
+    : instrument_(instrument),
+      book_(config),
+      events_(event_capacity),
+      index_(config.order_capacity),
+      queues_{FlatHashMap<Price, LevelQueue>(config.ladder_width),
+              FlatHashMap<Price, LevelQueue>(config.ladder_width)} {
+    // pre-build the free list so resting orders never allocate
+    nodes_.resize(config.order_capacity);
+    for (size_t i = nodes_.size(); i-- > 0;) free_node(static_cast<uint32_t>(i));
+}
+
+uint32_t MatchingEngine::allocate_node() {
+    if (free_head_ == NIL) {
+        // slab exhausted: grow (allocates, off the steady-state path)
+        nodes_.push_back({});
+        return static_cast<uint32_t>(nodes_.size() - 1);
+    }
+    uint32_t n = free_head_;
+    free_head_ = nodes_[n].next;
+    return n;
+}
+
+void MatchingEngine::free_node(uint32_t n) {
+    nodes_[n].next = free_head_;
+    free_head_ = n;
+}
+
+void MatchingEngine::enqueue(uint32_t n) {
+    OrderNode& node = nodes_[n];
+    LevelQueue& q = queues(node.side).emplace(node.price, LevelQueue{}).first->second;
+
+    node.prev = q.tail;
+    node.next = NIL;
+    if (q.tail != NIL) nodes_[q.tail].next = n;
+    else q.head = n;
+    q.tail = n;
+}
+
+void MatchingEngine::unlink(uint32_t n) {
+    OrderNode& node = nodes_[n];
+    auto it = queues(node.side).find(node.price);
+    assert(it != queues(node.side).end());
+    LevelQueue& q = it->second;
+
+    if (node.prev != NIL) nodes_[node.prev].next = node.next;
+    else q.head = node.next;
+    if (node.next != NIL) nodes_[node.next].prev = node.prev;
+    else q.tail = node.prev;
+
+    if (q.head == NIL) queues(node.side).erase(it);
+}
+
+void MatchingEngine::emit_fill(const Order& aggressor, const OrderNode& resting, Quantity qty) {
+    MarketMessage msg{};
+    msg.type = MessageType::Trade;
+    msg.instrument = instrument_;
+    msg.trade.buyOrderId = aggressor.side == Side::Bid ? aggressor.id : resting.id;
+    msg.trade.sellOrderId = aggressor.side == Side::Bid ? resting.id : aggressor.id;
+    msg.trade.qty = qty;
+    msg.trade.price = resting.price;
+    events_.push(msg);
+
+    msg.type = MessageType::Execute;
+    msg.execute.orderId = resting.id;
+    msg.execute.qty = qty;
+    msg.execute.price = resting.price;
+    events_.push(msg);
+}
+
+Quantity MatchingEngine::submit(const Order& order) {
+    if (order.quantity <= 0 || index_.find(order.id) != index_.end()) return 0;
+
+    Side contra = order.side == Side::Bid ? Side::Ask : Side::Bid;
+    Quantity remaining = order.quantity;
+
+    while (remaining > 0) {
+        auto best = contra == Side::Ask ? book_.get_best_ask() : book_.get_best_bid();
+        if (!best) break;
+        bool crosses = order.side == Side::Bid ? *best <= order.price : *best >= order.price;
+        if (!crosses) break;
+
+        auto level = queues(contra).find(*best);
+        assert(level != queues(contra).end());
+        LevelQueue& q = level->second;
+
+        // fill against the level in time priority
+        while (remaining > 0 && q.head != NIL) {
+            uint32_t n = q.head;
+            OrderNode& resting = nodes_[n];
+            Quantity fill = std::min(remaining, resting.quantity);
+
+            emit_fill(order, resting, fill);
+            remaining -= fill;
+            resting.quantity -= fill;
+            book_.execute_order(resting.handle, fill);
+
+            if (resting.quantity == 0) {
+                q.head = resting.next;
+                if (q.head != NIL) nodes_[q.head].prev = NIL;
+                else q.tail = NIL;
+                index_.erase(resting.id);
+                free_node(n);
+            }
+        }
+
+        if (q.head == NIL) queues(contra).erase(level);
+    }
+
+    if (remaining > 0) {
+        uint32_t n = allocate_node();
+        nodes_[n] = {order.id, order.side, order.price, remaining, NIL, NIL, {}};
+        index_.emplace(order.id, n);
+        enqueue(n);
+        nodes_[n].handle = book_.add_order({order.id, order.side, order.price, remaining});
+    }
+
+    return order.quantity - remaining;
+}
+
+bool MatchingEngine::cancel_order(OrderId id) {
+    auto it = index_.find(id);
+    if (it == index_.end()) return false;
+
+    uint32_t n = it->second;
+    OrderHandle handle = nodes_[n].handle;
+    index_.erase(it);
+    unlink(n);
+    free_node(n);
+    return book_.cancel_order(handle);
+}
+
+bool MatchingEngine::modify_order(OrderId id, Quantity new_quantity) {
+    if (new_quantity < 0) return false;
+    if (new_quantity == 0) return cancel_order(id);
+
+    auto it = index_.find(id);
+    if (it == index_.end()) return false;
+
+    uint32_t n = it->second;
+    OrderNode& node = nodes_[n];
+    if (new_quantity > node.quantity) {
+        // size increase loses time priority
+        unlink(n);
+        enqueue(n);
+    }
+    node.quantity = new_quantity;
+    return book_.modify_order(node.handle, new_quantity);
+}
+
+bool MatchingEngine::execute_order(OrderId id, Quantity exec_quantity) {
+    if (exec_quantity <= 0) return false; // the book refuses it too: keep the node in step
+    auto it = index_.find(id);
+    if (it == index_.end()) return false;
+
+    uint32_t n = it->second;
+    OrderNode& node = nodes_[n];
+    OrderHandle handle = node.handle;
+    node.quantity -= std::min(exec_quantity, node.quantity);
+    if (node.quantity == 0) {
+        index_.erase(it);
+        unlink(n);
+        free_node(n);
+    }
+    return book_.execute_order(handle, exec_quantity);
+}
+
+} // namespace trading
@@ -0,0 +1,91 @@
+#include "../../include/core/mbp_publisher.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace trading {
+
+MbpPublisher::MbpPublisher(OrderBook& book, Queue& out, InstrumentId instrument)
+    : book_(book), out_(out), instrument_(instrument) {
+    book_.clear_changes();
+    book_.track_changes(true);
+    pending_.reserve(1024);
+}
+
+MbpPublisher::~MbpPublisher() {
+    book_.track_changes(false);
+    book_.clear_changes();
+}
+
+BBOUpdateMsg MbpPublisher::current_bbo() const {
+    BBOUpdateMsg bbo{};
+    if (auto bid = book_.get_best_bid()) {
+        bbo.bestBid = *bid;
+        bbo.bidSize = book_.get_level(Side::Bid, *bid);
+    }
+    if (auto ask = book_.get_best_ask()) {
+        bbo.bestAsk = *ask;
+        bbo.askSize = book_.get_level(Side::Ask, *ask);
+    }
+    return bbo;
+}
+
+size_t MbpPublisher::publish() {
+    const std::vector<LevelChange>& changed = book_.changed_levels();
+    if (!changed.empty()) {
+        changes_ += changed.size();
+        pending_.insert(pending_.end(), changed.begin(), changed.end());
+        book_.clear_changes();
+
+        // conflate: one entry per level, bids then asks, best first, so the
+        // top of book goes out first when the ring is short of space
+        auto order = [](const LevelChange& a, const LevelChange& b) {
+            if (a.side != b.side) return a.side < b.side;
+            return a.side == Side::Bid ? a.price > b.price : a.price < b.price;
+        };
+        auto same = [](const LevelChange& a, const LevelChange& b) {
+            return a.side == b.side && a.price == b.price;
+        };
+        std::sort(pending_.begin(), pending_.end(), order);
+        pending_.erase(std::unique(pending_.begin(), pending_.end(), same), pending_.end());
+
+        BBOUpdateMsg bbo = current_bbo();
+        if (std::memcmp(&bbo, &last_bbo_, sizeof(bbo)) != 0) bbo_dirty_ = true;
+    }
+
+    size_t sent = 0;
+    MarketMessage* last = nullptr;
+    auto claim = [&](MessageType type) {
+        MarketMessage* msg = out_.claim();
+        if (!msg) return msg;
+        msg->type = type;
+        msg->instrument = instrument_;
+        bytes_ += MESSAGE_HEADER_SIZE + payload_size(type);
+        last = msg;
+        ++sent;
+        return msg;
+    };
+
+    // quantities are read now, so each level carries its latest state
+    size_t done = 0;
+    for (; done < pending_.size(); ++done) {
+        MarketMessage* msg = claim(MessageType::LevelUpdate);
+        if (!msg) break;
+        const LevelChange& change = pending_[done];
+        msg->level = {change.side, change.price, book_.get_level(change.side, change.price)};
+    }
+    pending_.erase(pending_.begin(), pending_.begin() + done);
+
+    if (pending_.empty() && bbo_dirty_) {
+        if (MarketMessage* msg = claim(MessageType::BBOUpdate)) {
+            last_bbo_ = current_bbo();
+            msg->bbo = last_bbo_;
+            bbo_dirty_ = false;
+        }
+    }
+
+    if (last) out_.commit(last);
+    messages_ += sent;
+    return sent;
+}
+
+} // namespace trading
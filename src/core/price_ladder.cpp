@@ -0,0 +1,195 @@
+#include "../../include/core/price_ladder.hpp"
+#include "../../include/utils/level_kernels.hpp"
+#include <algorithm>
+#include <cassert>
+
+namespace trading {
+
+PriceLadder::PriceLadder(Price tick_size, size_t width)
+    : tick_size_(tick_size), width_(width), mask_(width - 1),
+      levels_(width, 0), occupied_(width) {
+    assert(tick_size_ > 0);
+    assert(width_ > 0 && (width_ & mask_) == 0); // power of two
+}
+
+Quantity PriceLadder::add(Price norm_price, Quantity delta) {
+    assert(norm_price % tick_size_ == 0);
+    if (!anchored_) recenter(norm_price);
+
+    int64_t tick = to_tick(norm_price);
+    if (static_cast<uint64_t>(tick - low_tick_) < width_) {
+        size_t s = slot(tick);
+        Quantity& level = levels_[s];
+        bool was_empty = level == 0;
+        level += delta;
+        if (level == 0) occupied_.clear(s);
+        else if (was_empty) occupied_.set(s);
+        return level;
+    }
+
+    // far from the mid: keep it in the overflow store
+    auto it = overflow_.try_emplace(tick, 0).first;
+    it->second += delta;
+    Quantity qty = it->second;
+    if (qty == 0) overflow_.erase(it);
+    return qty;
+}
+
+Quantity PriceLadder::quantity(Price norm_price) const {
+    int64_t tick = to_tick(norm_price);
+    if (static_cast<uint64_t>(tick - low_tick_) < width_) return levels_[slot(tick)];
+
+    auto it = overflow_.find(tick);
+    return it == overflow_.end() ? 0 : it->second;
+}
+
+std::optional<Price> PriceLadder::best() const {
+    // overflow levels below the window beat anything inside it
+    if (!overflow_.empty() && overflow_.begin()->first < low_tick_)
+        return overflow_.begin()->first * tick_size_;
+
+    int64_t end = low_tick_ + static_cast<int64_t>(width_);
+    int64_t tick = next_occupied(low_tick_, end);
+    if (tick < end) return tick * tick_size_;
+
+    if (!overflow_.empty()) return overflow_.begin()->first * tick_size_;
+    return std::nullopt;
+}
+
+size_t PriceLadder::depth(size_t n, Price* norm_prices, Quantity* quantities) const {
+    size_t count = 0;
+    auto emit = [&](int64_t tick, Quantity qty) {
+        norm_prices[count] = tick * tick_size_;
+        quantities[count] = qty;
+        return ++count < n;
+    };
+    if (n == 0) return 0;
+
+    // overflow below the window, the window, then overflow above it
+    auto it = overflow_.begin();
+    for (; it != overflow_.end() && it->first < low_tick_; ++it)
+        if (!emit(it->first, it->second)) return count;
+
+    int64_t end = low_tick_ + static_cast<int64_t>(width_);
+    for (int64_t tick = next_occupied(low_tick_, end); tick < end; tick = next_occupied(tick + 1, end))
+        if (!emit(tick, levels_[slot(tick)])) return count;
+
+    for (; it != overflow_.end(); ++it)
+        if (!emit(it->first, it->second)) return count;
+    return count;
+}
+
+Quantity PriceLadder::depth_to(Price norm_limit) const {
+    // floor, so a limit between ticks covers the tick below it
+    int64_t limit = norm_limit / tick_size_;
+    if (limit * tick_size_ > norm_limit) --limit;
+
+    Quantity total = 0;
+    for (const auto& [tick, qty] : overflow_) {
+        if (tick > limit) break;
+        total += qty;
+    }
+
+    int64_t end = std::min(limit + 1, low_tick_ + static_cast<int64_t>(width_));
+    for_each_run(low_tick_, end, [&](const Quantity* levels, size_t n, int64_t) {
+        total += kernels::sum(levels, n);
+        return true;
+    });
+    return total;
+}
+
+PriceLadder::Sweep PriceLadder::sweep(Quantity quantity) const {
+    Sweep out;
+    auto take = [&](int64_t tick, Quantity qty) {
+        Quantity taken = std::min(qty, quantity - out.filled);
+        out.filled += taken;
+        out.notional_ticks += taken * tick;
+        out.last = tick * tick_size_;
+        return out.filled < quantity;
+    };
+    if (quantity <= 0) return out;
+
+    auto it = overflow_.begin();
+    for (; it != overflow_.end() && it->first < low_tick_; ++it)
+        if (!take(it->first, it->second)) return out;
+
+    // window: whole levels in bulk, then the one that completes the fill
+    int64_t end = low_tick_ + static_cast<int64_t>(width_);
+    bool done = false;
+    for_each_run(next_occupied(low_tick_, end), end, [&](const Quantity* levels, size_t n, int64_t first) {
+        Quantity filled = 0;
+        int64_t weighted = 0;
+        size_t whole = kernels::take_below(levels, n, quantity - out.filled, filled, weighted);
+        out.filled += filled;
+        out.notional_ticks += first * filled + weighted;
+
+        if (whole < n) {
+            take(first + static_cast<int64_t>(whole), levels[whole]);
+            done = true;
+            return false;
+        }
+        if (filled > 0) {
+            size_t last = n - 1;
+            while (levels[last] == 0) --last;
+            out.last = (first + static_cast<int64_t>(last)) * tick_size_;
+        }
+        return true;
+    });
+    if (done) return out;
+
+    for (; it != overflow_.end(); ++it)
+        if (!take(it->first, it->second)) return out;
+    return out;
+}
+
+void PriceLadder::recenter(Price norm_price) {
+    int64_t new_low = to_tick(norm_price) - static_cast<int64_t>(width_ / 2);
+    int64_t w = static_cast<int64_t>(width_);
+
+    if (anchored_) {
+        if (new_low == low_tick_) return;
+
+        // evict ticks that fall out of the window
+        int64_t old_low = low_tick_;
+        int64_t begin = new_low > old_low ? old_low : std::max(new_low + w, old_low);
+        int64_t end = new_low > old_low ? std::min(new_low, old_low + w) : old_low + w;
+        for (int64_t tick = next_occupied(begin, end); tick < end;
+             tick = next_occupied(tick + 1, end)) {
+            size_t s = slot(tick);
+            overflow_.emplace(tick, levels_[s]);
+            levels_[s] = 0;
+            occupied_.clear(s);
+        }
+    }
+
+    low_tick_ = new_low;
+    anchored_ = true;
+
+    // pull overflow levels that are now covered by the window
+    auto it = overflow_.lower_bound(new_low);
+    while (it != overflow_.end() && it->first < new_low + w) {
+        size_t s = slot(it->first);
+        levels_[s] = it->second;
+        occupied_.set(s);
+        it = overflow_.erase(it);
+    }
+}
+
+int64_t PriceLadder::next_occupied(int64_t tick, int64_t end) const {
+    if (tick >= end) return end;
+
+    // search from the slot to the end of the array, then wrap around
+    size_t s = slot(tick);
+    size_t n = occupied_.find_next(s);
+    int64_t found;
+    if (n != HierarchicalBitmap::npos) {
+        found = tick + static_cast<int64_t>(n - s);
+    } else {
+        n = occupied_.find_next(0);
+        if (n == HierarchicalBitmap::npos) return end;
+        found = tick + static_cast<int64_t>(width_ - s + n);
+    }
+    return found < end ? found : end;
+}
+
+} // namespace trading
@@ -0,0 +1,23 @@
+#include "../../include/core/sequenced_decoder.hpp"
+
+namespace trading {
+
+size_t encode_sequenced(const MarketMessage& msg, uint64_t sequence, uint8_t* out) {
+    size_t payload = payload_size(msg.type);
+    auto length = static_cast<uint16_t>(SEQUENCED_HEADER_SIZE + payload);
+
+    std::memcpy(out, &length, sizeof(length));
+    out[2] = static_cast<uint8_t>(msg.type);
+    out[3] = 0;
+    std::memcpy(out + 4, &msg.instrument, sizeof(InstrumentId));
+    std::memcpy(out + 8, &sequence, sizeof(sequence));
+    std::memcpy(out + SEQUENCED_HEADER_SIZE, &msg.add, payload);
+    return length;
+}
+
+void SequencedDecoder::note_gap(uint64_t received) {
+    ++gaps_;
+    if (gap_handler_) gap_handler_(expected_, received);
+}
+
+} // namespace trading
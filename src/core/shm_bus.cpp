@@ -0,0 +1,107 @@
+#include "../../include/core/shm_bus.hpp"
+#include <fcntl.h>
+#include <new>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace trading {
+
+namespace {
+
+size_t segment_size(size_t capacity) {
+    return sizeof(ShmBusHeader) + capacity * sizeof(ShmBusSlot);
+}
+
+#ifdef MAP_POPULATE
+constexpr int MAP_FLAGS = MAP_SHARED | MAP_POPULATE; // fault the ring in up front, not on the hot path
+#else
+constexpr int MAP_FLAGS = MAP_SHARED;
+#endif
+
+} // namespace
+
+static_assert(sizeof(ShmBusHeader) % alignof(ShmBusSlot) == 0, "slots must start cache-line aligned");
+
+ShmBusWriter::ShmBusWriter(const std::string& name, size_t capacity) : name_(name) {
+    if (capacity == 0 || (capacity & (capacity - 1)) != 0) return;
+
+    ::shm_unlink(name_.c_str()); // a stale segment from a previous run
+    int fd = ::shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0) return;
+
+    size_t size = segment_size(capacity);
+    void* mapped = MAP_FAILED;
+    if (::ftruncate(fd, static_cast<off_t>(size)) == 0)
+        mapped = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_FLAGS, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) {
+        ::shm_unlink(name_.c_str());
+        return;
+    }
+
+    // ftruncate zero-fills: every seq starts at 0, i.e. nothing published
+    auto* base = static_cast<uint8_t*>(mapped);
+    auto* header = new (base) ShmBusHeader{};
+    header->version = SHM_BUS_VERSION;
+    header->slot_size = sizeof(ShmBusSlot);
+    header->capacity = capacity;
+    slots_ = reinterpret_cast<ShmBusSlot*>(base + sizeof(ShmBusHeader));
+    for (size_t i = 0; i < capacity; ++i) new (&slots_[i].seq) std::atomic<uint64_t>(0);
+    header->magic.store(SHM_BUS_MAGIC, std::memory_order_release);
+
+    header_ = header;
+    mask_ = capacity - 1;
+    map_size_ = size;
+}
+
+ShmBusWriter::~ShmBusWriter() {
+    if (!header_) return;
+    header_->closed.store(1, std::memory_order_release);
+    ::munmap(header_, map_size_);
+    ::shm_unlink(name_.c_str());
+}
+
+ShmBusReader::ShmBusReader(const std::string& name) {
+    int fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0) return;
+
+    struct stat st;
+    void* mapped = MAP_FAILED;
+    size_t size = 0;
+    if (::fstat(fd, &st) == 0 && static_cast<size_t>(st.st_size) >= sizeof(ShmBusHeader)) {
+        size = st.st_size;
+        mapped = ::mmap(nullptr, size, PROT_READ, MAP_FLAGS, fd, 0);
+    }
+    ::close(fd);
+    if (mapped == MAP_FAILED) return;
+
+    auto* base = static_cast<const uint8_t*>(mapped);
+    auto* header = reinterpret_cast<const ShmBusHeader*>(base);
+    bool valid = header->magic.load(std::memory_order_acquire) == SHM_BUS_MAGIC; // the rest is set before it
+    uint64_t capacity = valid ? header->capacity : 0;
+    if (!valid || header->version != SHM_BUS_VERSION || header->slot_size != sizeof(ShmBusSlot) || capacity == 0 ||
+        (capacity & (capacity - 1)) != 0 || segment_size(capacity) != size) {
+        ::munmap(const_cast<uint8_t*>(base), size);
+        return;
+    }
+
+    header_ = header;
+    slots_ = reinterpret_cast<const ShmBusSlot*>(base + sizeof(ShmBusHeader));
+    mask_ = capacity - 1;
+    map_size_ = size;
+    cursor_ = header_->write.load(std::memory_order_acquire);
+}
+
+ShmBusReader::~ShmBusReader() {
+    if (header_) ::munmap(const_cast<ShmBusHeader*>(header_), map_size_);
+}
+
+void ShmBusReader::skip_to_writer() {
+    uint64_t write = header_->write.load(std::memory_order_acquire);
+    if (write > cursor_) lost_ += write - cursor_;
+    cursor_ = write;
+    ++overruns_;
+}
+
+} // namespace trading
@@ -0,0 +1,79 @@
+#include "../include/utils/async_logger.hpp"
+#include <cassert>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace trading;
+
+static std::vector<std::string> read_lines(const std::string& path) {
+    std::ifstream in(path);
+    std::vector<std::string> lines;
+    for (std::string line; std::getline(in, line);) lines.push_back(line);
+    return lines;
+}
+
+// Message part of "HH:MM:SS.nnnnnnnnn | message"
+static std::string message(const std::string& line) {
+    size_t bar = line.find(" | ");
+    assert(bar == 18);
+    return line.substr(bar + 3);
+}
+
+void test_async_logger_format() {
+    std::string path = "/tmp/test_async_logger_" + std::to_string(std::time(nullptr)) + ".log";
+    {
+        AsyncLogger logger(path);
+        assert(logger.is_open());
+        assert(logger.log("plain"));
+        assert(logger.log("AddOrder: id={}, side={}, price={}, qty={}", uint64_t(7), "Bid", int64_t(-5), 10));
+        assert(logger.log("{} {} {} {}", 'x', true, 2.5, uint8_t(200)));
+        assert(logger.log("extra {} {}", 1)); // missing argument left as is
+    }
+
+    auto lines = read_lines(path);
+    assert(lines.size() == 4);
+    assert(message(lines[0]) == "plain");
+    assert(message(lines[1]) == "AddOrder: id=7, side=Bid, price=-5, qty=10");
+    assert(message(lines[2]) == "x true 2.5 200");
+    assert(message(lines[3]) == "extra 1 {}");
+    std::remove(path.c_str());
+
+    assert(!AsyncLogger("/nonexistent/dir/x.log").is_open());
+
+    std::cout << "All AsyncLogger format tests passed!\n";
+}
+
+void test_async_logger_policies() {
+    constexpr uint64_t COUNT = 20000;
+    std::string path = "/tmp/test_async_logger_policy_" + std::to_string(std::time(nullptr)) + ".log";
+
+    // Drop: every record is either written or counted
+    uint64_t dropped = 0;
+    {
+        BasicAsyncLogger<8> logger(path, OverflowPolicy::Drop);
+        for (uint64_t i = 0; i < COUNT; ++i) logger.log("record {}", i);
+        dropped = logger.dropped();
+    }
+    assert(read_lines(path).size() + dropped == COUNT);
+
+    // Block: nothing is lost, order is kept
+    {
+        BasicAsyncLogger<8> logger(path, OverflowPolicy::Block);
+        for (uint64_t i = 0; i < COUNT; ++i) assert(logger.log("record {}", i));
+        assert(logger.dropped() == 0);
+    }
+    auto lines = read_lines(path);
+    assert(lines.size() == COUNT);
+    for (uint64_t i = 0; i < COUNT; i += 997) assert(message(lines[i]) == "record " + std::to_string(i));
+    std::remove(path.c_str());
+
+    std::cout << "All AsyncLogger policy tests passed!\n";
+}
+
+int main() {
+    test_async_logger_format();
+    test_async_logger_policies();
+    return 0;
+}
@@ -0,0 +1,65 @@
+#include "../include/core/book_manager.hpp"
+#include <cassert>
+#include <iostream>
+#include <thread>
+
+using namespace trading;
+
+static void push(BookManager& manager, const MarketMessage& msg) {
+    uint8_t buffer[sizeof(MarketMessage) + MESSAGE_HEADER_SIZE];
+    size_t size = encode_message(msg, buffer);
+    while (!manager.push_raw_message(buffer, size)) std::this_thread::yield();
+}
+
+void test_book_manager() {
+    constexpr InstrumentId NUM_INSTRUMENTS = 16;
+
+    BookManager manager(4, {1, 256, 64});
+    for (InstrumentId id = 0; id < NUM_INSTRUMENTS; ++id) manager.add_instrument(id);
+    assert(manager.shard_of(5) == 1);
+
+    manager.start();
+
+    // Each instrument gets its own bid/ask at prices derived from its id
+    MarketMessage msg{};
+    msg.type = MessageType::AddOrder;
+    for (InstrumentId id = 0; id < NUM_INSTRUMENTS; ++id) {
+        msg.instrument = id;
+        msg.add = {1, Side::Bid, 1000 + Price(id), 10};
+        push(manager, msg);
+        msg.add = {2, Side::Ask, 2000 + Price(id), 10};
+        push(manager, msg);
+    }
+
+    // Cancel the ask on even instruments only
+    msg.type = MessageType::CancelOrder;
+    for (InstrumentId id = 0; id < NUM_INSTRUMENTS; id += 2) {
+        msg.instrument = id;
+        msg.cancel = {2};
+        push(manager, msg);
+    }
+
+    // Unregistered instrument is counted, not applied
+    msg.instrument = 999;
+    push(manager, msg);
+
+    manager.stop();
+
+    assert(manager.processed() == NUM_INSTRUMENTS * 2 + NUM_INSTRUMENTS / 2 + 1);
+    assert(manager.unknown() == 1);
+    assert(manager.book(999) == nullptr);
+
+    for (InstrumentId id = 0; id < NUM_INSTRUMENTS; ++id) {
+        const OrderBook* book = manager.book(id);
+        assert(book != nullptr);
+        assert(book->get_best_bid().value() == 1000 + Price(id));
+        assert(book->get_best_ask().has_value() == (id % 2 == 1));
+    }
+
+    std::cout << "All BookManager tests passed!\n";
+}
+
+int main() {
+    test_book_manager();
+    return 0;
+}
@@ -0,0 +1,318 @@
+#include "../include/core/book_snapshot.hpp"
+#include "../include/core/sequenced_decoder.hpp"
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+using namespace trading;
+
+static std::string temp_path(const char* name) {
+    return "/tmp/" + std::string(name) + "_" + std::to_string(::getpid()) + ".snap";
+}
+
+// Same levels on both sides, same best prices
+template <typename A, typename B>
+static void assert_same_book(const A& a, const B& b) {
+    assert(a.get_best_bid() == b.get_best_bid());
+    assert(a.get_best_ask() == b.get_best_ask());
+    for (Side side : {Side::Bid, Side::Ask}) {
+        std::vector<Price> pa(10000), pb(10000);
+        std::vector<Quantity> qa(10000), qb(10000);
+        size_t na = a.get_depth(side, pa, qa);
+        size_t nb = b.get_depth(side, pb, qb);
+        assert(na == nb);
+        for (size_t i = 0; i < na; ++i) assert(pa[i] == pb[i] && qa[i] == qb[i]);
+    }
+}
+
+// Random adds, cancels, modifies and executes, some far from the mid so the
+// ladders' overflow stores are populated too
+static std::vector<MarketMessage> make_messages(size_t n, unsigned seed) {
+    std::vector<MarketMessage> msgs;
+    std::mt19937 gen(seed);
+    std::vector<OrderId> live;
+    OrderId next_id = 1;
+    for (size_t i = 0; i < n; ++i) {
+        MarketMessage msg{};
+        int kind = live.empty() ? 0 : static_cast<int>(gen() % 5);
+        size_t pick = live.empty() ? 0 : gen() % live.size();
+        if (kind <= 1) {
+            Side side = gen() % 2 == 0 ? Side::Bid : Side::Ask;
+            Price offset = gen() % 10 == 0 ? 5000 + gen() % 1000 : 1 + gen() % 50;
+            msg.type = MessageType::AddOrder;
+            msg.add = {next_id, side, side == Side::Bid ? 100000 - offset : 100000 + offset,
+                       static_cast<Quantity>(1 + gen() % 100)};
+            live.push_back(next_id++);
+        } else if (kind == 2) {
+            msg.type = MessageType::CancelOrder;
+            msg.cancel = {live[pick]};
+            live[pick] = live.back();
+            live.pop_back();
+        } else if (kind == 3) {
+            msg.type = MessageType::ModifyOrder;
+            msg.modify = {live[pick], static_cast<Quantity>(1 + gen() % 100)};
+        } else {
+            msg.type = MessageType::Execute;
+            msg.execute = {live[pick], 1, 0};
+        }
+        msgs.push_back(msg);
+    }
+    return msgs;
+}
+
+void test_round_trip() {
+    std::string path = temp_path("round_trip");
+    OrderBook book;
+    for (const auto& msg : make_messages(20000, 1)) apply_message(book, msg);
+    assert(book.save_snapshot(path, 20000));
+
+    OrderBook restored;
+    restored.add_order({999999, Side::Bid, 5, 5}); // replaced by the load
+    auto sequence = restored.load_snapshot(path);
+    assert(sequence && *sequence == 20000);
+    assert_same_book(book, restored);
+    assert(restored.get_level(Side::Bid, 5) == 0);
+
+    // orders came back too: both books react the same to further updates
+    for (OrderId id = 1; id <= 20000; ++id) {
+        bool found = id % 3 == 0 ? book.cancel_order(id)
+                   : id % 3 == 1 ? book.modify_order(id, 7)
+                                 : book.execute_order(id, 2);
+        bool restored_found = id % 3 == 0 ? restored.cancel_order(id)
+                            : id % 3 == 1 ? restored.modify_order(id, 7)
+                                          : restored.execute_order(id, 2);
+        assert(found == restored_found);
+    }
+    assert_same_book(book, restored);
+
+    // an empty book round-trips
+    OrderBook empty;
+    assert(empty.save_snapshot(path, 0));
+    assert(restored.load_snapshot(path) == 0u);
+    assert(!restored.get_best_bid() && !restored.get_best_ask());
+
+    std::remove(path.c_str());
+}
+
+// Specialised books snapshot too; any book on the same tick grid can load
+// the file
+void test_fixed_book_round_trip() {
+    using Band = TickTraits<1, 90000, 110000>;
+    using FixedBook = BasicOrderBook<Band, FixedLadder<Band>>;
+    std::string path = temp_path("fixed");
+
+    FixedBook book;
+    for (const auto& msg : make_messages(5000, 4)) {
+        if (msg.type == MessageType::AddOrder) book.add_order({msg.add.orderId, msg.add.side, msg.add.price, msg.add.qty});
+        else if (msg.type == MessageType::CancelOrder) book.cancel_order(msg.cancel.orderId);
+    }
+    assert(book.save_snapshot(path, 5000));
+
+    FixedBook restored;
+    assert(restored.load_snapshot(path) == 5000u);
+    assert_same_book(book, restored);
+
+    // same grid, different layout: the default book takes it as well
+    OrderBook unbounded;
+    assert(unbounded.load_snapshot(path) == 5000u);
+    assert_same_book(book, unbounded);
+
+    std::remove(path.c_str());
+}
+
+void test_rejects_bad_files() {
+    std::string path = temp_path("bad");
+    OrderBook book;
+    book.add_order({1, Side::Bid, 100, 10});
+    book.add_order({2, Side::Ask, 101, 5});
+    assert(book.save_snapshot(path, 42));
+
+    OrderBook target;
+    target.add_order({7, Side::Ask, 200, 1});
+    assert(!target.load_snapshot(path + ".missing"));
+
+    // different tick size
+    OrderBook coarse(BookConfig{5, DEFAULT_LADDER_WIDTH, DEFAULT_ORDER_CAPACITY});
+    assert(!coarse.load_snapshot(path));
+
+    std::vector<char> bytes;
+    {
+        std::ifstream in(path, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), {});
+    }
+    auto write_variant = [&](auto mutate) {
+        std::vector<char> copy = bytes;
+        mutate(copy);
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(copy.data(), copy.size());
+    };
+
+    // truncated
+    write_variant([](std::vector<char>& b) { b.pop_back(); });
+    assert(!target.load_snapshot(path));
+    // bad magic
+    write_variant([](std::vector<char>& b) { b[0] ^= 1; });
+    assert(!target.load_snapshot(path));
+    // an order quantity no longer matching its level
+    write_variant([](std::vector<char>& b) {
+        size_t offset = b.size() - sizeof(SnapshotOrder) + offsetof(SnapshotOrder, quantity);
+        b[offset] += 1;
+    });
+    assert(!target.load_snapshot(path));
+
+    // the failed loads left the book alone
+    assert(target.get_best_ask() == 200 && !target.get_best_bid());
+
+    write_variant([](std::vector<char>&) {});
+    assert(target.load_snapshot(path) == 42u);
+    assert(target.get_best_bid() == 100 && target.get_best_ask() == 101);
+
+    std::remove(path.c_str());
+}
+
+// Orders that add up per side but not per level, or repeat an id, fail the
+// load without touching the book
+void test_rejects_inconsistent_orders() {
+    std::string path = temp_path("inconsistent");
+    OrderBook book;
+    book.add_order({1, Side::Bid, 100, 10});
+    book.add_order({2, Side::Bid, 99, 5});
+    book.add_order({3, Side::Ask, 101, 5});
+    assert(book.save_snapshot(path, 9));
+
+    std::vector<char> bytes;
+    {
+        std::ifstream in(path, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), {});
+    }
+    const size_t first_order = bytes.size() - 3 * sizeof(SnapshotOrder);
+    auto write_variant = [&](auto mutate) {
+        std::vector<SnapshotOrder> orders(3);
+        std::memcpy(orders.data(), bytes.data() + first_order, 3 * sizeof(SnapshotOrder));
+        mutate(orders);
+        std::vector<char> copy = bytes;
+        std::memcpy(copy.data() + first_order, orders.data(), 3 * sizeof(SnapshotOrder));
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(copy.data(), copy.size());
+    };
+    auto find_order = [](std::vector<SnapshotOrder>& orders, OrderId id) -> SnapshotOrder& {
+        return *std::find_if(orders.begin(), orders.end(), [&](const SnapshotOrder& o) { return o.id == id; });
+    };
+
+    OrderBook target;
+    target.add_order({7, Side::Ask, 200, 1});
+    auto assert_unchanged = [&] {
+        assert(target.order_count() == 1 && target.find(7).valid());
+        assert(target.get_best_ask() == 200 && !target.get_best_bid());
+        assert(target.get_level(Side::Ask, 200) == 1);
+    };
+
+    // bid total still 15, but level 100 now has 15 in orders against 10
+    write_variant([&](std::vector<SnapshotOrder>& orders) { find_order(orders, 2).price = 100; });
+    assert(!target.load_snapshot(path));
+    assert_unchanged();
+
+    // an order at a price with no level
+    write_variant([&](std::vector<SnapshotOrder>& orders) { find_order(orders, 3).price = 102; });
+    assert(!target.load_snapshot(path));
+    assert_unchanged();
+
+    // the same id twice
+    write_variant([&](std::vector<SnapshotOrder>& orders) { find_order(orders, 2).id = 1; });
+    assert(!target.load_snapshot(path));
+    assert_unchanged();
+
+    write_variant([](std::vector<SnapshotOrder>&) {});
+    size_t capacity = target.order_capacity();
+    assert(capacity >= DEFAULT_ORDER_CAPACITY);
+    assert(target.load_snapshot(path) == 9u);
+    assert(target.order_capacity() == capacity); // still sized by the config, not the 3 orders
+    assert_same_book(book, target);
+    assert(target.order_count() == 3 && !target.find(7).valid() && target.cancel_order(2));
+
+    // a snapshot larger than the configured capacity sizes the index for itself
+    OrderBook small(BookConfig{DEFAULT_TICK_SIZE, DEFAULT_LADDER_WIDTH, 2});
+    assert(small.load_snapshot(path) == 9u && small.order_capacity() >= 3);
+
+    std::remove(path.c_str());
+}
+
+static void wait_for_checkpoints(const BookCheckpointer& checkpointer, uint64_t n) {
+    while (checkpointer.checkpoints() < n) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+}
+
+// Checkpoint while live, restart from the snapshot and resume the sequenced
+// stream from the start: the decoder drops what the snapshot already holds
+void test_checkpoint_and_resume() {
+    std::string path = temp_path("resume");
+    std::remove(path.c_str());
+
+    auto msgs = make_messages(50000, 2);
+    std::vector<uint8_t> stream(msgs.size() * 64);
+    size_t stream_size = 0;
+    for (size_t i = 0; i < msgs.size(); ++i) stream_size += encode_sequenced(msgs[i], i + 1, stream.data() + stream_size);
+
+    OrderBook live;
+    const size_t crash_at = 30000;
+    {
+        BookCheckpointer checkpointer(path);
+        assert(checkpointer.start_sequence() == 0);
+        for (size_t i = 0; i < crash_at; ++i) {
+            apply_message(live, msgs[i]);
+            assert(checkpointer.forward(msgs[i], i + 1));
+            if (i + 1 == 10000 || i + 1 == 25000) assert(checkpointer.checkpoint());
+        }
+        wait_for_checkpoints(checkpointer, 2);
+        assert(checkpointer.checkpoint_sequence() == 25000);
+        assert(!checkpointer.diverged() && checkpointer.failures() == 0);
+    }
+
+    OrderBook restarted;
+    auto sequence = restarted.load_snapshot(path);
+    assert(sequence && *sequence == 25000);
+
+    SequencedDecoder decoder(*sequence + 1);
+    decoder.decode(stream.data(), stream_size, [&](const MarketMessage& msg) {
+        apply_message(restarted, msg);
+        return true;
+    });
+    assert(decoder.duplicates() == 25000);
+
+    for (size_t i = crash_at; i < msgs.size(); ++i) apply_message(live, msgs[i]);
+    assert_same_book(live, restarted);
+
+    // a checkpointer on the same path picks up where the snapshot left off
+    BookCheckpointer resumed(path);
+    assert(resumed.start_sequence() == 25000);
+    for (size_t i = 25000; i < msgs.size(); ++i) resumed.forward(msgs[i], i + 1);
+    assert(resumed.checkpoint());
+    wait_for_checkpoints(resumed, 1);
+    assert(resumed.checkpoint_sequence() == msgs.size());
+
+    OrderBook latest;
+    assert(latest.load_snapshot(path) == msgs.size());
+    assert_same_book(live, latest);
+
+    std::remove(path.c_str());
+}
+
+int main() {
+    test_round_trip();
+    test_fixed_book_round_trip();
+    test_rejects_bad_files();
+    test_rejects_inconsistent_orders();
+    test_checkpoint_and_resume();
+
+    std::cout << "All BookSnapshot tests passed!\n";
+    return 0;
+}
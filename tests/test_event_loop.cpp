@@ -0,0 +1,140 @@
+#include "../include/utils/event_loop.hpp"
+#include "../include/utils/slot_queue.hpp"
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <thread>
+
+using namespace trading;
+
+using Queue = SlotQueue<uint64_t, 256>;
+
+// Every strategy hands over all messages, in order, and drains on stop
+template <typename Wait>
+void check_delivery(Wait wait, Wakeup* wakeup) {
+    auto queue = std::make_unique<Queue>();
+    EventLoop<Queue, Wait> loop(*queue, std::move(wait));
+
+    uint64_t expected = 0;
+    bool in_order = true;
+    loop.start([&](uint64_t& value) { in_order &= value == expected++; });
+
+    constexpr uint64_t N = 20000;
+    for (uint64_t i = 0; i < N; ++i) {
+        while (!queue->push(i)) std::this_thread::yield();
+        if (wakeup) wakeup->notify();
+        // let the consumer go idle now and then
+        if (i % 5000 == 0) std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    loop.stop();
+
+    assert(in_order);
+    assert(expected == N);
+    assert(loop.stats().messages == N);
+    assert(!loop.running());
+}
+
+void test_strategies() {
+    check_delivery(BusySpinWait{}, nullptr);
+    check_delivery(SpinYieldWait{16}, nullptr);
+    Wakeup wakeup;
+    check_delivery(BlockingWait(wakeup, 16), &wakeup);
+}
+
+// A blocked loop sleeps until notified, and stop() wakes it
+void test_blocking() {
+    auto queue = std::make_unique<Queue>();
+    Wakeup wakeup;
+    EventLoop<Queue, BlockingWait> loop(*queue, BlockingWait(wakeup, 0));
+
+    std::atomic<uint64_t> handled{0};
+    loop.start([&](uint64_t&) { handled.fetch_add(1); });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    queue->push(1);
+    wakeup.notify();
+    while (handled.load() == 0) std::this_thread::yield();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    loop.stop(); // must not hang
+    assert(loop.wait_strategy().sleeps() >= 1);
+
+    // all idle time: the one message took almost none
+    auto stats = loop.stats();
+    assert(stats.messages == 1);
+    assert(stats.idle_ns > 10'000'000);
+    assert(stats.utilisation() < 0.5);
+}
+
+// Busy time accumulates while the handler works
+void test_accounting() {
+    auto queue = std::make_unique<Queue>();
+    EventLoop<Queue, SpinYieldWait> loop(*queue);
+
+    for (int i = 0; i < 10; ++i) queue->push(i);
+    loop.start([](uint64_t&) { std::this_thread::sleep_for(std::chrono::milliseconds(2)); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    loop.stop();
+
+    auto stats = loop.stats();
+    assert(stats.messages == 10);
+    assert(stats.busy_ns >= 20'000'000);
+    assert(stats.idle_ns > 0);
+}
+
+// Under sustained load the loop never goes idle; busy time is still published
+void test_accounting_under_load() {
+    using BigQueue = SlotQueue<uint64_t, 4096>;
+    auto queue = std::make_unique<BigQueue>();
+    for (uint64_t i = 0; i < 3000; ++i) assert(queue->push(i));
+
+    EventLoop<BigQueue> loop(*queue);
+    bool checked = false;
+    loop.run([&](uint64_t& value) {
+        if (value != 2500) return;
+        auto stats = loop.stats();
+        assert(stats.messages == 2500 && stats.busy_ns > 0 && stats.idle_ns == 0);
+        checked = true;
+        loop.stop();
+    });
+    assert(checked && loop.stats().messages == 3000);
+
+    std::cout << "All EventLoop accounting under load tests passed!\n";
+}
+
+// Idle time rises while the loop waits, not only once work arrives
+template <typename Wait>
+void check_idle_rising(Wait wait) {
+    auto queue = std::make_unique<Queue>();
+    EventLoop<Queue, Wait> loop(*queue, std::move(wait));
+    loop.start([](uint64_t&) {});
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    auto first = loop.stats();
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    auto second = loop.stats();
+    assert(first.messages == 0 && second.messages == 0);
+    assert(first.idle_ns > 0 && second.idle_ns >= first.idle_ns + 5'000'000);
+    assert(second.utilisation() < 0.5);
+    loop.stop();
+}
+
+void test_idle_accounting() {
+    check_idle_rising(SpinYieldWait{16});
+    Wakeup wakeup;
+    check_idle_rising(BlockingWait(wakeup, 16));
+
+    std::cout << "All EventLoop idle accounting tests passed!\n";
+}
+
+int main() {
+    test_strategies();
+    test_blocking();
+    test_accounting();
+    test_accounting_under_load();
+    test_idle_accounting();
+
+    std::cout << "All EventLoop tests passed!\n";
+    return 0;
+}
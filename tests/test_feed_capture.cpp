@@ -0,0 +1,180 @@
+#include "../include/core/feed_capture.hpp"
+#include "../include/core/market_data_handler.hpp"
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <unistd.h>
+
+using namespace trading;
+
+static std::string temp_path(const char* name) {
+    return std::string("/tmp/") + name + "_" + std::to_string(capture_timestamp_ns()) + ".cap";
+}
+
+void test_capture_round_trip() {
+    std::string path = temp_path("test_capture");
+    uint8_t payload[300];
+    for (size_t i = 0; i < sizeof(payload); ++i) payload[i] = static_cast<uint8_t>(i);
+
+    {
+        // small buffer forces several flushes and one oversized frame
+        CaptureWriter writer(path, 128);
+        assert(writer.is_open());
+        for (uint64_t i = 0; i < 50; ++i) assert(writer.write(payload, i, 1000 + i));
+        assert(writer.write(payload, sizeof(payload), 5000, CaptureKind::Packet));
+        assert(writer.frames() == 51);
+    }
+
+    CaptureReader reader(path);
+    assert(reader.is_open());
+    CaptureFrame frame;
+    for (uint64_t i = 0; i < 50; ++i) {
+        assert(reader.next(frame));
+        assert(frame.kind == CaptureKind::Message);
+        assert(frame.size == i && frame.timestamp_ns == 1000 + i);
+        assert(std::memcmp(frame.data, payload, i) == 0);
+    }
+    assert(reader.next(frame));
+    assert(frame.kind == CaptureKind::Packet && frame.size == sizeof(payload));
+    assert(!reader.next(frame));
+
+    reader.rewind();
+    assert(reader.next(frame) && frame.timestamp_ns == 1000);
+
+    std::remove(path.c_str());
+    std::cout << "All capture round-trip tests passed!\n";
+}
+
+void test_capture_truncated() {
+    std::string path = temp_path("test_capture_truncated");
+    uint8_t payload[32] = {};
+    {
+        CaptureWriter writer(path);
+        writer.write(payload, sizeof(payload), 1);
+        writer.write(payload, sizeof(payload), 2);
+    }
+
+    // chop the last frame short: it is ignored
+    std::FILE* f = std::fopen(path.c_str(), "rb");
+    std::fseek(f, 0, SEEK_END);
+    long size = std::ftell(f);
+    std::fclose(f);
+    assert(::truncate(path.c_str(), size - 5) == 0);
+
+    CaptureReader reader(path);
+    CaptureFrame frame;
+    assert(reader.next(frame) && frame.timestamp_ns == 1);
+    assert(!reader.next(frame));
+
+    // not a capture
+    f = std::fopen(path.c_str(), "wb");
+    std::fputs("definitely not a capture file", f);
+    std::fclose(f);
+    assert(!CaptureReader(path).is_open());
+    assert(!CaptureReader("/nonexistent/capture.cap").is_open());
+
+    std::remove(path.c_str());
+    std::cout << "All capture truncation tests passed!\n";
+}
+
+void test_handler_recorder() {
+    std::string path = temp_path("test_capture_handler");
+    MarketDataHandler::Queue queue;
+    MarketDataHandler handler(queue);
+
+    MarketMessage in{};
+    in.type = MessageType::AddOrder;
+    in.instrument = 3;
+    in.add = {1, Side::Bid, 100, 10};
+    uint8_t buffer[2 * (sizeof(MarketMessage) + MESSAGE_HEADER_SIZE)];
+    size_t size = encode_message(in, buffer);
+
+    {
+        CaptureWriter writer(path);
+        handler.set_recorder(&writer);
+        assert(handler.push_raw_message(buffer, size));
+        size_t packet = size + encode_message(in, buffer + size);
+        assert(handler.push_raw_packet(buffer, packet) == 2);
+        handler.set_recorder(nullptr);
+        assert(handler.push_raw_message(buffer, size)); // not recorded
+    }
+
+    CaptureReader reader(path);
+    CaptureFrame frame;
+    assert(reader.next(frame));
+    assert(frame.kind == CaptureKind::Message && frame.size == size);
+    assert(std::memcmp(frame.data, buffer, size) == 0);
+    uint64_t first = frame.timestamp_ns;
+    assert(reader.next(frame));
+    assert(frame.kind == CaptureKind::Packet && frame.size == 2 * size);
+    assert(frame.timestamp_ns >= first);
+    assert(!reader.next(frame));
+
+    std::remove(path.c_str());
+    std::cout << "All handler recorder tests passed!\n";
+}
+
+// A push refused by a full queue records nothing: the retry records the
+// buffer, so each message is captured once however often it is offered
+void test_recorder_backpressure() {
+    std::string path = temp_path("test_capture_backpressure");
+    MarketDataHandler::Queue queue;
+    MarketDataHandler handler(queue);
+
+    MarketMessage in{};
+    in.type = MessageType::CancelOrder;
+    in.instrument = 3;
+    in.cancel = {1};
+    uint8_t buffer[3 * (sizeof(MarketMessage) + MESSAGE_HEADER_SIZE)];
+    size_t size = encode_message(in, buffer);
+    size_t packet = size + encode_message(in, buffer + size);
+    packet += encode_message(in, buffer + packet);
+
+    {
+        CaptureWriter writer(path);
+        handler.set_recorder(&writer);
+        for (size_t i = 0; i < queue.capacity(); ++i) assert(handler.push_raw_message(buffer, size));
+        for (int retry = 0; retry < 3; ++retry) assert(!handler.push_raw_message(buffer, size));
+        assert(handler.push_raw_packet(buffer, packet) == 0);
+        assert(writer.frames() == queue.capacity());
+
+        // room for one: the message, then the packet a frame at a time
+        queue.release(queue.consume());
+        assert(handler.push_raw_message(buffer, size));
+        size_t offset = 0;
+        while (offset < packet) {
+            queue.release(queue.consume());
+            size_t accepted = handler.push_raw_packet(buffer + offset, packet - offset);
+            assert(accepted == 1);
+            offset += size;
+        }
+        assert(writer.frames() == queue.capacity() + 4);
+
+        // a malformed message is recorded once, as received
+        assert(!handler.push_raw_message(buffer, size - 1));
+        assert(writer.frames() == queue.capacity() + 5);
+    }
+
+    CaptureReader reader(path);
+    CaptureFrame frame;
+    size_t frames = 0, bytes = 0;
+    while (reader.next(frame)) {
+        ++frames;
+        bytes += frame.size;
+    }
+    assert(frames == queue.capacity() + 5);
+    assert(bytes == (queue.capacity() + 4) * size + size - 1);
+
+    std::remove(path.c_str());
+    std::cout << "All recorder backpressure tests passed!\n";
+}
+
+int main() {
+    test_capture_round_trip();
+    test_capture_truncated();
+    test_handler_recorder();
+    test_recorder_backpressure();
+    return 0;
+}
@@ -0,0 +1,79 @@
+#include "../include/utils/flat_hash_map.hpp"
+#include "../include/core/order_book.hpp"
+#include <cassert>
+#include <iostream>
+#include <unordered_map>
+#include <random>
+
+using namespace trading;
+
+void test_flat_hash_map() {
+    FlatHashMap<OrderId, Order> map(4);
+
+    // Insert and lookup
+    auto [it, inserted] = map.emplace(1, Order{1, Side::Bid, 100, 10});
+    assert(inserted);
+    assert(it->second.price == 100);
+    assert(!map.emplace(1, Order{1, Side::Ask, 200, 5}).second); // duplicate keeps the original
+    assert(map.find(1)->second.price == 100);
+    assert(map.find(2) == map.end());
+
+    // In-place update through the iterator
+    map.find(1)->second.quantity = 25;
+    assert(map.find(1)->second.quantity == 25);
+
+    // Grows past the pre-sized capacity
+    for (OrderId id = 2; id <= 100; ++id) map.emplace(id, Order{id, Side::Ask, 100 + Price(id), 1});
+    assert(map.size() == 100);
+    for (OrderId id = 1; id <= 100; ++id) assert(map.find(id) != map.end());
+
+    // Erase by key and by iterator
+    assert(map.erase(OrderId(50)) == 1);
+    assert(map.erase(OrderId(50)) == 0);
+    map.erase(map.find(51));
+    assert(map.size() == 98);
+    assert(map.find(50) == map.end());
+    assert(map.find(52)->second.id == 52);
+
+    // Iteration visits every entry once
+    size_t count = 0;
+    for (auto& [id, order] : map) {
+        assert(id == order.id);
+        ++count;
+    }
+    assert(count == map.size());
+
+    std::cout << "All FlatHashMap tests passed!\n";
+}
+
+// Random inserts/erases checked against std::unordered_map
+void test_flat_hash_map_random() {
+    FlatHashMap<uint64_t, uint64_t> map(1024);
+    std::unordered_map<uint64_t, uint64_t> reference;
+    std::mt19937_64 gen(1);
+    std::uniform_int_distribution<uint64_t> key_dist(1, 4000);
+
+    for (int i = 0; i < 200000; ++i) {
+        uint64_t key = key_dist(gen);
+        if (gen() % 2) {
+            bool inserted = map.emplace(key, i).second;
+            assert(inserted == reference.emplace(key, i).second);
+        } else {
+            assert(map.erase(key) == reference.erase(key));
+        }
+    }
+
+    assert(map.size() == reference.size());
+    for (auto& [key, value] : reference) {
+        auto it = map.find(key);
+        assert(it != map.end() && it->second == value);
+    }
+
+    std::cout << "All FlatHashMap random tests passed!\n";
+}
+
+int main() {
+    test_flat_hash_map();
+    test_flat_hash_map_random();
+    return 0;
+}
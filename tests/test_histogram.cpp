@@ -0,0 +1,72 @@
+#include "../include/utils/histogram.hpp"
+#include "../include/utils/tsc.hpp"
+#include <cassert>
+#include <iostream>
+#include <sstream>
+
+using namespace trading;
+
+void test_histogram() {
+    LatencyHistogram hist;
+    assert(hist.count() == 0 && hist.percentile(50) == 0);
+
+    // exact below 128
+    for (uint64_t v = 0; v < 128; ++v) hist.record(v);
+    assert(hist.percentile(50) == 63);
+    assert(hist.min() == 0 && hist.max() == 127);
+
+    // 1..100000 uniform: percentiles within bucket precision (1/64)
+    hist.reset();
+    for (uint64_t v = 1; v <= 100000; ++v) hist.record(v);
+    assert(hist.count() == 100000);
+    for (double p : {50.0, 90.0, 99.0, 99.9}) {
+        double expected = p / 100.0 * 100000;
+        double reported = static_cast<double>(hist.percentile(p));
+        assert(reported >= expected && reported <= expected * (1 + 1.0 / 64) + 1);
+    }
+    assert(hist.percentile(100) == 100000);
+    assert(hist.mean() > 50000 && hist.mean() < 50001);
+
+    // huge values stay in range
+    LatencyHistogram big;
+    big.record(UINT64_MAX);
+    big.record(1ULL << 40, 3);
+    assert(big.max() == UINT64_MAX);
+    uint64_t p50 = big.percentile(50);
+    assert(p50 >= (1ULL << 40) && p50 <= (1ULL << 40) + (1ULL << 40) / 64);
+
+    // merge
+    LatencyHistogram a, b;
+    a.record(10, 5);
+    b.record(1000, 5);
+    a.merge(b);
+    assert(a.count() == 10 && a.min() == 10 && a.max() == 1000);
+    assert(a.percentile(50) == 10 && a.percentile(60) >= 1000);
+
+    std::string json = a.to_json();
+    assert(json.find("\"count\":10") != std::string::npos);
+    assert(json.find("\"p99.9\":") != std::string::npos);
+
+    std::ostringstream text;
+    a.print(text, "merged");
+    assert(text.str().find("p99.99") != std::string::npos);
+
+    std::cout << "All LatencyHistogram tests passed!\n";
+}
+
+void test_tsc() {
+    const TscClock& clock = TscClock::instance();
+    assert(clock.ns_per_tick() > 0);
+    uint64_t start = tsc_now();
+    uint64_t end = tsc_now();
+    assert(end >= start);
+    assert(clock.to_ns(static_cast<uint64_t>(clock.ticks_per_ns() * 1000)) >= 990);
+
+    std::cout << "All TSC tests passed!\n";
+}
+
+int main() {
+    test_histogram();
+    test_tsc();
+    return 0;
+}
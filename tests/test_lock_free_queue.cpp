@@ -0,0 +1,80 @@
+#include "../include/utils/lock_free_queue.hpp"
+#include <cassert>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <cstdint>
+
+void test_lock_free_queue() {
+    LockFreeQueue<uint64_t, 4> queue;
+    uint64_t values[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+
+    // All N slots are usable
+    for (int i = 0; i < 4; ++i) assert(queue.push(&values[i]));
+    assert(!queue.push(&values[4]));
+    assert(queue.size_approx() == 4);
+
+    assert(queue.pop() == &values[0]);
+    assert(queue.push(&values[4]));
+
+    // Bulk pop returns what is there, in order
+    uint64_t* out[8];
+    assert(queue.pop_n(out, 8) == 4);
+    assert(out[0] == &values[1] && out[3] == &values[4]);
+    assert(queue.pop() == nullptr);
+
+    // Bulk push stops when full, wrapping around the ring
+    uint64_t* in[6] = {&values[0], &values[1], &values[2], &values[3], &values[4], &values[5]};
+    assert(queue.push_n(in, 6) == 4);
+    assert(queue.pop_n(out, 2) == 2);
+    assert(queue.push_n(in + 4, 2) == 2);
+    assert(queue.pop_n(out, 8) == 4);
+    assert(out[0] == &values[2] && out[3] == &values[5]);
+
+    std::cout << "All LockFreeQueue tests passed!\n";
+}
+
+// Producer and consumer threads mixing single and bulk operations
+void test_lock_free_queue_threads() {
+    constexpr uint64_t COUNT = 1000000;
+    std::vector<uint64_t> values(COUNT);
+    for (uint64_t i = 0; i < COUNT; ++i) values[i] = i;
+
+    LockFreeQueue<uint64_t, 256> queue;
+
+    std::thread producer([&]() {
+        uint64_t next = 0;
+        uint64_t* batch[16];
+        while (next < COUNT) {
+            if (next % 3 == 0) {
+                if (queue.push(&values[next])) ++next;
+                else std::this_thread::yield();
+                continue;
+            }
+            size_t n = std::min<uint64_t>(16, COUNT - next);
+            for (size_t i = 0; i < n; ++i) batch[i] = &values[next + i];
+            size_t pushed = queue.push_n(batch, n);
+            if (pushed == 0) std::this_thread::yield();
+            next += pushed;
+        }
+    });
+
+    uint64_t expected = 0;
+    uint64_t* batch[32];
+    while (expected < COUNT) {
+        size_t n = queue.pop_n(batch, expected % 2 == 0 ? 32 : 1);
+        if (n == 0) std::this_thread::yield();
+        for (size_t i = 0; i < n; ++i) assert(*batch[i] == expected++);
+    }
+
+    producer.join();
+    assert(queue.pop() == nullptr);
+
+    std::cout << "All LockFreeQueue thread tests passed!\n";
+}
+
+int main() {
+    test_lock_free_queue();
+    test_lock_free_queue_threads();
+    return 0;
+}
@@ -1,7 +1,9 @@
 #include "../include/core/market_data_handler.hpp"
 #include <iostream>
 #include <cassert>
+#include <cstddef>
 #include <cstring>
+#include <vector>
 
 using namespace trading;
 
@@ -11,15 +13,19 @@ void test_market_data_handler() {
     MarketDataHandler handler(queue);
 
     // --- Helper to push and pop a message ---
+    InstrumentId instrument = 42;
     auto push_and_pop = [&](MessageType type, const void* payload, size_t payload_size) -> MarketMessage* {
-        uint8_t buffer[1 + 64] = {}; // extra space
+        uint8_t buffer[MESSAGE_HEADER_SIZE + 64] = {}; // extra space
         buffer[0] = static_cast<uint8_t>(type);
-        std::memcpy(buffer + 1, payload, payload_size);
+        std::memcpy(buffer + 1, &instrument, sizeof(instrument));
+        std::memcpy(buffer + MESSAGE_HEADER_SIZE, payload, payload_size);
 
-        handler.push_raw_message(buffer, 1 + payload_size);
-        MarketMessage* msg = queue.pop();
+        bool pushed = handler.push_raw_message(buffer, MESSAGE_HEADER_SIZE + payload_size);
+        assert(pushed);
+        MarketMessage* msg = queue.consume();
         assert(msg != nullptr); // must have message
         assert(msg->type == type);
+        assert(msg->instrument == instrument);
         return msg;
     };
 
@@ -30,20 +36,20 @@ void test_market_data_handler() {
     assert(msg->add.side == add.side);
     assert(msg->add.price == add.price);
     assert(msg->add.qty == add.qty);
-    handler.release_message(msg);
+    queue.release(msg);
 
     // --- Test CancelOrder ---
     CancelOrderMsg cancel{1};
     msg = push_and_pop(MessageType::CancelOrder, &cancel, sizeof(cancel));
     assert(msg->cancel.orderId == cancel.orderId);
-    handler.release_message(msg);
+    queue.release(msg);
 
     // --- Test ModifyOrder ---
     ModifyOrderMsg modify{1, 50};
     msg = push_and_pop(MessageType::ModifyOrder, &modify, sizeof(modify));
     assert(msg->modify.orderId == modify.orderId);
     assert(msg->modify.newQty == modify.newQty);
-    handler.release_message(msg);
+    queue.release(msg);
 
     // --- Test Execute ---
     ExecuteMsg exec{1, 20, 1020};
@@ -51,7 +57,7 @@ void test_market_data_handler() {
     assert(msg->execute.orderId == exec.orderId);
     assert(msg->execute.qty == exec.qty);
     assert(msg->execute.price == exec.price);
-    handler.release_message(msg);
+    queue.release(msg);
 
     // --- Test Trade ---
     TradeMsg trade{1, 2, 30, 1010};
@@ -60,7 +66,7 @@ void test_market_data_handler() {
     assert(msg->trade.sellOrderId == trade.sellOrderId);
     assert(msg->trade.qty == trade.qty);
     assert(msg->trade.price == trade.price);
-    handler.release_message(msg);
+    queue.release(msg);
 
     // --- Test BBOUpdate ---
     BBOUpdateMsg bbo{1005, 1015, 50, 60};
@@ -69,12 +75,156 @@ void test_market_data_handler() {
     assert(msg->bbo.bestAsk == bbo.bestAsk);
     assert(msg->bbo.bidSize == bbo.bidSize);
     assert(msg->bbo.askSize == bbo.askSize);
-    handler.release_message(msg);
+    queue.release(msg);
+
+    // --- Too short for the header ---
+    uint8_t short_buffer[2] = {static_cast<uint8_t>(MessageType::CancelOrder), 0};
+    assert(!handler.push_raw_message(short_buffer, sizeof(short_buffer)));
+    assert(queue.consume() == nullptr);
+
+    // --- Short payload and unknown type are dropped, not queued half-filled ---
+    uint8_t buffer[MESSAGE_HEADER_SIZE + sizeof(AddOrderMsg)] = {};
+    buffer[0] = static_cast<uint8_t>(MessageType::AddOrder);
+    assert(!handler.push_raw_message(buffer, sizeof(buffer) - 1));
+    buffer[0] = 0xff;
+    assert(!handler.push_raw_message(buffer, sizeof(buffer)));
+    assert(queue.consume() == nullptr);
 
     std::cout << "All MarketDataHandler tests passed!\n";
 }
 
+void test_encode_and_apply() {
+    MarketDataHandler::Queue queue;
+    MarketDataHandler handler(queue);
+    OrderBook book;
+
+    // encode_message round-trips through the handler
+    MarketMessage in{};
+    in.type = MessageType::AddOrder;
+    in.instrument = 7;
+    in.add = {5, Side::Ask, 80010, 12};
+
+    uint8_t buffer[sizeof(MarketMessage) + MESSAGE_HEADER_SIZE];
+    size_t size = encode_message(in, buffer);
+    assert(size == MESSAGE_HEADER_SIZE + sizeof(AddOrderMsg));
+    assert(handler.push_raw_message(buffer, size));
+
+    MarketMessage* msg = queue.consume();
+    assert(msg && msg->instrument == 7);
+    apply_message(book, *msg);
+    queue.release(msg);
+    assert(book.get_best_ask().value() == 80010);
+
+    in.type = MessageType::Execute;
+    in.execute = {5, 12, 80010};
+    apply_message(book, in);
+    assert(!book.get_best_ask().has_value());
+
+    std::cout << "All encode/apply tests passed!\n";
+}
+
+void test_push_raw_packet() {
+    MarketDataHandler::Queue queue;
+    MarketDataHandler handler(queue);
+
+    // 100 frames spans more than one internal batch
+    std::vector<uint8_t> packet(100 * (sizeof(MarketMessage) + MESSAGE_HEADER_SIZE));
+    size_t size = 0;
+    MarketMessage in{};
+    for (uint64_t i = 0; i < 100; ++i) {
+        in.instrument = static_cast<InstrumentId>(i % 3);
+        if (i % 2 == 0) {
+            in.type = MessageType::AddOrder;
+            in.add = {i, Side::Bid, 100 + Price(i), 1};
+        } else {
+            in.type = MessageType::CancelOrder;
+            in.cancel = {i - 1};
+        }
+        size += encode_message(in, packet.data() + size);
+    }
+
+    // trailing truncated frame is ignored
+    packet[size] = static_cast<uint8_t>(MessageType::AddOrder);
+    size_t accepted = handler.push_raw_packet(packet.data(), size + MESSAGE_HEADER_SIZE + 3);
+    assert(accepted == 100);
+
+    for (uint64_t i = 0; i < 100; ++i) {
+        MarketMessage* msg = queue.consume();
+        assert(msg != nullptr);
+        assert(msg->instrument == i % 3);
+        if (i % 2 == 0) {
+            assert(msg->type == MessageType::AddOrder);
+            assert(msg->add.orderId == i && msg->add.price == 100 + Price(i));
+        } else {
+            assert(msg->type == MessageType::CancelOrder);
+            assert(msg->cancel.orderId == i - 1);
+        }
+        queue.release(msg);
+    }
+    assert(queue.consume() == nullptr);
+
+    // unknown type stops the walk
+    uint8_t bad[MESSAGE_HEADER_SIZE + 8] = {0xff};
+    assert(handler.push_raw_packet(bad, sizeof(bad)) == 0);
+
+    // so does a side other than Bid or Ask, after the frames before it
+    in.type = MessageType::AddOrder;
+    in.add = {1, Side::Ask, 100, 1};
+    size = encode_message(in, packet.data());
+    size_t second = size;
+    size += encode_message(in, packet.data() + size);
+    uint32_t side = 2;
+    std::memcpy(packet.data() + second + MESSAGE_HEADER_SIZE + offsetof(AddOrderMsg, side), &side, sizeof(side));
+    assert(handler.push_raw_packet(packet.data(), size) == 1);
+    MarketMessage* msg = queue.consume();
+    assert(msg != nullptr && msg->add.side == Side::Ask);
+    queue.release(msg);
+    assert(queue.consume() == nullptr);
+
+    // and drops a lone message
+    assert(!handler.push_raw_message(packet.data() + second, size - second));
+    assert(queue.consume() == nullptr);
+
+    std::cout << "All push_raw_packet tests passed!\n";
+}
+
+// A full queue is told apart from a malformed message, whatever the queue
+// holds by the time the caller looks
+void test_queue_full() {
+    MarketDataHandler::Queue queue;
+    MarketDataHandler handler(queue);
+
+    MarketMessage in{};
+    in.type = MessageType::CancelOrder;
+    in.cancel = {1};
+    uint8_t buffer[2 * (sizeof(MarketMessage) + MESSAGE_HEADER_SIZE)];
+    size_t size = encode_message(in, buffer);
+    size_t packet = size + encode_message(in, buffer + size);
+
+    for (size_t i = 0; i < queue.capacity(); ++i) assert(handler.push_raw_message(buffer, size));
+    assert(!handler.push_raw_message(buffer, size) && handler.queue_full());
+
+    // freeing a slot afterwards does not change why the push failed
+    queue.release(queue.consume());
+    assert(handler.queue_full());
+
+    // the packet stops at the slot it could not get
+    assert(handler.push_raw_packet(buffer, packet) == 1 && handler.queue_full());
+
+    // a malformed message fails for its own reason, full queue or not
+    assert(!handler.push_raw_message(buffer, size - 1) && !handler.queue_full());
+    assert(handler.push_raw_packet(buffer, size - 1) == 0 && !handler.queue_full());
+
+    queue.release(queue.consume());
+    assert(handler.push_raw_message(buffer, size) && !handler.queue_full());
+
+    std::cout << "All queue full tests passed!\n";
+}
+
 int main() {
     test_market_data_handler();
+    test_encode_and_apply();
+    test_push_raw_packet();
+    test_queue_full();
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,126 @@
+#include "../include/core/matching_engine.hpp"
+#include <cassert>
+#include <iostream>
+#include <vector>
+
+using namespace trading;
+
+static std::vector<MarketMessage> drain(MatchingEngine& engine) {
+    std::vector<MarketMessage> out;
+    MarketMessage msg;
+    while (engine.poll_event(msg)) out.push_back(msg);
+    return out;
+}
+
+void test_matching_engine() {
+    MatchingEngine engine({1, 1024, 64}, DEFAULT_EVENT_CAPACITY, 42);
+
+    // Passive orders rest without trading
+    assert(engine.submit({1, Side::Ask, 101, 5}) == 0);
+    assert(engine.submit({2, Side::Ask, 101, 7}) == 0);
+    assert(engine.submit({3, Side::Ask, 103, 10}) == 0);
+    assert(engine.submit({4, Side::Bid, 99, 4}) == 0);
+    assert(drain(engine).empty());
+    assert(engine.book().get_best_ask().value() == 101);
+    assert(engine.book().get_best_bid().value() == 99);
+
+    // Aggressive buy sweeps 101 in time priority, then part of 103
+    assert(engine.submit({10, Side::Bid, 103, 15}) == 15);
+    auto events = drain(engine);
+    assert(events.size() == 6);
+    assert(events[0].type == MessageType::Trade);
+    assert(events[0].trade.buyOrderId == 10 && events[0].trade.sellOrderId == 1);
+    assert(events[0].trade.qty == 5 && events[0].trade.price == 101);
+    assert(events[1].type == MessageType::Execute);
+    assert(events[1].execute.orderId == 1 && events[1].execute.qty == 5);
+    assert(events[2].trade.sellOrderId == 2 && events[2].trade.qty == 7);
+    assert(events[4].trade.sellOrderId == 3 && events[4].trade.qty == 3);
+    assert(events[4].trade.price == 103);
+    for (const MarketMessage& event : events) assert(event.instrument == 42);
+
+    assert(engine.book().get_best_ask().value() == 103);
+    assert(engine.book().get_level(Side::Ask, 103) == 7);
+    assert(engine.book().get_level(Side::Ask, 101) == 0);
+    assert(engine.resting_orders() == 2);
+
+    // Partially filled aggressor rests the remainder
+    assert(engine.submit({11, Side::Bid, 103, 9}) == 7);
+    events = drain(engine);
+    assert(events.size() == 2);
+    assert(engine.book().get_best_bid().value() == 103);
+    assert(engine.book().get_level(Side::Bid, 103) == 2);
+    assert(!engine.book().get_best_ask().has_value());
+
+    // Aggressive sell fills bids at the resting prices
+    assert(engine.submit({12, Side::Ask, 99, 3}) == 3);
+    events = drain(engine);
+    assert(events.size() == 4);
+    assert(events[0].trade.buyOrderId == 11 && events[0].trade.qty == 2 && events[0].trade.price == 103);
+    assert(events[2].trade.buyOrderId == 4 && events[2].trade.qty == 1 && events[2].trade.price == 99);
+    assert(engine.book().get_level(Side::Bid, 99) == 3);
+
+    // Duplicate id is rejected
+    assert(engine.submit({4, Side::Bid, 98, 1}) == 0);
+    assert(engine.book().get_level(Side::Bid, 98) == 0);
+
+    std::cout << "All MatchingEngine tests passed!\n";
+}
+
+void test_matching_engine_priority() {
+    MatchingEngine engine;
+
+    engine.submit({1, Side::Bid, 100, 5});
+    engine.submit({2, Side::Bid, 100, 5});
+    engine.submit({3, Side::Bid, 100, 5});
+
+    // Size increase sends order 1 to the back; decrease keeps order 2 in place
+    assert(engine.modify_order(1, 6));
+    assert(engine.modify_order(2, 4));
+    assert(engine.book().get_level(Side::Bid, 100) == 15);
+
+    // Cancel from the middle of the queue
+    assert(engine.cancel_order(3));
+    assert(!engine.cancel_order(3));
+
+    // External fill on the queue head
+    assert(engine.execute_order(2, 1));
+    assert(engine.book().get_level(Side::Bid, 100) == 9);
+
+    engine.submit({9, Side::Ask, 100, 9});
+    auto events = drain(engine);
+    assert(events.size() == 4);
+    assert(events[0].trade.buyOrderId == 2 && events[0].trade.qty == 3);
+    assert(events[2].trade.buyOrderId == 1 && events[2].trade.qty == 6);
+    assert(!engine.book().get_best_bid().has_value());
+    assert(engine.resting_orders() == 0);
+
+    std::cout << "All MatchingEngine priority tests passed!\n";
+}
+
+// Quantities the book refuses leave the engine's queue alone too, so later
+// matches trade what the book shows
+void test_matching_engine_bad_quantities() {
+    MatchingEngine engine;
+    engine.submit({1, Side::Bid, 100, 10});
+
+    assert(!engine.execute_order(1, -5) && !engine.execute_order(1, 0));
+    assert(engine.book().get_level(Side::Bid, 100) == 10);
+    assert(engine.submit({2, Side::Ask, 100, 15}) == 10);
+    assert(engine.book().get_level(Side::Ask, 100) == 5 && !engine.book().get_best_bid());
+    drain(engine);
+
+    engine.submit({3, Side::Bid, 99, 4});
+    assert(!engine.modify_order(3, -2));
+    assert(engine.book().get_level(Side::Bid, 99) == 4 && engine.resting_orders() == 2);
+    assert(engine.submit({4, Side::Ask, 99, 10}) == 4);
+    assert(engine.book().get_level(Side::Ask, 99) == 6 && !engine.book().get_best_bid());
+
+    std::cout << "All MatchingEngine bad quantity tests passed!\n";
+}
+
+int main() {
+    test_matching_engine();
+    test_matching_engine_priority();
+    test_matching_engine_bad_quantities();
+    return 0;
+}
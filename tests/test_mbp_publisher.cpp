@@ -0,0 +1,111 @@
+#include "../include/core/mbp_publisher.hpp"
+#include <cassert>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+using namespace trading;
+
+static std::vector<MarketMessage> drain(MbpPublisher::Queue& queue) {
+    std::vector<MarketMessage> out;
+    MarketMessage msg;
+    while (queue.pop(msg)) out.push_back(msg);
+    return out;
+}
+
+void test_levels_and_bbo() {
+    OrderBook book;
+    auto queue = std::make_unique<MbpPublisher::Queue>();
+    MbpPublisher publisher(book, *queue, 7);
+
+    assert(publisher.publish() == 0); // nothing changed
+
+    book.add_order({1, Side::Bid, 100, 10});
+    book.add_order({2, Side::Bid, 100, 5});
+    book.add_order({3, Side::Bid, 99, 20});
+    book.add_order({4, Side::Ask, 101, 7});
+    assert(publisher.publish() == 4);
+
+    auto msgs = drain(*queue);
+    assert(msgs.size() == 4);
+    // bids then asks, best first; BBO last
+    assert(msgs[0].type == MessageType::LevelUpdate && msgs[0].instrument == 7);
+    assert(msgs[0].level.side == Side::Bid && msgs[0].level.price == 100 && msgs[0].level.qty == 15);
+    assert(msgs[1].level.side == Side::Bid && msgs[1].level.price == 99 && msgs[1].level.qty == 20);
+    assert(msgs[2].level.side == Side::Ask && msgs[2].level.price == 101 && msgs[2].level.qty == 7);
+    assert(msgs[3].type == MessageType::BBOUpdate);
+    assert(msgs[3].bbo.bestBid == 100 && msgs[3].bbo.bidSize == 15);
+    assert(msgs[3].bbo.bestAsk == 101 && msgs[3].bbo.askSize == 7);
+
+    // several changes to one level in a batch conflate to one update; the
+    // top is unchanged, so no BBO
+    book.modify_order(3, 30);
+    book.execute_order(3, 5);
+    book.add_order({5, Side::Bid, 99, 1});
+    assert(publisher.publish() == 1);
+    msgs = drain(*queue);
+    assert(msgs[0].level.price == 99 && msgs[0].level.qty == 26);
+    assert(publisher.level_changes() == 7);
+
+    // a removed level is published with quantity 0
+    book.cancel_order(4);
+    assert(publisher.publish() == 2);
+    msgs = drain(*queue);
+    assert(msgs[0].level.side == Side::Ask && msgs[0].level.qty == 0);
+    assert(msgs[1].type == MessageType::BBOUpdate && msgs[1].bbo.bestAsk == 0);
+
+    assert(publisher.bytes() == 5 * (MESSAGE_HEADER_SIZE + sizeof(LevelUpdateMsg)) +
+                                    2 * (MESSAGE_HEADER_SIZE + sizeof(BBOUpdateMsg)));
+    assert(publisher.messages() == 7);
+}
+
+// A full ring never blocks the book: levels wait and go out with their
+// latest quantity once the subscriber catches up
+void test_slow_subscriber() {
+    OrderBook book;
+    auto queue = std::make_unique<MbpPublisher::Queue>();
+    MbpPublisher publisher(book, *queue);
+
+    size_t capacity = MbpPublisher::Queue::capacity();
+    OrderId id = 1;
+    for (size_t i = 0; i < capacity + 100; ++i) book.add_order({id++, Side::Bid, 1000 - Price(i), 1});
+    assert(publisher.publish() == capacity);
+    assert(publisher.pending() == 100);
+
+    // more changes to pending levels while the subscriber is away
+    for (size_t i = capacity; i < capacity + 100; ++i) book.add_order({id++, Side::Bid, 1000 - Price(i), 2});
+    assert(publisher.publish() == 0);
+    assert(publisher.pending() == 100);
+
+    auto first = drain(*queue);
+    assert(first.size() == capacity);
+    for (const auto& msg : first) assert(msg.type == MessageType::LevelUpdate);
+
+    // the rest, conflated to their latest state, then the BBO
+    assert(publisher.publish() == 101);
+    auto rest = drain(*queue);
+    for (size_t i = 0; i < 100; ++i) assert(rest[i].level.qty == 3);
+    assert(rest.back().type == MessageType::BBOUpdate && rest.back().bbo.bestBid == 1000);
+}
+
+void test_tracking_lifetime() {
+    OrderBook book;
+    auto queue = std::make_unique<MbpPublisher::Queue>();
+    {
+        MbpPublisher publisher(book, *queue);
+        book.add_order({1, Side::Ask, 50, 1});
+        assert(book.changed_levels().size() == 1);
+    }
+    assert(book.changed_levels().empty());
+    book.add_order({2, Side::Ask, 51, 1});
+    assert(book.changed_levels().empty());
+}
+
+int main() {
+    test_levels_and_bbo();
+    test_slow_subscriber();
+    test_tracking_lifetime();
+
+    std::cout << "All MbpPublisher tests passed!\n";
+    return 0;
+}
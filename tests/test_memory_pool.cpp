@@ -0,0 +1,96 @@
+#include "../include/utils/memory_pool.hpp"
+#include "../include/utils/lock_free_queue.hpp"
+#include <cassert>
+#include <iostream>
+#include <thread>
+#include <set>
+#include <cstdint>
+
+struct Item {
+    uint64_t seq;
+    uint64_t check;
+};
+
+void test_memory_pool() {
+    MemoryPool<Item, 4> pool;
+    assert(pool.capacity() == 4);
+
+    std::set<Item*> handed_out;
+    for (int i = 0; i < 4; ++i) {
+        Item* item = pool.allocate();
+        assert(item && handed_out.insert(item).second);
+    }
+    assert(pool.allocate() == nullptr);
+    assert(pool.exhaustions() == 1);
+
+    // Owner release is reused first
+    Item* first = *handed_out.begin();
+    pool.release(first);
+    assert(pool.allocate() == first);
+
+    // Remote returns become visible once the local list runs dry
+    {
+        MemoryPool<Item, 4>::Cache cache(pool, 2);
+        auto it = handed_out.begin();
+        cache.release(*it++);
+        cache.release(*it++);
+        cache.release(*it++); // stays in the cache until flushed
+        assert(pool.allocate() != nullptr);
+        assert(pool.allocate() != nullptr);
+        assert(pool.allocate() == nullptr);
+    }
+    assert(pool.allocate() != nullptr); // flushed on destruction
+    assert(pool.exhaustions() == 2);
+
+    // Growable pools add a slab instead of failing
+    MemoryPool<Item, 4> growable(true);
+    for (int i = 0; i < 10; ++i) assert(growable.allocate() != nullptr);
+    assert(growable.slabs() == 3);
+    assert(growable.capacity() == 12);
+    assert(growable.exhaustions() == 2);
+
+    std::cout << "All MemoryPool tests passed!\n";
+}
+
+// Owner allocates and sends; another thread reads and frees through a Cache
+void test_memory_pool_threads() {
+    constexpr uint64_t COUNT = 500000;
+    MemoryPool<Item, 256> pool;
+    LockFreeQueue<Item, 128> queue;
+
+    std::thread consumer([&]() {
+        MemoryPool<Item, 256>::Cache cache(pool, 16);
+        for (uint64_t expected = 0; expected < COUNT;) {
+            Item* item = queue.pop();
+            if (!item) {
+                std::this_thread::yield();
+                continue;
+            }
+            assert(item->seq == expected && item->check == ~expected);
+            expected++;
+            cache.release(item);
+        }
+    });
+
+    for (uint64_t i = 0; i < COUNT; ++i) {
+        Item* item;
+        while (!(item = pool.allocate())) std::this_thread::yield();
+        *item = {i, ~i};
+        while (!queue.push(item)) std::this_thread::yield();
+    }
+
+    consumer.join();
+    assert(pool.slabs() == 1);
+
+    // everything came back
+    for (int i = 0; i < 256; ++i) assert(pool.allocate() != nullptr);
+    assert(pool.allocate() == nullptr);
+
+    std::cout << "All MemoryPool thread tests passed!\n";
+}
+
+int main() {
+    test_memory_pool();
+    test_memory_pool_threads();
+    return 0;
+}
@@ -3,6 +3,8 @@
 #include <cassert>
 #include <iostream>
 #include <algorithm>
+#include <random>
+#include <vector>
 
 using namespace trading;
 
@@ -10,10 +12,10 @@ void test_order_book() {
     OrderBook book;
 
     // Add bids and asks
-    book.add_order({1, Side::Bid, clamp_price(50), 10});
-    book.add_order({2, Side::Bid, clamp_price(55), 5});
-    book.add_order({3, Side::Ask, clamp_price(60), 8});
-    book.add_order({4, Side::Ask, clamp_price(58), 12});
+    book.add_order({1, Side::Bid, 50, 10});
+    book.add_order({2, Side::Bid, 55, 5});
+    book.add_order({3, Side::Ask, 60, 8});
+    book.add_order({4, Side::Ask, 58, 12});
 
     // Check best prices
     {
@@ -53,8 +55,258 @@ void test_order_book() {
     std::cout << "All OrderBook tests passed!\n";
 }
 
+void test_order_book_realistic_prices() {
+    OrderBook book({5, 1024});
+
+    // Prices far apart must land on distinct levels
+    book.add_order({1, Side::Bid, 79995, 10});
+    book.add_order({2, Side::Bid, 79990, 7});
+    book.add_order({3, Side::Ask, 80005, 4});
+    book.add_order({4, Side::Ask, 95000, 9}); // outside the window
+
+    assert(book.get_best_bid().value() == 79995);
+    assert(book.get_best_ask().value() == 80005);
+    assert(book.get_level(Side::Bid, 79995) == 10);
+    assert(book.get_level(Side::Bid, 79990) == 7);
+    assert(book.get_level(Side::Ask, 95000) == 9);
+
+    // Emptying the touch falls back to the next level
+    assert(book.cancel_order(1));
+    assert(book.get_best_bid().value() == 79990);
+    assert(book.execute_order(3, 4));
+    assert(book.get_best_ask().value() == 95000);
+
+    // Mid moves far away: the window recentres and far levels come back in
+    book.add_order({5, Side::Bid, 94990, 3});
+    assert(book.get_best_bid().value() == 94990);
+    assert(book.get_level(Side::Bid, 79990) == 7);
+    assert(book.get_level(Side::Ask, 95000) == 9);
+
+    assert(book.cancel_order(5));
+    assert(book.get_best_bid().value() == 79990);
+    assert(book.cancel_order(2));
+    assert(!book.get_best_bid().has_value());
+
+    std::cout << "All OrderBook realistic price tests passed!\n";
+}
+
+void test_order_book_depth() {
+    OrderBook book;
+    book.add_order({1, Side::Bid, 100, 10});
+    book.add_order({2, Side::Bid, 100, 5});
+    book.add_order({3, Side::Bid, 98, 20});
+    book.add_order({4, Side::Bid, 95, 30});
+    book.add_order({5, Side::Ask, 101, 7});
+    book.add_order({6, Side::Ask, 103, 3});
+
+    // top levels, best first, into caller arrays
+    Price prices[2];
+    Quantity quantities[2];
+    assert(book.get_depth(Side::Bid, prices, quantities) == 2);
+    assert(prices[0] == 100 && quantities[0] == 15);
+    assert(prices[1] == 98 && quantities[1] == 20);
+
+    Price ask_prices[8];
+    Quantity ask_quantities[8];
+    assert(book.get_depth(Side::Ask, ask_prices, ask_quantities) == 2);
+    assert(ask_prices[1] == 103 && ask_quantities[1] == 3);
+
+    // cumulative depth at limit or better
+    assert(book.get_cumulative_depth(Side::Bid, 98) == 35);
+    assert(book.get_cumulative_depth(Side::Bid, 99) == 15);
+    assert(book.get_cumulative_depth(Side::Bid, 101) == 0);
+    assert(book.get_cumulative_depth(Side::Ask, 102) == 7);
+    assert(book.get_cumulative_depth(Side::Ask, 1000) == 10);
+
+    // selling 25 into the bids: 15 @ 100, 10 @ 98
+    FillEstimate sell = book.get_vwap(Side::Bid, 25);
+    assert(sell.filled == 25 && sell.worst == 98);
+    assert(sell.vwap > 99.19 && sell.vwap < 99.21);
+
+    // buying more than the asks hold
+    FillEstimate buy = book.get_vwap(Side::Ask, 50);
+    assert(buy.filled == 10 && buy.worst == 103);
+    assert(buy.vwap > 101.59 && buy.vwap < 101.61);
+
+    assert(book.get_vwap(Side::Ask, 0).filled == 0);
+
+    std::cout << "All OrderBook depth tests passed!\n";
+}
+
+template <typename A, typename B>
+static void assert_same_depth(const A& a, const B& b) {
+    assert(a.get_best_bid() == b.get_best_bid());
+    assert(a.get_best_ask() == b.get_best_ask());
+    for (Side side : {Side::Bid, Side::Ask}) {
+        Price pa[32], pb[32];
+        Quantity qa[32], qb[32];
+        size_t n = a.get_depth(side, pa, qa);
+        assert(b.get_depth(side, pb, qb) == n);
+        for (size_t i = 0; i < n; ++i) assert(pa[i] == pb[i] && qa[i] == qb[i]);
+
+        Price limit = side == Side::Bid ? 99900 : 100100;
+        assert(a.get_cumulative_depth(side, limit) == b.get_cumulative_depth(side, limit));
+        FillEstimate fa = a.get_vwap(side, 500), fb = b.get_vwap(side, 500);
+        assert(fa.filled == fb.filled && fa.worst == fb.worst && fa.vwap == fb.vwap);
+    }
+}
+
+// Every policy combination behaves like the default book
+void test_order_book_policies() {
+    using Band = TickTraits<1, 90000, 110000>;
+    using FixedBook = BasicOrderBook<Band, FixedLadder<Band>>;
+    using StdMapBook = BasicOrderBook<RuntimeTicks, PriceLadder, StdOrderIndex>;
+    using DirectBook = BasicOrderBook<RuntimeTicks, PriceLadder, DirectOrderIndex>;
+    static_assert(Band::LEVELS == 20001);
+
+    OrderBook reference;
+    FixedBook fixed;
+    StdMapBook std_map;
+    DirectBook direct;
+    assert(fixed.tick_size() == 1);
+
+    std::mt19937 gen(3);
+    std::vector<OrderId> live;
+    OrderId next_id = 1;
+    for (int i = 0; i < 20000; ++i) {
+        int kind = live.empty() ? 0 : static_cast<int>(gen() % 4);
+        size_t pick = live.empty() ? 0 : gen() % live.size();
+        if (kind <= 1) {
+            Side side = gen() % 2 == 0 ? Side::Bid : Side::Ask;
+            Price offset = 1 + gen() % 300;
+            Order order{next_id, side, side == Side::Bid ? 100000 - offset : 100000 + offset,
+                        static_cast<Quantity>(1 + gen() % 50)};
+            reference.add_order(order);
+            fixed.add_order(order);
+            std_map.add_order(order);
+            direct.add_order(order);
+            live.push_back(next_id++);
+        } else if (kind == 2) {
+            OrderId id = live[pick];
+            live[pick] = live.back();
+            live.pop_back();
+            bool found = reference.cancel_order(id);
+            assert(fixed.cancel_order(id) == found && std_map.cancel_order(id) == found);
+            assert(direct.cancel_order(id) == found);
+        } else {
+            OrderId id = live[pick];
+            bool found = reference.execute_order(id, 5);
+            assert(fixed.execute_order(id, 5) == found && std_map.execute_order(id, 5) == found);
+            assert(direct.execute_order(id, 5) == found);
+        }
+        if (i % 500 == 0) {
+            assert_same_depth(reference, fixed);
+            assert_same_depth(reference, std_map);
+            assert_same_depth(reference, direct);
+        }
+    }
+    assert_same_depth(reference, fixed);
+    assert_same_depth(reference, std_map);
+    assert_same_depth(reference, direct);
+
+    // a bounded band drops orders off its grid or outside it
+    using Coarse = TickTraits<5, 1000, 2000>;
+    BasicOrderBook<Coarse, FixedLadder<Coarse>> coarse;
+    coarse.add_order({1, Side::Bid, 995, 1});
+    coarse.add_order({2, Side::Ask, 2005, 1});
+    coarse.add_order({3, Side::Ask, 1502, 1});
+    assert(!coarse.get_best_bid() && !coarse.get_best_ask());
+    assert(!coarse.cancel_order(1));
+    coarse.add_order({4, Side::Bid, 1000, 2});
+    coarse.add_order({5, Side::Ask, 2000, 3});
+    assert(coarse.get_best_bid() == 1000 && coarse.get_best_ask() == 2000);
+    assert(coarse.get_cumulative_depth(Side::Ask, 5000) == 3);
+    assert(coarse.get_vwap(Side::Bid, 10).worst == 1000);
+
+    std::cout << "All OrderBook policy tests passed!\n";
+}
+
+// Handles reach the same order as its id, and go stale once it leaves
+void test_order_handles() {
+    OrderBook book;
+    OrderHandle a = book.add_order({1, Side::Bid, 100, 10});
+    OrderHandle b = book.add_order({2, Side::Bid, 100, 5});
+    assert(a.valid() && b.valid() && !(a == b));
+    assert(book.find(1) == a && !book.find(3).valid());
+    assert(book.get_order(b)->id == 2);
+
+    // a duplicate id is refused and the level is left alone
+    assert(!book.add_order({1, Side::Bid, 99, 7}).valid());
+    assert(book.get_level(Side::Bid, 100) == 15 && book.get_level(Side::Bid, 99) == 0);
+
+    // executing nothing is refused and reports no level change
+    book.track_changes(true);
+    assert(!book.execute_order(b, 0) && !book.execute_order(2, -1) && book.changed_levels().empty());
+    book.track_changes(false);
+
+    assert(book.modify_order(a, 4));
+    assert(book.execute_order(b, 2));
+    assert(book.get_level(Side::Bid, 100) == 7 && book.get_order(b)->quantity == 3);
+
+    assert(book.execute_order(b, 3));
+    assert(!book.get_order(b) && !book.find(2).valid());
+    assert(!book.execute_order(b, 1) && !book.cancel_order(b) && !book.modify_order(b, 1));
+
+    // a new order may take the freed slot, but the old handle still misses
+    OrderHandle c = book.add_order({3, Side::Ask, 101, 1});
+    assert(!book.get_order(b) && book.get_order(c)->id == 3);
+    assert(!book.cancel_order(b) && book.get_best_ask() == 101);
+
+    assert(book.cancel_order(a) && !book.cancel_order(1));
+    assert(book.modify_order(c, 0) && !book.get_best_bid() && !book.get_best_ask());
+    assert(book.order_count() == 0);
+    assert(!book.cancel_order(OrderHandle{}));
+
+    // inline entries move as the table changes around them (Robin Hood
+    // displacement, backward shift, rehash); handles still find their order
+    OrderBook moving({1, 1024, 64});
+    std::vector<OrderHandle> handles;
+    for (OrderId id = 1; id <= 64; ++id) handles.push_back(moving.add_order({id, Side::Bid, 100, 1}));
+    for (OrderId id = 1; id <= 64; id += 2) assert(moving.cancel_order(handles[id - 1]));
+    for (OrderId id = 65; id <= 512; ++id) moving.add_order({id, Side::Ask, 200, 1});
+    for (OrderId id = 2; id <= 64; id += 2) {
+        assert(moving.get_order(handles[id - 1])->id == id);
+        assert(moving.modify_order(handles[id - 1], 2));
+    }
+    for (OrderId id = 1; id <= 64; id += 2) assert(!moving.get_order(handles[id - 1]));
+    assert(moving.get_level(Side::Bid, 100) == 64 && moving.order_count() == 480);
+
+    // the default index names an order by id: a handle finds a re-added id
+    assert(moving.cancel_order(2) && !moving.get_order(handles[1]));
+    assert(moving.add_order({2, Side::Bid, 100, 5}).valid());
+    assert(moving.get_order(handles[1])->quantity == 5 && moving.get_level(Side::Bid, 100) == 67);
+
+    // the slab-backed indexes reuse a freed slot under a new generation, so
+    // a handle to the old order stays stale even when its id comes back
+    BasicOrderBook<RuntimeTicks, PriceLadder, DirectOrderIndex> direct;
+    OrderHandle d = direct.add_order({1, Side::Bid, 100, 1});
+    assert(direct.cancel_order(d));
+    OrderHandle e = direct.add_order({1, Side::Bid, 100, 1});
+    assert(e.index == d.index && e.generation != d.generation);
+    assert(!direct.get_order(d) && !direct.cancel_order(d) && direct.cancel_order(e));
+
+    // the direct id map takes ids below its base and far beyond its span
+    DirectOrderIds index(16);
+    assert(index.insert(1000, {0, 1}) && index.insert(1001, {1, 1}));
+    assert(!index.insert(1000, {2, 1}));
+    assert(index.insert(5, {3, 1}) && index.insert(1000 + DirectOrderIds::MAX_SPAN, {4, 1}));
+    assert(index.find(5).index == 3 && index.find(1000 + DirectOrderIds::MAX_SPAN).index == 4);
+    assert(index.find(1001).index == 1 && !index.find(1002).valid() && index.size() == 4);
+    index.erase(1001);
+    index.erase(5);
+    index.erase(1002);
+    assert(!index.find(1001).valid() && !index.find(5).valid() && index.size() == 2);
+    index.clear();
+    assert(index.size() == 0 && !index.find(1000).valid());
+
+    std::cout << "All OrderBook handle tests passed!\n";
+}
 
 int main() {
     test_order_book();
+    test_order_book_realistic_prices();
+    test_order_book_depth();
+    test_order_book_policies();
+    test_order_handles();
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,157 @@
+#include "../include/core/price_ladder.hpp"
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <map>
+#include <random>
+
+using namespace trading;
+
+void test_price_ladder() {
+    PriceLadder ladder(10, 16); // window covers 16 ticks of 10
+
+    // First add anchors the window around the price
+    assert(ladder.add(1000, 5) == 5);
+    assert(ladder.anchored());
+    assert(ladder.in_window(1000));
+    assert(ladder.add(1000, 3) == 8);
+    assert(ladder.quantity(1000) == 8);
+
+    // Far prices go to the overflow store
+    assert(ladder.add(5000, 2) == 2);
+    assert(!ladder.in_window(5000));
+    assert(ladder.overflow_levels() == 1);
+    assert(ladder.quantity(5000) == 2);
+
+    // Best is the lowest non-empty normalized price, overflow included
+    assert(ladder.best().value() == 1000);
+    ladder.add(500, 1);
+    assert(ladder.best().value() == 500);
+    ladder.add(500, -1);
+    assert(ladder.overflow_levels() == 1);
+    assert(ladder.best().value() == 1000);
+
+    // Recentering moves in-window levels out and pulls overflow levels in
+    ladder.recenter(5000);
+    assert(ladder.in_window(5000));
+    assert(!ladder.in_window(1000));
+    assert(ladder.quantity(5000) == 2);
+    assert(ladder.quantity(1000) == 8);
+    assert(ladder.overflow_levels() == 1);
+    assert(ladder.best().value() == 1000);
+
+    // Small shift keeps overlapping levels in place
+    ladder.recenter(5050);
+    assert(ladder.quantity(5000) == 2);
+    ladder.add(1000, -8);
+    assert(ladder.overflow_levels() == 0);
+    assert(ladder.best().value() == 5000);
+
+    // Negative (bid) prices
+    PriceLadder bids(1, 8);
+    bids.add(-80000, 4);
+    bids.add(-79999, 6);
+    assert(bids.best().value() == -80000);
+    bids.add(-80000, -4);
+    assert(bids.best().value() == -79999);
+
+    std::cout << "All PriceLadder tests passed!\n";
+}
+
+// Random adds/removes and recenters checked against a plain ordered map
+void test_price_ladder_random() {
+    PriceLadder ladder(1, 8192); // three bitmap levels
+    std::map<Price, Quantity> reference;
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<Price> price_dist(-20000, 20000);
+
+    for (int i = 0; i < 20000; ++i) {
+        Price price = price_dist(gen);
+        if (i % 3 == 2 && !reference.empty()) {
+            auto it = reference.lower_bound(price);
+            if (it == reference.end()) it = reference.begin();
+            ladder.add(it->first, -it->second);
+            reference.erase(it);
+        } else {
+            ladder.add(price, 1);
+            ++reference[price];
+        }
+        if (i % 1000 == 0) ladder.recenter(price_dist(gen));
+
+        auto best = ladder.best();
+        assert(best.has_value() == !reference.empty());
+        if (best) assert(*best == reference.begin()->first);
+    }
+
+    for (auto& [price, qty] : reference) assert(ladder.quantity(price) == qty);
+
+    std::cout << "All PriceLadder random tests passed!\n";
+}
+
+// depth, depth_to and sweep against the same ordered map, with levels in
+// both overflow stores and a window that wraps around the array
+void test_price_ladder_depth_random() {
+    std::mt19937 gen(7);
+    for (int round = 0; round < 200; ++round) {
+        PriceLadder ladder(5, 256);
+        std::map<Price, Quantity> reference;
+        std::uniform_int_distribution<int64_t> tick_dist(-400, 400);
+        std::uniform_int_distribution<Quantity> qty_dist(1, 50);
+
+        ladder.recenter(tick_dist(gen) * 5);
+        int levels = 1 + static_cast<int>(gen() % 300);
+        for (int i = 0; i < levels; ++i) {
+            Price price = tick_dist(gen) * 5;
+            Quantity qty = qty_dist(gen);
+            ladder.add(price, qty);
+            reference[price] += qty;
+        }
+
+        // top levels
+        Price prices[64];
+        Quantity quantities[64];
+        size_t n = ladder.depth(64, prices, quantities);
+        assert(n == std::min<size_t>(64, reference.size()));
+        auto it = reference.begin();
+        for (size_t i = 0; i < n; ++i, ++it) assert(prices[i] == it->first && quantities[i] == it->second);
+
+        // cumulative depth, limits on and between ticks
+        for (int j = 0; j < 20; ++j) {
+            Price limit = tick_dist(gen) * 5 + static_cast<Price>(gen() % 5);
+            Quantity expected = 0;
+            for (auto& [price, qty] : reference)
+                if (price <= limit) expected += qty;
+            assert(ladder.depth_to(limit) == expected);
+        }
+
+        // sweeps of every size up to more than the whole side
+        Quantity total = 0;
+        for (auto& [price, qty] : reference) total += qty;
+        for (int j = 0; j < 20; ++j) {
+            Quantity want = 1 + static_cast<Quantity>(gen() % (total + 20));
+            Quantity filled = 0;
+            int64_t notional = 0;
+            Price last = 0;
+            for (auto& [price, qty] : reference) {
+                if (filled == want) break;
+                Quantity take = std::min(qty, want - filled);
+                filled += take;
+                notional += take * (price / 5);
+                last = price;
+            }
+            auto sweep = ladder.sweep(want);
+            assert(sweep.filled == filled);
+            assert(sweep.notional_ticks == notional);
+            assert(sweep.last == last);
+        }
+    }
+
+    std::cout << "All PriceLadder depth tests passed!\n";
+}
+
+int main() {
+    test_price_ladder();
+    test_price_ladder_random();
+    test_price_ladder_depth_random();
+    return 0;
+}
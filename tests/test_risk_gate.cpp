@@ -0,0 +1,109 @@
+#include "../include/core/risk_gate.hpp"
+#include <cassert>
+#include <iostream>
+
+using namespace trading;
+
+static uint64_t ticks(uint64_t ns) {
+    return static_cast<uint64_t>(ns * TscClock::instance().ticks_per_ns());
+}
+
+static RiskLimits small_limits() {
+    RiskLimits limits;
+    limits.max_order_quantity = 100;
+    limits.max_price_deviation = 50;
+    limits.max_open_notional = {100000, 100000};
+    limits.max_position = {100, 60};
+    limits.max_messages = 0;
+    return limits;
+}
+
+void test_order_checks() {
+    OrderBook book;
+    RiskGate gate(small_limits());
+    uint64_t now = ticks(1000000000);
+
+    // no touch to price against
+    assert(gate.check({1, Side::Bid, 1000, 10}, book, now) == RiskReject::NoReference);
+
+    book.add_order({100, Side::Bid, 990, 1});
+    book.add_order({101, Side::Ask, 1010, 1});
+
+    assert(gate.check({2, Side::Bid, 1000, 0}, book, now) == RiskReject::OrderSize);
+    assert(gate.check({3, Side::Bid, 1000, 101}, book, now) == RiskReject::OrderSize);
+
+    // band around the mid (1000)
+    assert(gate.check({4, Side::Bid, 949, 10}, book, now) == RiskReject::PriceBand);
+    assert(gate.check({5, Side::Ask, 1051, 10}, book, now) == RiskReject::PriceBand);
+    assert(gate.check({6, Side::Bid, 950, 10}, book, now) == RiskReject::None);
+    assert(gate.open_quantity(Side::Bid) == 10 && gate.open_notional(Side::Bid) == 9500);
+
+    // the first failing check names the reject
+    assert(gate.check({7, Side::Bid, 2000, 500}, book, now) == RiskReject::OrderSize);
+
+    // notional per side: 9500 + 9 * 10000 = 99500 fits, another 1000 does not
+    for (int i = 0; i < 9; ++i) assert(gate.check({8, Side::Bid, 1000, 10}, book, now) == RiskReject::None);
+    assert(gate.check({9, Side::Bid, 1000, 1}, book, now) == RiskReject::Notional);
+    assert(gate.check({10, Side::Ask, 1000, 50}, book, now) == RiskReject::None); // other side unaffected
+
+    // releasing exposure makes room again; fills move the position
+    gate.on_cancel(Side::Bid, 1000, 10);
+    gate.on_fill(Side::Bid, 950, 10);
+    assert(gate.open_quantity(Side::Bid) == 80 && gate.position() == 10);
+    assert(gate.check({11, Side::Bid, 1000, 10}, book, now) == RiskReject::None);
+
+    // position: long 10 with 90 bids open is at the limit of 100 (notional
+    // is checked first)
+    assert(gate.check({12, Side::Bid, 990, 41}, book, now) == RiskReject::Notional);
+    gate.on_cancel(Side::Bid, 1000, 60);
+    assert(gate.check({13, Side::Bid, 990, 40}, book, now) == RiskReject::None);
+    assert(gate.check({14, Side::Bid, 990, 21}, book, now) == RiskReject::Position);
+
+    // short side: the long 10 offsets 50 open asks, limit 60
+    assert(gate.check({15, Side::Ask, 1000, 20}, book, now) == RiskReject::None);
+    assert(gate.check({16, Side::Ask, 1000, 2}, book, now) == RiskReject::Position);
+
+    assert(gate.count(RiskReject::None) == 14 && gate.count(RiskReject::Notional) == 2);
+    assert(gate.count(RiskReject::OrderSize) == 3 && gate.count(RiskReject::PriceBand) == 2);
+    assert(gate.count(RiskReject::Position) == 2 && gate.count(RiskReject::NoReference) == 1);
+
+    // one side of the book is enough of a reference
+    OrderBook one_sided;
+    one_sided.add_order({1, Side::Ask, 500, 1});
+    RiskGate fresh(small_limits());
+    assert(fresh.check({1, Side::Bid, 460, 1}, one_sided, now) == RiskReject::None);
+    assert(fresh.check({2, Side::Bid, 449, 1}, one_sided, now) == RiskReject::PriceBand);
+}
+
+void test_throttle() {
+    OrderBook book;
+    book.add_order({100, Side::Bid, 999, 1});
+
+    RiskLimits limits = small_limits();
+    limits.max_messages = 10;
+    limits.throttle_window_ns = 1000000; // 10 per ms
+    RiskGate gate(limits);
+    uint64_t start = ticks(1000000000);
+
+    // a full burst, then nothing until the rate frees a slot
+    for (int i = 0; i < 10; ++i) assert(gate.check_message(start) == RiskReject::None);
+    assert(gate.check({1, Side::Bid, 1000, 1}, book, start) == RiskReject::Throttle);
+    assert(gate.check_message(start + ticks(50000)) == RiskReject::Throttle);
+    assert(gate.check({2, Side::Bid, 1000, 1}, book, start + ticks(110000)) == RiskReject::None);
+    assert(gate.check_message(start + ticks(110000)) == RiskReject::Throttle);
+
+    // rejects do not use up slots, and an idle window refills the burst
+    assert(gate.open_quantity(Side::Bid) == 1);
+    uint64_t later = start + ticks(5000000);
+    for (int i = 0; i < 10; ++i) assert(gate.check_message(later) == RiskReject::None);
+    assert(gate.check_message(later) == RiskReject::Throttle);
+    assert(gate.count(RiskReject::Throttle) == 4);
+}
+
+int main() {
+    test_order_checks();
+    test_throttle();
+
+    std::cout << "All RiskGate tests passed!\n";
+    return 0;
+}
@@ -0,0 +1,209 @@
+#include "../include/core/sequenced_decoder.hpp"
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+using namespace trading;
+
+static MarketMessage make_add(OrderId id) {
+    MarketMessage msg{};
+    msg.type = MessageType::AddOrder;
+    msg.instrument = static_cast<InstrumentId>(id % 4);
+    msg.add = {id, Side::Bid, 1000 + Price(id), 10};
+    return msg;
+}
+
+static void append(std::vector<uint8_t>& stream, const MarketMessage& msg, uint64_t sequence) {
+    uint8_t buffer[SEQUENCED_HEADER_SIZE + sizeof(MarketMessage)];
+    size_t size = encode_sequenced(msg, sequence, buffer);
+    stream.insert(stream.end(), buffer, buffer + size);
+}
+
+void test_decode_in_sequence() {
+    std::vector<uint8_t> stream;
+    for (uint64_t seq = 1; seq <= 10; ++seq) append(stream, make_add(seq), seq);
+    MarketMessage cancel{};
+    cancel.type = MessageType::CancelOrder;
+    cancel.instrument = 2;
+    cancel.cancel = {4};
+    append(stream, cancel, 11);
+
+    SequencedDecoder decoder;
+    std::vector<MarketMessage> out;
+    size_t consumed = decoder.decode(stream.data(), stream.size(), [&](const MarketMessage& msg) {
+        out.push_back(msg);
+        return true;
+    });
+
+    assert(consumed == stream.size());
+    assert(out.size() == 11);
+    for (uint64_t i = 0; i < 10; ++i) {
+        assert(out[i].type == MessageType::AddOrder);
+        assert(out[i].instrument == (i + 1) % 4);
+        assert(out[i].add.orderId == i + 1 && out[i].add.price == 1001 + Price(i));
+    }
+    assert(out[10].type == MessageType::CancelOrder && out[10].cancel.orderId == 4);
+    assert(decoder.expected_sequence() == 12);
+    assert(decoder.messages() == 11 && decoder.gaps() == 0);
+
+    std::cout << "All in-sequence decode tests passed!\n";
+}
+
+void test_gaps_and_duplicates() {
+    std::vector<uint8_t> stream;
+    append(stream, make_add(1), 1);
+    append(stream, make_add(2), 2);
+    append(stream, make_add(5), 5); // 3 and 4 missing
+    append(stream, make_add(3), 3); // late: dropped
+    append(stream, make_add(6), 6);
+
+    SequencedDecoder decoder;
+    uint64_t gap_expected = 0, gap_received = 0;
+    decoder.set_gap_handler([&](uint64_t expected, uint64_t received) {
+        gap_expected = expected;
+        gap_received = received;
+    });
+
+    std::vector<OrderId> ids;
+    decoder.decode(stream.data(), stream.size(), [&](const MarketMessage& msg) {
+        ids.push_back(msg.add.orderId);
+        return true;
+    });
+
+    assert((ids == std::vector<OrderId>{1, 2, 5, 6}));
+    assert(gap_expected == 3 && gap_received == 5);
+    assert(decoder.gaps() == 1 && decoder.duplicates() == 1);
+    assert(decoder.expected_sequence() == 7);
+
+    std::cout << "All gap/duplicate tests passed!\n";
+}
+
+void test_bounds_and_unknown() {
+    std::vector<uint8_t> stream;
+    append(stream, make_add(1), 1);
+
+    // unknown type: skipped by length, still takes its sequence number
+    uint8_t unknown[SEQUENCED_HEADER_SIZE + 6] = {};
+    uint16_t length = sizeof(unknown);
+    std::memcpy(unknown, &length, 2);
+    unknown[2] = 0xee;
+    uint64_t seq = 2;
+    std::memcpy(unknown + 8, &seq, 8);
+    stream.insert(stream.end(), unknown, unknown + sizeof(unknown));
+
+    // longer than the known payload (newer version): trailing bytes skipped
+    size_t start = stream.size();
+    append(stream, make_add(3), 3);
+    length = static_cast<uint16_t>(stream.size() - start + 4);
+    std::memcpy(stream.data() + start, &length, 2);
+    stream.insert(stream.end(), 4, 0xab);
+
+    // known type but shorter than its payload: skipped as malformed
+    MarketMessage cancel{};
+    cancel.type = MessageType::CancelOrder;
+    start = stream.size();
+    append(stream, cancel, 4);
+    length = SEQUENCED_HEADER_SIZE + 2;
+    std::memcpy(stream.data() + start, &length, 2);
+    stream.resize(start + length);
+
+    append(stream, make_add(5), 5);
+    size_t complete = stream.size();
+
+    // trailing partial message is left for the caller
+    append(stream, make_add(6), 6);
+    stream.resize(stream.size() - 3);
+
+    SequencedDecoder decoder;
+    std::vector<OrderId> ids;
+    auto sink = [&](const MarketMessage& msg) {
+        ids.push_back(msg.add.orderId);
+        return true;
+    };
+    size_t consumed = decoder.decode(stream.data(), stream.size(), sink);
+
+    assert(consumed == complete);
+    assert((ids == std::vector<OrderId>{1, 3, 5}));
+    assert(decoder.unknown() == 1 && decoder.malformed() == 1 && decoder.gaps() == 0);
+    assert(decoder.expected_sequence() == 6);
+
+    // a length too small to be a message stops the stream
+    uint8_t bad[SEQUENCED_HEADER_SIZE] = {4};
+    assert(decoder.decode(bad, sizeof(bad), sink) == 0);
+    assert(decoder.malformed() == 2);
+
+    std::cout << "All bounds/unknown tests passed!\n";
+}
+
+// A side other than Bid or Ask is malformed: skipped, sequence number taken
+void test_invalid_side() {
+    std::vector<uint8_t> stream;
+    append(stream, make_add(1), 1);
+    size_t start = stream.size();
+    append(stream, make_add(2), 2);
+    uint32_t side = 2;
+    std::memcpy(stream.data() + start + SEQUENCED_HEADER_SIZE + offsetof(AddOrderMsg, side), &side, sizeof(side));
+
+    MarketMessage level{};
+    level.type = MessageType::LevelUpdate;
+    level.level = {Side::Ask, 1000, 5};
+    start = stream.size();
+    append(stream, level, 3);
+    side = 0xffffffff;
+    std::memcpy(stream.data() + start + SEQUENCED_HEADER_SIZE + offsetof(LevelUpdateMsg, side), &side, sizeof(side));
+    append(stream, make_add(4), 4);
+
+    SequencedDecoder decoder;
+    std::vector<OrderId> ids;
+    size_t consumed = decoder.decode(stream.data(), stream.size(), [&](const MarketMessage& msg) {
+        assert(msg.type == MessageType::AddOrder);
+        ids.push_back(msg.add.orderId);
+        return true;
+    });
+
+    assert(consumed == stream.size());
+    assert((ids == std::vector<OrderId>{1, 4}));
+    assert(decoder.malformed() == 2 && decoder.gaps() == 0 && decoder.expected_sequence() == 5);
+
+    std::cout << "All invalid side tests passed!\n";
+}
+
+void test_sink_backpressure_and_handler() {
+    std::vector<uint8_t> stream;
+    for (uint64_t seq = 1; seq <= 5; ++seq) append(stream, make_add(seq), seq);
+
+    // sink refusing leaves the message unconsumed and the sequence unchanged
+    SequencedDecoder decoder;
+    int budget = 2;
+    size_t consumed = decoder.decode(stream.data(), stream.size(),
+                                     [&](const MarketMessage&) { return budget-- > 0; });
+    assert(decoder.messages() == 2 && decoder.expected_sequence() == 3);
+    consumed += decoder.decode(stream.data() + consumed, stream.size() - consumed,
+                               [&](const MarketMessage&) { return true; });
+    assert(consumed == stream.size() && decoder.gaps() == 0);
+
+    // handler decodes into queue slots
+    MarketDataHandler::Queue queue;
+    MarketDataHandler handler(queue);
+    SequencedDecoder line;
+    assert(handler.push_sequenced(line, stream.data(), stream.size()) == stream.size());
+    for (OrderId id = 1; id <= 5; ++id) {
+        MarketMessage* msg = queue.consume();
+        assert(msg && msg->type == MessageType::AddOrder && msg->add.orderId == id);
+        queue.release(msg);
+    }
+    assert(queue.consume() == nullptr);
+
+    std::cout << "All sink/handler tests passed!\n";
+}
+
+int main() {
+    test_decode_in_sequence();
+    test_gaps_and_duplicates();
+    test_bounds_and_unknown();
+    test_invalid_side();
+    test_sink_backpressure_and_handler();
+    return 0;
+}
@@ -0,0 +1,137 @@
+#include "../include/utils/sequenced_queue.hpp"
+#include <cassert>
+#include <iostream>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <cstdint>
+
+struct Item {
+    uint64_t producer;
+    uint64_t seq;
+};
+
+void test_sequenced_queue() {
+    MpscQueue<Item, 4> queue;
+
+    // Slots are published one by one, in claim order
+    Item* a = queue.claim();
+    Item* b = queue.claim();
+    assert(a && b && a != b);
+    *a = {0, 1};
+    *b = {0, 2};
+    queue.commit(b);
+    assert(queue.consume() == nullptr); // a still holds the consumer back
+    queue.commit(a);
+
+    assert(queue.claim() && queue.claim());
+    assert(queue.claim() == nullptr); // all four slots in use
+    Item* x = queue.consume();
+    assert(x == a && x->seq == 1);
+    assert(queue.claim() == nullptr); // consumed but not released
+    queue.release(x);
+    assert(queue.claim() != nullptr);
+
+    Item* y = queue.consume();
+    assert(y == b && y->seq == 2);
+    queue.release(y);
+
+    // Copying wrappers on the MPMC variant, across several laps
+    MpmcQueue<Item, 4> mpmc;
+    for (uint64_t i = 0; i < 10; ++i) {
+        assert(mpmc.push({0, i}));
+        assert(mpmc.push({1, i}));
+        Item out;
+        assert(mpmc.pop(out) && out.producer == 0 && out.seq == i);
+        assert(mpmc.pop(out) && out.producer == 1 && out.seq == i);
+        assert(!mpmc.pop(out));
+    }
+    assert(mpmc.size_approx() == 0);
+
+    std::cout << "All SequencedQueue tests passed!\n";
+}
+
+// Several producers into one consumer: nothing lost, per-producer order kept
+void test_mpsc_threads() {
+    constexpr uint64_t PRODUCERS = 4;
+    constexpr uint64_t COUNT = 200000;
+    MpscQueue<Item, 256> queue;
+
+    std::vector<std::thread> producers;
+    for (uint64_t p = 0; p < PRODUCERS; ++p) {
+        producers.emplace_back([&queue, p]() {
+            for (uint64_t i = 0; i < COUNT; ++i) {
+                Item* slot;
+                while (!(slot = queue.claim())) std::this_thread::yield();
+                *slot = {p, i};
+                queue.commit(slot);
+            }
+        });
+    }
+
+    std::vector<uint64_t> next(PRODUCERS, 0);
+    for (uint64_t received = 0; received < PRODUCERS * COUNT;) {
+        Item* slot = queue.consume();
+        if (!slot) {
+            std::this_thread::yield();
+            continue;
+        }
+        assert(slot->seq == next[slot->producer]);
+        next[slot->producer]++;
+        queue.release(slot);
+        received++;
+    }
+
+    for (auto& t : producers) t.join();
+    for (uint64_t p = 0; p < PRODUCERS; ++p) assert(next[p] == COUNT);
+    assert(queue.consume() == nullptr);
+
+    std::cout << "All MpscQueue thread tests passed!\n";
+}
+
+// Several producers and consumers: every item delivered exactly once
+void test_mpmc_threads() {
+    constexpr uint64_t PRODUCERS = 3;
+    constexpr uint64_t CONSUMERS = 3;
+    constexpr uint64_t COUNT = 100000;
+    MpmcQueue<Item, 256> queue;
+
+    std::atomic<uint64_t> received{0};
+    std::atomic<uint64_t> sum{0};
+
+    std::vector<std::thread> threads;
+    for (uint64_t p = 0; p < PRODUCERS; ++p) {
+        threads.emplace_back([&queue, p]() {
+            for (uint64_t i = 0; i < COUNT; ++i)
+                while (!queue.push({p, i})) std::this_thread::yield();
+        });
+    }
+    for (uint64_t c = 0; c < CONSUMERS; ++c) {
+        threads.emplace_back([&]() {
+            uint64_t local = 0;
+            while (received.load() < PRODUCERS * COUNT) {
+                Item out;
+                if (!queue.pop(out)) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                local += out.seq;
+                received++;
+            }
+            sum += local;
+        });
+    }
+
+    for (auto& t : threads) t.join();
+    assert(received.load() == PRODUCERS * COUNT);
+    assert(sum.load() == PRODUCERS * (COUNT * (COUNT - 1) / 2));
+
+    std::cout << "All MpmcQueue thread tests passed!\n";
+}
+
+int main() {
+    test_sequenced_queue();
+    test_mpsc_threads();
+    test_mpmc_threads();
+    return 0;
+}
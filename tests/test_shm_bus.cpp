@@ -0,0 +1,139 @@
+#include "../include/core/shm_bus.hpp"
+#include <cassert>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace trading;
+
+static std::string bus_name(const char* name) {
+    return std::string("/") + name + "_" + std::to_string(::getpid());
+}
+
+static MarketMessage add(OrderId id) {
+    MarketMessage msg{};
+    msg.type = MessageType::AddOrder;
+    msg.instrument = 7;
+    msg.add = {id, Side::Bid, 100 + static_cast<Price>(id), 10};
+    return msg;
+}
+
+void test_broadcast() {
+    ShmBusWriter writer(bus_name("test_bus_broadcast"), 8);
+    assert(writer.is_open() && writer.capacity() == 8);
+    ShmBusReader a(writer.name());
+    ShmBusReader b(writer.name());
+    assert(a.is_open() && b.is_open() && a.capacity() == 8);
+
+    MarketMessage out;
+    assert(a.poll(out) == BusRead::Empty);
+
+    for (OrderId id = 1; id <= 5; ++id) writer.publish(add(id));
+    assert(a.lag() == 5);
+
+    // every reader sees every message, independently
+    for (OrderId id = 1; id <= 5; ++id) {
+        assert(a.poll(out) == BusRead::Message);
+        assert(out.type == MessageType::AddOrder && out.instrument == 7 && out.add.orderId == id);
+    }
+    assert(a.poll(out) == BusRead::Empty && a.lag() == 0);
+    assert(b.poll(out) == BusRead::Message && out.add.orderId == 1 && b.lag() == 4);
+
+    // claimed but not committed: not visible yet
+    MarketMessage* slot = writer.claim();
+    *slot = add(6);
+    assert(a.poll(out) == BusRead::Empty);
+    writer.commit();
+    assert(a.poll(out) == BusRead::Message && out.add.orderId == 6);
+
+    // a late reader starts at the writer's position
+    ShmBusReader late(writer.name());
+    assert(late.position() == 6 && late.poll(out) == BusRead::Empty);
+    writer.publish(add(7));
+    assert(late.poll(out) == BusRead::Message && out.add.orderId == 7);
+
+    std::cout << "All bus broadcast tests passed!\n";
+}
+
+void test_overrun() {
+    ShmBusWriter writer(bus_name("test_bus_overrun"), 8);
+    ShmBusReader reader(writer.name());
+    MarketMessage out;
+
+    // a full ring is still readable
+    for (OrderId id = 1; id <= 8; ++id) writer.publish(add(id));
+    assert(reader.poll(out) == BusRead::Message && out.add.orderId == 1);
+
+    // the writer laps the reader: detected, the gap counted, reading resumes live
+    for (OrderId id = 9; id <= 20; ++id) writer.publish(add(id));
+    assert(reader.poll(out) == BusRead::Overrun);
+    assert(reader.overruns() == 1 && reader.lost() == 19 && reader.position() == 20);
+    assert(reader.poll(out) == BusRead::Empty);
+
+    writer.publish(add(21));
+    assert(reader.poll(out) == BusRead::Message && out.add.orderId == 21);
+    assert(reader.overruns() == 1);
+
+    std::cout << "All bus overrun tests passed!\n";
+}
+
+void test_attach() {
+    assert(!ShmBusReader(bus_name("test_bus_missing")).is_open());
+    assert(!ShmBusWriter(bus_name("test_bus_bad_capacity"), 12).is_open());
+
+    std::string name = bus_name("test_bus_close");
+    auto writer = std::make_unique<ShmBusWriter>(name, 16);
+    ShmBusReader reader(name);
+    writer->publish(add(1));
+    assert(!reader.writer_closed());
+
+    // the reader keeps its mapping after the writer unlinks the segment
+    writer.reset();
+    assert(reader.writer_closed() && !ShmBusReader(name).is_open());
+    MarketMessage out;
+    assert(reader.poll(out) == BusRead::Message && out.add.orderId == 1);
+
+    std::cout << "All bus attach tests passed!\n";
+}
+
+// A reader in another process sees the stream in order
+void test_cross_process() {
+    constexpr OrderId MESSAGES = 1000;
+    ShmBusWriter writer(bus_name("test_bus_process"), 1024);
+
+    // attached before the fork so it starts at position 0; the child gets its own cursor
+    ShmBusReader reader(writer.name());
+    pid_t child = ::fork();
+    assert(child >= 0);
+    if (child == 0) {
+        OrderId expected = 1;
+        MarketMessage out;
+        while (expected <= MESSAGES) {
+            BusRead result = reader.poll(out);
+            if (result == BusRead::Overrun) ::_exit(2);
+            if (result == BusRead::Empty) continue;
+            if (out.add.orderId != expected++) ::_exit(3);
+        }
+        ::_exit(0);
+    }
+
+    for (OrderId id = 1; id <= MESSAGES; ++id) writer.publish(add(id));
+
+    int status = 0;
+    ::waitpid(child, &status, 0);
+    assert(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+
+    std::cout << "All bus cross-process tests passed!\n";
+}
+
+int main() {
+    test_broadcast();
+    test_overrun();
+    test_attach();
+    test_cross_process();
+
+    std::cout << "All ShmBus tests passed!\n";
+    return 0;
+}
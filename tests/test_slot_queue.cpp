@@ -0,0 +1,81 @@
+#include "../include/utils/slot_queue.hpp"
+#include <cassert>
+#include <iostream>
+#include <thread>
+#include <cstdint>
+
+struct Item {
+    uint64_t seq;
+    uint64_t check;
+};
+
+void test_slot_queue() {
+    SlotQueue<Item, 4> queue;
+
+    // Claimed slots stay invisible until committed
+    Item* a = queue.claim();
+    Item* b = queue.claim();
+    assert(a && b && a != b);
+    *a = {1, 1};
+    *b = {2, 2};
+    assert(queue.consume() == nullptr);
+    queue.commit(b);
+
+    // Consumer reads in place; slots return only on release
+    assert(queue.claim() && queue.claim());
+    assert(queue.claim() == nullptr); // all four slots in use
+    Item* x = queue.consume();
+    Item* y = queue.consume();
+    assert(x == a && y == b);
+    assert(x->seq == 1 && y->seq == 2);
+    assert(queue.claim() == nullptr);
+    queue.release(y);
+    assert(queue.claim() != nullptr);
+
+    std::cout << "All SlotQueue tests passed!\n";
+}
+
+// Producer and consumer threads with batched commits and releases
+void test_slot_queue_threads() {
+    constexpr uint64_t COUNT = 1000000;
+    SlotQueue<Item, 1024> queue;
+
+    std::thread producer([&]() {
+        uint64_t seq = 0;
+        while (seq < COUNT) {
+            Item* last = nullptr;
+            for (int i = 0; i < 8 && seq < COUNT; ++i) {
+                Item* slot = queue.claim();
+                if (!slot) break;
+                *slot = {seq, seq * 7};
+                last = slot;
+                ++seq;
+            }
+            if (last) queue.commit(last);
+            else std::this_thread::yield();
+        }
+    });
+
+    uint64_t expected = 0;
+    while (expected < COUNT) {
+        Item* slot = queue.consume();
+        if (!slot) {
+            std::this_thread::yield();
+            continue;
+        }
+        assert(slot->seq == expected && slot->check == expected * 7);
+        ++expected;
+        if (expected % 16 == 0 || expected == COUNT) queue.release(slot);
+    }
+
+    producer.join();
+    assert(queue.consume() == nullptr);
+
+    std::cout << "All SlotQueue thread tests passed!\n";
+}
+
+int main() {
+    test_slot_queue();
+    test_slot_queue_threads();
+    return 0;
+}
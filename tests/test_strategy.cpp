@@ -0,0 +1,134 @@
+#include "../include/core/strategy.hpp"
+#include <cassert>
+#include <iostream>
+#include <vector>
+
+using namespace trading;
+
+// Records every event
+struct Recorder : Strategy<Recorder> {
+    std::vector<BBOUpdateMsg> bbos;
+    std::vector<LevelUpdateMsg> levels;
+    std::vector<TradeMsg> trades;
+    std::vector<ExecuteMsg> executes;
+
+    void on_bbo(const BBOUpdateMsg& bbo) { bbos.push_back(bbo); }
+    void on_level(const LevelUpdateMsg& level) { levels.push_back(level); }
+    void on_trade(const TradeMsg& trade) { trades.push_back(trade); }
+    void on_execute(const ExecuteMsg& execute) { executes.push_back(execute); }
+
+    void clear() {
+        bbos.clear();
+        levels.clear();
+        trades.clear();
+        executes.clear();
+    }
+};
+
+// Top of book only
+struct TopOnly : Strategy<TopOnly> {
+    int calls = 0;
+    void on_bbo(const BBOUpdateMsg&) { ++calls; }
+};
+
+struct Ignores : Strategy<Ignores> {};
+
+static_assert(handles_bbo<Recorder> && handles_level<Recorder> && handles_trade<Recorder> && handles_execute<Recorder>);
+static_assert(handles_bbo<TopOnly> && !handles_level<TopOnly> && !handles_trade<TopOnly>);
+static_assert(!BookEvents<OrderBook, Ignores>::TRACK_LEVELS);
+static_assert(BookEvents<OrderBook, TopOnly, Ignores>::TRACK_LEVELS && !BookEvents<OrderBook, TopOnly>::ANY_LEVEL);
+
+static MarketMessage add(OrderId id, Side side, Price price, Quantity qty) {
+    MarketMessage msg{};
+    msg.type = MessageType::AddOrder;
+    msg.add = {id, side, price, qty};
+    return msg;
+}
+
+static MarketMessage cancel(OrderId id) {
+    MarketMessage msg{};
+    msg.type = MessageType::CancelOrder;
+    msg.cancel = {id};
+    return msg;
+}
+
+static MarketMessage modify(OrderId id, Quantity qty) {
+    MarketMessage msg{};
+    msg.type = MessageType::ModifyOrder;
+    msg.modify = {id, qty};
+    return msg;
+}
+
+static MarketMessage execute(OrderId id, Quantity qty, Price price) {
+    MarketMessage msg{};
+    msg.type = MessageType::Execute;
+    msg.execute = {id, qty, price};
+    return msg;
+}
+
+void test_events() {
+    OrderBook book;
+    Recorder recorder;
+    TopOnly top;
+    BookEvents events(book, recorder, top);
+
+    events.apply(add(1, Side::Bid, 100, 10));
+    assert(recorder.levels.size() == 1 && recorder.levels[0].price == 100 && recorder.levels[0].qty == 10);
+    assert(recorder.bbos.size() == 1 && recorder.bbos[0].bestBid == 100 && recorder.bbos[0].bidSize == 10);
+    assert(recorder.bbos[0].bestAsk == 0 && recorder.bbos[0].askSize == 0);
+    assert(top.calls == 1);
+
+    // a level behind the touch: level event, no BBO event
+    recorder.clear();
+    events.apply(add(2, Side::Bid, 99, 5));
+    assert(recorder.levels.size() == 1 && recorder.levels[0].price == 99 && recorder.bbos.empty());
+
+    // size at the touch changes the BBO
+    events.apply(add(3, Side::Bid, 100, 4));
+    assert(recorder.bbos.size() == 1 && recorder.bbos[0].bidSize == 14);
+
+    // nothing changed: unknown ids, a modify to the same quantity, an execute
+    // of nothing, a trade print
+    recorder.clear();
+    events.apply(cancel(42));
+    events.apply(modify(3, 4));
+    events.apply(execute(42, 1, 100));
+    events.apply(execute(3, 0, 100));
+    assert(recorder.levels.empty() && recorder.bbos.empty() && recorder.executes.empty());
+
+    MarketMessage trade{};
+    trade.type = MessageType::Trade;
+    trade.trade = {7, 8, 3, 101};
+    events.apply(trade);
+    assert(recorder.trades.size() == 1 && recorder.trades[0].qty == 3 && book.get_level(Side::Bid, 100) == 14);
+
+    // execute: level, BBO, then the execute itself
+    events.apply(execute(1, 10, 100));
+    assert(recorder.levels.size() == 1 && recorder.levels[0].qty == 4);
+    assert(recorder.bbos.size() == 1 && recorder.bbos[0].bidSize == 4);
+    assert(recorder.executes.size() == 1 && recorder.executes[0].orderId == 1);
+
+    // emptying the touch moves the BBO to the next level
+    recorder.clear();
+    events.apply(cancel(3));
+    assert(recorder.levels.size() == 1 && recorder.levels[0].price == 100 && recorder.levels[0].qty == 0);
+    assert(recorder.bbos.size() == 1 && recorder.bbos[0].bestBid == 99 && recorder.bbos[0].bidSize == 5);
+    assert(top.calls == 4 && events.last_bbo().bestBid == 99);
+}
+
+// Strategies that ignore everything leave the book's change tracking off
+void test_no_subscribers() {
+    OrderBook book;
+    Ignores ignores;
+    BookEvents events(book, ignores);
+    events.apply(add(1, Side::Ask, 100, 1));
+    assert(book.changed_levels().empty() && book.get_best_ask() == 100);
+}
+
+int main() {
+    test_events();
+    test_no_subscribers();
+
+    std::cout << "All Strategy tests passed!\n";
+    return 0;
+}
@@ -0,0 +1,113 @@
+#include "../include/core/market_data_handler.hpp"
+#include "../include/utils/histogram.hpp"
+#include "../include/utils/memory_pool.hpp"
+#include "../include/utils/telemetry.hpp"
+#include <cassert>
+#include <iostream>
+#include <memory>
+#include <thread>
+
+using namespace trading;
+
+// Concurrent histogram snapshots match a plain histogram fed the same values
+void test_concurrent_histogram() {
+    ConcurrentHistogram concurrent;
+    LatencyHistogram plain;
+    for (uint64_t v = 1; v <= 100000; v += 7) {
+        concurrent.record(v);
+        plain.record(v);
+    }
+
+    LatencyHistogram snap = concurrent.snapshot();
+    assert(snap.count() == plain.count());
+    assert(snap.min() == plain.min() && snap.max() == plain.max());
+    assert(snap.mean() == plain.mean());
+    for (double p : {50.0, 99.0, 99.9}) assert(snap.percentile(p) == plain.percentile(p));
+
+    assert(ConcurrentHistogram().snapshot().count() == 0);
+}
+
+// Messages through the handler and a consumer get every stage recorded
+void test_pipeline_stages() {
+    auto queue = std::make_unique<MarketDataHandler::Queue>();
+    MarketDataHandler handler(*queue);
+    OrderBook book;
+
+    constexpr int N = 1000;
+    std::thread consumer([&]() {
+        telemetry::set_thread_name("test consumer");
+        for (int i = 0; i < N;) {
+            MarketMessage* msg = queue->consume();
+            if (!msg) continue;
+            telemetry::on_dequeue(*msg, *queue);
+            apply_message(book, *msg);
+            telemetry::on_applied(*msg);
+            queue->release(msg);
+            ++i;
+        }
+    });
+
+    uint8_t buffer[sizeof(MarketMessage) + MESSAGE_HEADER_SIZE];
+    for (int i = 0; i < N; ++i) {
+        MarketMessage msg{};
+        msg.type = MessageType::AddOrder;
+        msg.add = {static_cast<OrderId>(i + 1), Side::Bid, 10000 - i % 10, 10};
+        size_t size = encode_message(msg, buffer);
+        while (!handler.push_raw_message(buffer, size)) std::this_thread::yield();
+    }
+    consumer.join();
+
+    // emptying the best level makes the book rescan for the next one
+    OrderBook small;
+    small.add_order({1, Side::Bid, 100, 10});
+    small.add_order({2, Side::Bid, 99, 10});
+    small.cancel_order(1);
+    assert(small.get_best_bid() == 99);
+
+    telemetry::Snapshot snap = telemetry::snapshot();
+    telemetry::ThreadSnapshot total = snap.total();
+
+    if constexpr (telemetry::ENABLED) {
+        assert(snap.threads.size() >= 2);
+        assert(total.counter(telemetry::Counter::Messages) == N);
+        assert(total.stage(telemetry::Stage::Decode).count() == N);
+        assert(total.stage(telemetry::Stage::QueueDwell).count() == N);
+        assert(total.stage(telemetry::Stage::Apply).count() == N);
+        assert(total.stage(telemetry::Stage::WireToBook).count() == N);
+        assert(total.queue_depth.count() == N);
+        assert(total.counter(telemetry::Counter::BestPriceRescans) > 0);
+
+        // wire-to-book spans the other stages
+        assert(total.stage(telemetry::Stage::WireToBook).max() >=
+               total.stage(telemetry::Stage::Apply).max());
+
+        bool named = false;
+        for (const auto& t : snap.threads) named |= t.name == "test consumer";
+        assert(named);
+    } else {
+        // compiled out: nothing is registered or stamped
+        assert(snap.threads.empty());
+        assert(total.counter(telemetry::Counter::Messages) == 0);
+        assert(telemetry::stamp() == 0);
+    }
+}
+
+void test_pool_exhaustion_counter() {
+    uint64_t before = telemetry::snapshot().total().counter(telemetry::Counter::PoolExhausted);
+
+    MemoryPool<int, 2> pool;
+    assert(pool.allocate() && pool.allocate());
+    assert(pool.allocate() == nullptr);
+
+    uint64_t after = telemetry::snapshot().total().counter(telemetry::Counter::PoolExhausted);
+    assert(after - before == (telemetry::ENABLED ? 1u : 0u));
+}
+
+int main() {
+    test_concurrent_histogram();
+    test_pipeline_stages();
+    test_pool_exhaustion_counter();
+
+    std::cout << "All Telemetry tests passed!\n";
+    return 0;
+}